@@ -9,6 +9,7 @@ SET(rcore_app_INST_INCLUDES
 	rmutex.h
 	rconditionvar.h
 	rrwlock.h
+	rthreadpool.h
 )
 
 SET(rcore_app_TARGET_SOURCES
@@ -22,4 +23,5 @@ SET(rcore_app_TARGET_SOURCES
 	rmutex.cpp
 	rconditionvar.cpp
 	rrwlock.cpp
+	rthreadpool.cpp
 )
\ No newline at end of file
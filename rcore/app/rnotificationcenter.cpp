@@ -263,6 +263,27 @@ void RNotificationCenter::InsertObserver(tNotificationHandler handler,RObject* o
 }
 
 
+//-----------------------------------------------------------------------------
+bool RNotificationCenter::IsObserved(const hNotification handle,const RObject* sender) const
+{
+	// Observers of every notification or of the particular notification
+	if(Data->Defaults.GetNb())
+		return(true);
+	if(handle&&reinterpret_cast<INotifications*>(handle)->GetNb())
+		return(true);
+
+	// Observers of every notification or of the particular notification of the sender
+	if(sender&&sender->Handlers)
+	{
+		RCursor<IListener> Object(*reinterpret_cast<IObjects*>(sender->Handlers));
+		for(Object.Start();!Object.End();Object.Next())
+			if((!Object()->Handle)||(Object()->Handle==handle))
+				return(true);
+	}
+	return(false);
+}
+
+
 //-----------------------------------------------------------------------------
 void RNotificationCenter::PostNotification(const RNotification& notification)
 {
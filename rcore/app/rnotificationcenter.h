@@ -142,6 +142,15 @@ public:
 		InsertObserver(handler,observer,GetNotificationHandle(name),object);
 	}
 
+	/**
+	* Look if a notification posted by a given object has at least one
+	* observer. This can be used to avoid to build and to post notifications
+	* that nobody handles.
+	* @param handle          Handle of the notification.
+	* @param sender          Object sending the notification.
+	*/
+	bool IsObserved(const hNotification handle,const RObject* sender=0) const;
+
 	/**
 	* Post a notification.
 	* @param notification    Notification.
@@ -42,9 +42,8 @@
 // include files for R Project
 #include <rstring.h>
 #include <rrwlock.h>
+#include <rmutex.h>
 #include <rcontainer.h>
-#include <rboolvector.h>
-#include <rboolcursor.h>
 #include <rnumcontainer.h>
 
 
@@ -177,20 +176,46 @@ public:
  *
  * The RThreadLocalStorage class ensures that only the necessary amount of data
  * structures is allocated on the heap.
+ *
+ * The data structure of an identifier that is already reserved is found
+ * without lock: it is read in a table indexed by the identifiers. The mutex is
+ * only taken when an identifier is reserved for the first time or released.
+ * When the table must grow, a new table is published and the old ones are kept
+ * until the destruction (another thread may still read them). Reserve and Get
+ * can therefore be called in the inner loops.
  * @short Thread Local Storage.
  */
 template<class C>
 	class RThreadLocalStorage
 {
+	/**
+	 * Table of the data structures reserved by the identifiers.
+	 */
+	class Table
+	{
+	public:
+		size_t Nb;             // Number of identifiers.
+		C** Ptrs;              // Data structure of each identifier (or null).
+		Table* Prev;           // Previous (smaller) table.
+
+		Table(size_t nb,Table* prev) : Nb(nb), Ptrs(new C*[nb]), Prev(prev)
+		{
+			memset(Ptrs,0,nb*sizeof(C*));
+			if(Prev)
+				memcpy(Ptrs,Prev->Ptrs,Prev->Nb*sizeof(C*));
+		}
+		~Table(void) {delete[] Ptrs;}
+	};
+
 	/**
 	 * Container of data structures.
 	 */
 	RContainer<C,true,false> Data;
 
 	/**
-	 * Vector that remember which data structures are actually used.
+	 * Indexes of the data structures that are not used.
 	 */
-	RBoolVector DataUsed;
+	RNumContainer<size_t,false> Free;
 
 	/**
 	 * Relation between an identifier and the index of the corresponding data
@@ -199,9 +224,45 @@ template<class C>
 	RNumContainer<size_t,false> Index;
 
 	/**
-	 * Read/Write lock.
+	 * Current table (read without lock).
 	 */
-	RRWLock lData;
+	Table* Lookup;
+
+	/**
+	 * Mutex protecting the reservations.
+	 */
+	RMutex lData;
+
+	/**
+	 * Find the data structure reserved by an identifier without lock.
+	 * @param id             Identifier.
+	 * @return a pointer to the data structure or 0.
+	 */
+	inline C* Find(size_t id) const
+	{
+		Table* Cur(__atomic_load_n(&Lookup,__ATOMIC_ACQUIRE));
+		if(id<Cur->Nb)
+			return(__atomic_load_n(&Cur->Ptrs[id],__ATOMIC_ACQUIRE));
+		return(0);
+	}
+
+	/**
+	 * Publish the data structure reserved by an identifier. The mutex must be
+	 * locked.
+	 * @param id             Identifier.
+	 * @param ptr            Pointer to the data structure (or 0).
+	 */
+	void Publish(size_t id,C* ptr)
+	{
+		if(id>=Lookup->Nb)
+		{
+			size_t Nb(Lookup->Nb+Lookup->Nb/2);
+			if(Nb<=id)
+				Nb=id+1;
+			__atomic_store_n(&Lookup,new Table(Nb,Lookup),__ATOMIC_RELEASE);
+		}
+		__atomic_store_n(&Lookup->Ptrs[id],ptr,__ATOMIC_RELEASE);
+	}
 
 public:
 
@@ -210,11 +271,25 @@ public:
     * @param size           Initial size of the internal containers. It is set
 	 *                       to 20 by default.
     */
-	RThreadLocalStorage(size_t size=20) : Data(size,10), DataUsed(0,20), Index(size)
+	RThreadLocalStorage(size_t size=20) : Data(size,10), Free(size), Index(size), Lookup(new Table(size?size:1,0)), lData()
 	{
 		Index.Init(size,cNoRef);
 	}
 
+private:
+
+	/**
+	 * Copy constructor (not allowed).
+	 */
+	RThreadLocalStorage(const RThreadLocalStorage&);
+
+	/**
+	 * Assignment operator (not allowed).
+	 */
+	RThreadLocalStorage& operator=(const RThreadLocalStorage&);
+
+public:
+
 	/**
 	 * Method that allocates a new data structure. This method can overloaded
 	 * to eventually call more complex constructors.
@@ -230,46 +305,35 @@ public:
     */
 	C* Reserve(size_t id)
 	{
-		lData.ReadLock();
-		if(id<Index.GetNb())
-		{
-			size_t Idx(Index[id]);
-			if(Idx!=cNoRef)
-			{
-				lData.ReadUnLock();
-				return(Data[Idx]);
-			}
-		}
-		lData.ReadUnLock();
+		C* ptr(Find(id));
+		if(ptr)
+			return(ptr);
 
-		// Lock for writing purposes
-		lData.WriteLock();
+		// Another thread may have reserved the identifier before the lock
+		RSmartMutexPtr Lock(&lData);
+		if((id<Index.GetNb())&&(Index[id]!=cNoRef))
+			return(Data[Index[id]]);
 
 		// Add necessary identifiers
 		while(Index.GetNb()<=id)
 			Index.Insert(cNoRef);
 
-		// Find an unused data structure
+		// Take an unused data structure or create a new one
 		size_t Idx;
-		C* ptr;
-		RBoolCursor Cur(DataUsed);
-		for(Cur.Start();(!Cur.End())&&Cur();Cur.Next());
-		if(Cur.End())
+		if(Free.GetNb())
 		{
-			// Create new structure
-			ptr=New();
-			Idx=Data.GetNb();
-			Data.InsertPtrAt(ptr,Idx);
-			DataUsed.ReSize(Data.GetNb());
+			Idx=Free[Free.GetNb()-1];
+			Free.DeleteAt(Free.GetNb()-1);
+			ptr=Data[Idx];
 		}
 		else
 		{
-			Idx=Cur.GetPos();
-			ptr=Data[Idx];
+			ptr=New();
+			Idx=Data.GetNb();
+			Data.InsertPtrAt(ptr,Idx);
 		}
 		Index[id]=Idx;
-		DataUsed[Idx]=true;
-		lData.WriteUnLock();
+		Publish(id,ptr);
 		return(ptr);
 	}
 
@@ -282,19 +346,9 @@ public:
 	 */
 	C* Get(size_t id,bool null=false)
 	{
-		lData.ReadLock();
-		if(id<Index.GetNb())
-		{
-			size_t Idx(Index[id]);
-			if(Idx!=cNoRef)
-			{
-				lData.ReadUnLock();
-				return(Data[Idx]);
-			}
-		}
-		lData.ReadUnLock();
-		if(null)
-			return(0);
+		C* ptr(Find(id));
+		if(ptr||null)
+			return(ptr);
 		mThrowRException("No reserved data for identifier "+RString::Number(id));
 	}
 
@@ -307,19 +361,9 @@ public:
 	 */
 	const C* Get(size_t id,bool null=false) const
 	{
-		const_cast<RThreadLocalStorage*>(this)->lData.ReadLock();
-		if(id<Index.GetNb())
-		{
-			size_t Idx(Index[id]);
-			if(Idx!=cNoRef)
-			{
-				const_cast<RThreadLocalStorage*>(this)->lData.ReadUnLock();
-				return(Data[Idx]);
-			}
-		}
-		const_cast<RThreadLocalStorage*>(this)->lData.ReadUnLock();
-		if(null)
-			return(0);
+		const C* ptr(Find(id));
+		if(ptr||null)
+			return(ptr);
 		mThrowRException("No reserved data for identifier "+RString::Number(id));
 	}
 
@@ -329,23 +373,25 @@ public:
     */
 	void Release(size_t id)
 	{
-		lData.ReadLock();
-		if(id>=Index.GetNb())
-		{
-			lData.ReadUnLock();
+		RSmartMutexPtr Lock(&lData);
+		if((id>=Index.GetNb())||(Index[id]==cNoRef))
 			mThrowRException("No reserved data for identifier "+RString::Number(id));
-		}
-		size_t Idx(Index[id]);
-		if(Idx==cNoRef)
+		Free.Insert(Index[id]);
+		Index[id]=cNoRef;
+		Publish(id,0);
+	}
+
+	/**
+	 * Destructor.
+	 */
+	virtual ~RThreadLocalStorage(void)
+	{
+		while(Lookup)
 		{
-			lData.ReadUnLock();
-			mThrowRException("No reserved data for identifier "+RString::Number(id));
+			Table* Prev(Lookup->Prev);
+			delete Lookup;
+			Lookup=Prev;
 		}
-		lData.ReadUnLock();
-		lData.WriteLock();
-		DataUsed[Idx]=false;
-		Index[id]=cNoRef;
-		lData.WriteUnLock();
 	}
 };
 
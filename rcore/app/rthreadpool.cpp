@@ -0,0 +1,374 @@
+/*
+
+	R Project Library
+
+	RThreadPool.cpp
+
+	Pool of Threads - Implementation.
+
+	Copyright 2006-2015 by Pascal Francq (pascal@francq.info).
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Library General Public
+	License as published by the Free Software Foundation; either
+	version 2.0 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Library General Public License for more details.
+
+	You should have received a copy of the GNU Library General Public
+	License along with this library, as a file COPYING.LIB; if not, write
+	to the Free Software Foundation, Inc., 59 Temple Place, Suite 330,
+	Boston, MA  02111-1307  USA
+
+*/
+
+
+
+//------------------------------------------------------------------------------
+// include files for ANSI C/C++
+#include <unistd.h>
+
+
+//------------------------------------------------------------------------------
+// include files for R Project
+#include <rthreadpool.h>
+using namespace R;
+
+
+
+//------------------------------------------------------------------------------
+//
+// class RThreadPoolTask
+//
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+RThreadPoolTask::RThreadPoolTask(void)
+	: Pool(0), Generation(0), Done(false), Delete(false), Cancelled(false), Error(0)
+{
+}
+
+
+//------------------------------------------------------------------------------
+bool RThreadPoolTask::IsCancelled(void) const
+{
+	if(__atomic_load_n(&Cancelled,__ATOMIC_ACQUIRE))
+		return(true);
+	return(Pool&&(Generation<=__atomic_load_n(&Pool->CancelGeneration,__ATOMIC_ACQUIRE)));
+}
+
+
+//------------------------------------------------------------------------------
+RString RThreadPoolTask::GetError(void) const
+{
+	if(Error)
+		return(*Error);
+	return(RString::Null);
+}
+
+
+//------------------------------------------------------------------------------
+RThreadPoolTask::~RThreadPoolTask(void)
+{
+	delete Error;
+}
+
+
+
+//------------------------------------------------------------------------------
+//
+// class RThreadPoolWorker
+//
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+RThreadPoolWorker::RThreadPoolWorker(RThreadPool* pool,size_t id)
+	: RThread(id,"RThreadPoolWorker"), Pool(pool), Mutex(), Tasks(new RThreadPoolTask*[16]), MaxTasks(16), First(0), NbTasks(0)
+{
+}
+
+
+//------------------------------------------------------------------------------
+void RThreadPoolWorker::Push(RThreadPoolTask* task)
+{
+	RSmartMutexPtr Lock(&Mutex);
+	if(NbTasks==MaxTasks)
+	{
+		// Double the array and put the tasks at its beginning
+		RThreadPoolTask** Tmp(new RThreadPoolTask*[2*MaxTasks]);
+		for(size_t i=0;i<NbTasks;i++)
+			Tmp[i]=Tasks[(First+i)%MaxTasks];
+		delete[] Tasks;
+		Tasks=Tmp;
+		MaxTasks*=2;
+		First=0;
+	}
+	Tasks[(First+NbTasks)%MaxTasks]=task;
+	NbTasks++;
+}
+
+
+//------------------------------------------------------------------------------
+RThreadPoolTask* RThreadPoolWorker::Pop(void)
+{
+	RSmartMutexPtr Lock(&Mutex);
+	if(!NbTasks)
+		return(0);
+	NbTasks--;
+	return(Tasks[(First+NbTasks)%MaxTasks]);
+}
+
+
+//------------------------------------------------------------------------------
+RThreadPoolTask* RThreadPoolWorker::Steal(void)
+{
+	RSmartMutexPtr Lock(&Mutex);
+	if(!NbTasks)
+		return(0);
+	RThreadPoolTask* Task(Tasks[First]);
+	First=(First+1)%MaxTasks;
+	NbTasks--;
+	return(Task);
+}
+
+
+//------------------------------------------------------------------------------
+void RThreadPoolWorker::Run(void)
+{
+	pthread_setspecific(Pool->Key,this);
+	while(true)
+	{
+		RThreadPoolTask* Task(Pool->Take(this));
+		if(Task)
+		{
+			Pool->Execute(Task,this);
+			continue;
+		}
+
+		// Wait for a new task
+		RSmartMutexPtr Lock(&Pool->Mutex);
+		while((!Pool->NbPending)&&(!Pool->Stop))
+			Pool->WorkAvailable.Wait(&Pool->Mutex);
+		if(Pool->Stop&&(!Pool->NbPending))
+			break;
+	}
+}
+
+
+//------------------------------------------------------------------------------
+RThreadPoolWorker::~RThreadPoolWorker(void)
+{
+	delete[] Tasks;
+}
+
+
+
+//------------------------------------------------------------------------------
+//
+// class RThreadPool
+//
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+RThreadPool::RThreadPool(size_t nb)
+	: Workers(nb?nb:1), Mutex(), WorkAvailable(), TaskDone(), NbPending(0), Generation(0),
+	  CancelGeneration(0), NextQueue(0), Stop(false)
+{
+	if(!nb)
+	{
+		long Nb(sysconf(_SC_NPROCESSORS_ONLN));
+		nb=(Nb>0)?static_cast<size_t>(Nb):1;
+	}
+	if(pthread_key_create(&Key,0))
+		mThrowRException("Cannot create the key of the thread pool");
+
+	// All the workers must exist before the first one can steal a task
+	for(size_t i=0;i<nb;i++)
+		Workers.InsertPtr(new RThreadPoolWorker(this,i));
+	RCursor<RThreadPoolWorker> Worker(Workers);
+	for(Worker.Start();!Worker.End();Worker.Next())
+		Worker()->Start();
+}
+
+
+//------------------------------------------------------------------------------
+RThreadPoolWorker* RThreadPool::GetWorker(void) const
+{
+	return(static_cast<RThreadPoolWorker*>(pthread_getspecific(Key)));
+}
+
+
+//------------------------------------------------------------------------------
+size_t RThreadPool::GetWorkerId(void) const
+{
+	RThreadPoolWorker* Worker(GetWorker());
+	if(Worker)
+		return(Worker->GetId());
+	return(cNoRef);
+}
+
+
+//------------------------------------------------------------------------------
+void RThreadPool::Submit(RThreadPoolTask* task,bool del)
+{
+	if(!task)
+		mThrowRException("Null task");
+	task->Done=false;
+	task->Delete=del;
+	delete task->Error;
+	task->Error=0;
+
+	// A worker adds the task to its own queue, the other threads distribute the
+	// tasks. The task is in a queue before the workers are told it is pending
+	// (a worker taking it only decreases the number once the mutex is free).
+	RThreadPoolWorker* Worker(GetWorker());
+	RSmartMutexPtr Lock(&Mutex);
+	task->Pool=this;
+	task->Generation=(++Generation);
+	if(!Worker)
+		Worker=Workers[(NextQueue++)%Workers.GetNb()];
+	Worker->Push(task);
+	NbPending++;
+	WorkAvailable.WakeUpOne();
+	TaskDone.WakeUpAll();
+}
+
+
+//------------------------------------------------------------------------------
+RThreadPoolTask* RThreadPool::Take(RThreadPoolWorker* worker)
+{
+	RThreadPoolTask* Task(worker->Pop());
+	size_t Nb(Workers.GetNb());
+	for(size_t i=1;(!Task)&&(i<Nb);i++)
+		Task=Workers[(worker->GetId()+i)%Nb]->Steal();
+	if(Task)
+	{
+		RSmartMutexPtr Lock(&Mutex);
+		NbPending--;
+	}
+	return(Task);
+}
+
+
+//------------------------------------------------------------------------------
+void RThreadPool::Execute(RThreadPoolTask* task,RThreadPoolWorker* worker)
+{
+	if(!task->IsCancelled())
+	{
+		try
+		{
+			task->Run(worker->GetId());
+		}
+		catch(RException& e)
+		{
+			task->Error=new RString(e.GetMsg());
+		}
+		catch(std::exception& e)
+		{
+			task->Error=new RString(e.what());
+		}
+		catch(...)
+		{
+			task->Error=new RString("Unknown exception");
+		}
+	}
+
+	// The task may be destroyed by a waiting thread as soon as it is done
+	bool Del;
+	{
+		RSmartMutexPtr Lock(&Mutex);
+		Del=task->Delete;
+		task->Done=true;
+		TaskDone.WakeUpAll();
+	}
+	if(Del)
+		delete task;
+}
+
+
+//------------------------------------------------------------------------------
+void RThreadPool::Wait(RThreadPoolTask* task)
+{
+	if((!task)||(task->Pool!=this))
+		mThrowRException("Task not submitted to the pool");
+	RThreadPoolWorker* Worker(GetWorker());
+	if(!Worker)
+	{
+		RSmartMutexPtr Lock(&Mutex);
+		while(!task->Done)
+			TaskDone.Wait(&Mutex);
+		return;
+	}
+
+	// A worker executes the pending tasks while it waits
+	while(true)
+	{
+		{
+			RSmartMutexPtr Lock(&Mutex);
+			if(task->Done)
+				return;
+		}
+		RThreadPoolTask* Task(Take(Worker));
+		if(Task)
+		{
+			Execute(Task,Worker);
+			continue;
+		}
+		RSmartMutexPtr Lock(&Mutex);
+		while((!task->Done)&&(!NbPending))
+			TaskDone.Wait(&Mutex);
+	}
+}
+
+
+//------------------------------------------------------------------------------
+bool RThreadPool::WaitAll(RContainer<RThreadPoolTask,true,false>& tasks)
+{
+	// The message is only copied when thrown, since a default string would
+	// share the null string with the other workers
+	bool Cancelled(false);
+	RThreadPoolTask* Failed(0);
+	RCursor<RThreadPoolTask> Task(tasks);
+	for(Task.Start();!Task.End();Task.Next())
+	{
+		Wait(Task());
+		if(Task()->HasFailed()&&(!Failed))
+		{
+			Failed=Task();
+			RCursor<RThreadPoolTask> Cur(tasks);
+			for(Cur.Start();!Cur.End();Cur.Next())
+				Cur()->Cancel();
+		}
+		if(Task()->IsCancelled())
+			Cancelled=true;
+	}
+	if(Failed)
+		mThrowRException(Failed->GetError());
+	return(!Cancelled);
+}
+
+
+//------------------------------------------------------------------------------
+void RThreadPool::CancelAll(void)
+{
+	RSmartMutexPtr Lock(&Mutex);
+	__atomic_store_n(&CancelGeneration,Generation,__ATOMIC_RELEASE);
+}
+
+
+//------------------------------------------------------------------------------
+RThreadPool::~RThreadPool(void)
+{
+	{
+		RSmartMutexPtr Lock(&Mutex);
+		Stop=true;
+		WorkAvailable.WakeUpAll();
+	}
+	RCursor<RThreadPoolWorker> Worker(Workers);
+	for(Worker.Start();!Worker.End();Worker.Next())
+		Worker()->Wait();
+	pthread_key_delete(Key);
+}
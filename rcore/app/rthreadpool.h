@@ -0,0 +1,634 @@
+/*
+
+	R Project Library
+
+	RThreadPool.h
+
+	Pool of Threads - Header.
+
+	Copyright 2006-2015 by Pascal Francq (pascal@francq.info).
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Library General Public
+	License as published by the Free Software Foundation; either
+	version 2.0 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Library General Public License for more details.
+
+	You should have received a copy of the GNU Library General Public
+	License along with this library, as a file COPYING.LIB; if not, write
+	to the Free Software Foundation, Inc., 59 Temple Place, Suite 330,
+	Boston, MA  02111-1307  USA
+
+*/
+
+
+
+//-----------------------------------------------------------------------------
+#ifndef RThreadPool_H
+#define RThreadPool_H
+
+
+//-----------------------------------------------------------------------------
+// include files for R Project
+#include <rthread.h>
+#include <rmutex.h>
+#include <rconditionvar.h>
+#include <rcontainer.h>
+#include <rcursor.h>
+#include <rnumcontainer.h>
+#include <rnumcursor.h>
+
+
+//-----------------------------------------------------------------------------
+namespace R{
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+// forward declaration
+class RThreadPool;
+class RThreadPoolWorker;
+
+
+//-----------------------------------------------------------------------------
+/**
+* The RThreadPoolTask class represents a task executed by a R::RThreadPool. The
+* method Run must be overloaded and contains the code of the task. Once
+* submitted, the task plays the role of a "future": RThreadPool::Wait blocks
+* until it is executed, and the methods HasFailed and GetError tell if an
+* exception occurred.
+*
+* The cancellation is cooperative: a task cancelled before it starts is never
+* executed, while a running task must call IsCancelled regularly and stop when
+* it returns true.
+* @code
+* class MyTask : public RThreadPoolTask
+* {
+* public:
+*    MyTask(void) : RThreadPoolTask() {}
+*    virtual void Run(size_t worker)
+*    {
+*       for(size_t i=0;(i<1000)&&(!IsCancelled());i++)
+*          DoSomething(i);
+*    }
+* };
+* @endcode
+* @short Task of a Thread Pool.
+*/
+class RThreadPoolTask
+{
+	/**
+	* Pool executing the task.
+	*/
+	RThreadPool* Pool;
+
+	/**
+	* Order of the submission of the task in the pool.
+	*/
+	size_t Generation;
+
+	/**
+	* Is the task executed?
+	*/
+	bool Done;
+
+	/**
+	* Must the task be deleted by the pool once executed?
+	*/
+	bool Delete;
+
+	/**
+	* Was the task cancelled? It is only accessed with atomic operations.
+	*/
+	bool Cancelled;
+
+	/**
+	* Message of the exception. It is only allocated if an exception occurs,
+	* so that the tasks can be created by the workers without sharing the
+	* null string between the threads.
+	*/
+	RString* Error;
+
+public:
+
+	/**
+	* Construct the task.
+	*/
+	RThreadPoolTask(void);
+
+private:
+
+	/**
+	* Method containing the code of the task. It must be overloaded by child
+	* classes.
+	* @param worker          Identifier of the worker executing the task (between
+	*                        0 and RThreadPool::GetNbWorkers()-1).
+	*/
+	virtual void Run(size_t worker)=0;
+
+public:
+
+	/**
+	* Compare two tasks by their order of submission.
+	* @param task            Task to compare with.
+	* @return a value compatible with R::RContainer.
+	*/
+	int Compare(const RThreadPoolTask& task) const {return(CompareIds(Generation,task.Generation));}
+
+	/**
+	* Cancel the task.
+	*/
+	void Cancel(void) {__atomic_store_n(&Cancelled,true,__ATOMIC_RELEASE);}
+
+	/**
+	* Look if the task was cancelled (directly or by RThreadPool::CancelAll).
+	*/
+	bool IsCancelled(void) const;
+
+	/**
+	* Look if the task is executed. It is also the case of a cancelled task once
+	* the pool has removed it.
+	*/
+	bool IsDone(void) const {return(Done);}
+
+	/**
+	* Look if an exception occurred while the task was executed.
+	*/
+	bool HasFailed(void) const {return(Error!=0);}
+
+	/**
+	* Get the message of the exception that occurred.
+	*/
+	RString GetError(void) const;
+
+	/**
+	* Destruct the task.
+	*/
+	virtual ~RThreadPoolTask(void);
+
+	friend class RThreadPool;
+};
+
+
+//-----------------------------------------------------------------------------
+/**
+* The RThreadPoolWorker class represents a thread of a R::RThreadPool. Each
+* worker has its own queue of tasks: it executes the last task added (the
+* data used are probably still in the cache) and, when its queue is empty, it
+* steals the oldest task of the queue of another worker.
+* @short Worker of a Thread Pool.
+*/
+class RThreadPoolWorker : public RThread
+{
+	/**
+	* Pool.
+	*/
+	RThreadPool* Pool;
+
+	/**
+	* Mutex protecting the queue.
+	*/
+	RMutex Mutex;
+
+	/**
+	* Circular array of the tasks in the queue.
+	*/
+	RThreadPoolTask** Tasks;
+
+	/**
+	* Size of the array.
+	*/
+	size_t MaxTasks;
+
+	/**
+	* Position of the oldest task.
+	*/
+	size_t First;
+
+	/**
+	* Number of tasks in the queue.
+	*/
+	size_t NbTasks;
+
+	/**
+	* Construct the worker.
+	* @param pool            Pool.
+	* @param id              Identifier of the worker.
+	*/
+	RThreadPoolWorker(RThreadPool* pool,size_t id);
+
+	/**
+	* Add a task at the end of the queue.
+	* @param task            Task.
+	*/
+	void Push(RThreadPoolTask* task);
+
+	/**
+	* Remove the last task of the queue.
+	* @return the task or 0 if the queue is empty.
+	*/
+	RThreadPoolTask* Pop(void);
+
+	/**
+	* Remove the first task of the queue.
+	* @return the task or 0 if the queue is empty.
+	*/
+	RThreadPoolTask* Steal(void);
+
+	/**
+	* Execute the tasks until the pool is destroyed.
+	*/
+	virtual void Run(void);
+
+public:
+
+	/**
+	* Compare two workers.
+	* @param worker          Worker to compare with.
+	* @return a value compatible with R::RContainer.
+	*/
+	int Compare(const RThreadPoolWorker& worker) const {return(CompareIds(GetId(),worker.GetId()));}
+
+	/**
+	* Destruct the worker.
+	*/
+	virtual ~RThreadPoolWorker(void);
+
+	friend class RThreadPool;
+};
+
+
+//-----------------------------------------------------------------------------
+/**
+* The RThreadPool class provides a pool of threads (workers) that execute
+* tasks (R::RThreadPoolTask). The threads are created once, and the tasks are
+* distributed through a queue by worker: a task submitted by a worker is added
+* to its own queue, and the idle workers steal the tasks of the busy ones.
+*
+* When a worker waits for a task (for example a task that splits its work in
+* several sub-tasks), it executes the pending tasks in the meantime. The tasks
+* can therefore be nested without blocking the pool. Other threads are
+* blocked until the task is executed.
+* @code
+* RThreadPool Pool;
+* MyTask Task;
+* Pool.Submit(&Task);
+* Pool.Wait(&Task);
+* if(Task.HasFailed())
+*    cout<<Task.GetError()<<endl;
+* @endcode
+*
+* The ParallelFor methods execute a function object over a range of indexes,
+* the elements of a R::RCursor or the values of a R::RNumCursor. The range is
+* split in several tasks:
+* @code
+* class Square
+* {
+* public:
+*    double* Values;
+*    Square(double* values) : Values(values) {}
+*    void operator()(size_t i,size_t worker) {Values[i]*=Values[i];}
+* };
+*
+* Square Func(Values);
+* Pool.ParallelFor(0,NbValues,Func);
+* @endcode
+* The identifier of the worker (between 0 and GetNbWorkers()-1) is passed to
+* the tasks and to the function objects. Combined with a
+* R::RThreadLocalStorage where a data structure is reserved for each worker
+* (see Reserve), it gives access to data proper to each thread.
+* @short Thread Pool.
+*/
+class RThreadPool
+{
+	/**
+	* Task calling a function object for a range of indexes.
+	*/
+	template<class cFunc> class IndexTask : public RThreadPoolTask
+	{
+		cFunc& Func;
+		size_t Begin;
+		size_t End;
+	public:
+		IndexTask(cFunc& func,size_t begin,size_t end) : RThreadPoolTask(), Func(func), Begin(begin), End(end) {}
+		virtual void Run(size_t worker)
+		{
+			for(size_t i=Begin;(i<End)&&(!IsCancelled());i++)
+				Func(i,worker);
+		}
+	};
+
+	/**
+	* Function object called for each element of an array.
+	*/
+	template<class T,class cFunc> class ArrayFunc
+	{
+		T* Tab;
+		cFunc& Func;
+	public:
+		ArrayFunc(T* tab,cFunc& func) : Tab(tab), Func(func) {}
+		inline void operator()(size_t i,size_t worker) {Func(Tab[i],worker);}
+	};
+
+	/**
+	* Function object called for each value referenced by an array.
+	*/
+	template<class I,class cFunc> class ValueFunc
+	{
+		I** Tab;
+		cFunc& Func;
+	public:
+		ValueFunc(I** tab,cFunc& func) : Tab(tab), Func(func) {}
+		inline void operator()(size_t i,size_t worker) {Func(*Tab[i],worker);}
+	};
+
+	/**
+	* Workers.
+	*/
+	RContainer<RThreadPoolWorker,true,false> Workers;
+
+	/**
+	* Key used to find the worker corresponding to the current thread.
+	*/
+	pthread_key_t Key;
+
+	/**
+	* Mutex protecting the state of the pool.
+	*/
+	RMutex Mutex;
+
+	/**
+	* Condition signaled when a task is submitted.
+	*/
+	RConditionVar WorkAvailable;
+
+	/**
+	* Condition signaled when a task is executed (or submitted).
+	*/
+	RConditionVar TaskDone;
+
+	/**
+	* Number of tasks submitted but not yet taken by a worker.
+	*/
+	size_t NbPending;
+
+	/**
+	* Number of tasks submitted.
+	*/
+	size_t Generation;
+
+	/**
+	* The tasks submitted until this generation are cancelled. It is only
+	* accessed with atomic operations.
+	*/
+	size_t CancelGeneration;
+
+	/**
+	* Queue receiving the next task submitted by a thread that is not a worker.
+	*/
+	size_t NextQueue;
+
+	/**
+	* Must the workers stop?
+	*/
+	bool Stop;
+
+public:
+
+	/**
+	* Construct the pool and start the workers.
+	* @param nb              Number of workers. If null, the number of
+	*                        processors is used.
+	*/
+	RThreadPool(size_t nb=0);
+
+	/**
+	* Get the number of workers.
+	*/
+	size_t GetNbWorkers(void) const {return(Workers.GetNb());}
+
+	/**
+	* Get the identifier of the worker corresponding to the current thread.
+	* @return the identifier or cNoRef if the current thread is not a worker of
+	* the pool.
+	*/
+	size_t GetWorkerId(void) const;
+
+	/**
+	* Submit a task.
+	* @param task            Task.
+	* @param del             Must the task be deleted once executed? In this
+	*                        case, it cannot be waited.
+	*/
+	void Submit(RThreadPoolTask* task,bool del=false);
+
+	/**
+	* Wait that a task is executed.
+	* @param task            Task.
+	*/
+	void Wait(RThreadPoolTask* task);
+
+	/**
+	* Cancel all the tasks submitted until now. The tasks submitted later are
+	* executed normally.
+	*/
+	void CancelAll(void);
+
+	/**
+	* Reserve a data structure for each worker in a thread local storage. The
+	* identifier of a worker gives then directly access to its data structure.
+	* @tparam C              Class of the data structures.
+	* @param storage         Thread local storage.
+	*/
+	template<class C> void Reserve(RThreadLocalStorage<C>& storage)
+	{
+		for(size_t i=0;i<Workers.GetNb();i++)
+			storage.Reserve(i);
+	}
+
+	/**
+	* Call a function object for a range of indexes. The range is split in
+	* several tasks, and the method returns when they are all executed. If an
+	* exception occurs, the remaining tasks are cancelled and an exception is
+	* generated.
+	*
+	* The function object must provide the method:
+	* @code
+	* void operator()(size_t i,size_t worker);
+	* @endcode
+	* @tparam cFunc          Function object.
+	* @param begin           First index.
+	* @param end             Index after the last one.
+	* @param func            Function object.
+	* @param grain           Minimum number of indexes treated by a task.
+	* @return false if some indexes were not treated because of a cancellation.
+	*/
+	template<class cFunc> bool ParallelFor(size_t begin,size_t end,cFunc& func,size_t grain=1);
+
+	/**
+	* Call a function object for each element of a cursor (see
+	* ParallelFor(size_t,size_t,cFunc&,size_t)). The function object must
+	* provide the method:
+	* @code
+	* void operator()(C* ptr,size_t worker);
+	* @endcode
+	* @tparam C              Class of the elements.
+	* @tparam cFunc          Function object.
+	* @param cur             Cursor.
+	* @param func            Function object.
+	* @param grain           Minimum number of elements treated by a task.
+	* @return false if some elements were not treated because of a cancellation.
+	*/
+	template<class C,class cFunc> bool ParallelFor(const RCursor<C>& cur,cFunc& func,size_t grain=1);
+
+	/**
+	* Call a function object for each value of a cursor (see
+	* ParallelFor(size_t,size_t,cFunc&,size_t)). The function object must
+	* provide the method:
+	* @code
+	* void operator()(I& value,size_t worker);
+	* @endcode
+	* @tparam I              Type of the values.
+	* @tparam cFunc          Function object.
+	* @param cur             Cursor.
+	* @param func            Function object.
+	* @param grain           Minimum number of values treated by a task.
+	* @return false if some values were not treated because of a cancellation.
+	*/
+	template<class I,class cFunc> bool ParallelFor(const RNumCursor<I>& cur,cFunc& func,size_t grain=1);
+
+private:
+
+	/**
+	* Get the worker corresponding to the current thread.
+	* @return the worker or 0 if the current thread is not a worker of the pool.
+	*/
+	RThreadPoolWorker* GetWorker(void) const;
+
+	/**
+	* Take a task: the last one of the queue of a given worker or, if it is
+	* empty, the first one of the queue of another worker.
+	* @param worker          Worker.
+	* @return the task or 0 if no task is pending.
+	*/
+	RThreadPoolTask* Take(RThreadPoolWorker* worker);
+
+	/**
+	* Execute a task.
+	* @param task            Task.
+	* @param worker          Worker executing the task.
+	*/
+	void Execute(RThreadPoolTask* task,RThreadPoolWorker* worker);
+
+	/**
+	* Wait that some tasks are executed. If one of them failed, the other ones
+	* are cancelled and an exception is generated.
+	* @param tasks           Tasks.
+	* @return false if a task was cancelled.
+	*/
+	bool WaitAll(RContainer<RThreadPoolTask,true,false>& tasks);
+
+public:
+
+	/**
+	* Destruct the pool. The pending tasks are executed before the workers
+	* stop.
+	*/
+	~RThreadPool(void);
+
+	friend class RThreadPoolTask;
+	friend class RThreadPoolWorker;
+};
+
+
+//-----------------------------------------------------------------------------
+template<class cFunc>
+	bool RThreadPool::ParallelFor(size_t begin,size_t end,cFunc& func,size_t grain)
+{
+	if(end<=begin)
+		return(true);
+
+	// Split the range in four tasks by worker (if they are large enough)
+	size_t Nb(end-begin);
+	if(!grain)
+		grain=1;
+	size_t NbTasks(4*Workers.GetNb());
+	if(NbTasks>(Nb+grain-1)/grain)
+		NbTasks=(Nb+grain-1)/grain;
+	size_t Size((Nb+NbTasks-1)/NbTasks);
+	RContainer<RThreadPoolTask,true,false> Tasks(NbTasks);
+	for(size_t i=begin;i<end;i+=Size)
+	{
+		RThreadPoolTask* Task(new IndexTask<cFunc>(func,i,(end-i>Size)?i+Size:end));
+		Tasks.InsertPtr(Task);
+		Submit(Task);
+	}
+	return(WaitAll(Tasks));
+}
+
+
+//-----------------------------------------------------------------------------
+template<class C,class cFunc>
+	bool RThreadPool::ParallelFor(const RCursor<C>& cur,cFunc& func,size_t grain)
+{
+	size_t Nb(cur.GetNb());
+	if(!Nb)
+		return(true);
+	C** Tab(new C*[Nb]);
+	RCursor<C> Cur(cur);
+	size_t i(0);
+	for(Cur.Start();!Cur.End();Cur.Next())
+		Tab[i++]=Cur();
+	ArrayFunc<C*,cFunc> Func(Tab,func);
+	bool Ok;
+	try
+	{
+		Ok=ParallelFor(0,i,Func,grain);
+	}
+	catch(...)
+	{
+		delete[] Tab;
+		throw;
+	}
+	delete[] Tab;
+	return(Ok);
+}
+
+
+//-----------------------------------------------------------------------------
+template<class I,class cFunc>
+	bool RThreadPool::ParallelFor(const RNumCursor<I>& cur,cFunc& func,size_t grain)
+{
+	size_t Nb(cur.GetNb());
+	if(!Nb)
+		return(true);
+	I** Tab(new I*[Nb]);
+	RNumCursor<I> Cur(cur);
+	size_t i(0);
+	for(Cur.Start();!Cur.End();Cur.Next())
+		Tab[i++]=&Cur();
+	ValueFunc<I,cFunc> Func(Tab,func);
+	bool Ok;
+	try
+	{
+		Ok=ParallelFor(0,i,Func,grain);
+	}
+	catch(...)
+	{
+		delete[] Tab;
+		throw;
+	}
+	delete[] Tab;
+	return(Ok);
+}
+
+
+}  //-------- End of namespace R ----------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+#endif
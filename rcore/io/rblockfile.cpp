@@ -30,7 +30,11 @@
 //------------------------------------------------------------------------------
 // include files for R Project
 #include <rblockfile.h>
+#include <rblockfileaccess.h>
 #include <rcursor.h>
+#include <rthread.h>
+#include <rmutex.h>
+#include <rconditionvar.h>
 using namespace R;
 using namespace std;
 
@@ -42,6 +46,181 @@ const size_t HeaderSize=2048;
 
 
 
+//------------------------------------------------------------------------------
+//
+// RBlockFileIO
+//
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+namespace R{
+/**
+ * The RBlockFileIO class provides the thread reading and writing the blocks of
+ * a file asynchronously. The requests are treated in the order they are
+ * submitted. The members are protected by the mutex.
+ */
+class RBlockFileIO : public RThread
+{
+public:
+
+	/**
+	 * Read or write of a block.
+	 */
+	class Request
+	{
+	public:
+		RBlockFileData* Block;      // Block to read (null for a write).
+		char* Data;                 // Data to read or to write.
+		size_t Id;                  // Identifier of the block.
+	};
+
+	RBlockFile* File;              // File.
+	RMutex Mutex;                  // Mutex protecting the members.
+	RConditionVar Cond;            // A request was submitted or done.
+	Request* Requests;             // Circular list of requests.
+	size_t MaxRequests;            // Maximal number of requests.
+	size_t FirstRequest;           // First request (it may be in treatment).
+	size_t NbRequests;             // Number of requests.
+	char** Buffers;                // Free buffers to write the blocks.
+	size_t NbBuffers;              // Number of free buffers.
+	size_t MaxBuffers;             // Number of buffers.
+	bool Stop;                     // Must the thread stop ?
+	RString* Error;                // Error of a write (null if none).
+
+	RBlockFileIO(RBlockFile* file,size_t nbreads,size_t nbbuffers);
+	void Push(RBlockFileData* block,char* data,size_t id);
+	Request* FindWrite(size_t id);
+	void WaitAll(void);
+	virtual void Run(void);
+	virtual ~RBlockFileIO(void);
+};
+}
+
+
+//------------------------------------------------------------------------------
+RBlockFileIO::RBlockFileIO(RBlockFile* file,size_t nbreads,size_t nbbuffers)
+	: RThread(0,"RBlockFileIO"), File(file), Mutex(), Cond(), Requests(0), MaxRequests(nbreads+nbbuffers),
+	  FirstRequest(0), NbRequests(0), Buffers(0), NbBuffers(nbbuffers), MaxBuffers(nbbuffers), Stop(false), Error(0)
+{
+	Requests=new Request[MaxRequests];
+	Buffers=new char*[MaxBuffers];
+	for(size_t i=0;i<MaxBuffers;i++)
+		Buffers[i]=new char[File->BlockSize];
+}
+
+
+//------------------------------------------------------------------------------
+void RBlockFileIO::Push(RBlockFileData* block,char* data,size_t id)
+{
+	// The mutex must be locked
+	while(NbRequests==MaxRequests)
+		Cond.Wait(&Mutex);
+	Request& Req(Requests[(FirstRequest+NbRequests)%MaxRequests]);
+	Req.Block=block;
+	Req.Data=data;
+	Req.Id=id;
+	NbRequests++;
+	Cond.WakeUpAll();
+}
+
+
+//------------------------------------------------------------------------------
+RBlockFileIO::Request* RBlockFileIO::FindWrite(size_t id)
+{
+	// The mutex must be locked. The last write of the block is searched.
+	for(size_t i=NbRequests;i--;)
+	{
+		Request& Req(Requests[(FirstRequest+i)%MaxRequests]);
+		if((!Req.Block)&&(Req.Id==id))
+			return(&Req);
+	}
+	return(0);
+}
+
+
+//------------------------------------------------------------------------------
+void RBlockFileIO::WaitAll(void)
+{
+	// The mutex must be locked
+	while(NbRequests)
+		Cond.Wait(&Mutex);
+}
+
+
+//------------------------------------------------------------------------------
+void RBlockFileIO::Run(void)
+{
+	Mutex.Lock();
+	while(true)
+	{
+		while((!NbRequests)&&(!Stop))
+			Cond.Wait(&Mutex);
+		if(!NbRequests)
+			break;
+
+		// Treat the first request without locking the mutex. The message is
+		// only allocated on a failure, since a default string would share the
+		// null string with the other threads.
+		Request Req(Requests[FirstRequest]);
+		Mutex.UnLock();
+		off_t Pos(((Req.Id-1)*File->BlockSize)+HeaderSize);
+		RString* Msg(0);
+		try
+		{
+			if(Req.Block)
+				File->ReadBytes(Req.Data,File->BlockSize,Pos);
+			else
+				File->WriteBytes(Req.Data,File->BlockSize,Pos);
+		}
+		catch(RException& e)
+		{
+			Msg=new RString(e.GetMsg());
+		}
+		catch(std::exception& e)
+		{
+			Msg=new RString(e.what());
+		}
+		catch(...)
+		{
+			Msg=new RString("Unknown exception");
+		}
+		Mutex.Lock();
+
+		// A failed read is done again by the file, while a failed write is reported
+		if(Req.Block)
+		{
+			Req.Block->Loading=false;
+			Req.Block->Failed=(Msg!=0);
+			delete Msg;
+		}
+		else
+		{
+			Buffers[NbBuffers++]=Req.Data;
+			if(Error)
+				delete Msg;
+			else
+				Error=Msg;
+		}
+		FirstRequest=(FirstRequest+1)%MaxRequests;
+		NbRequests--;
+		Cond.WakeUpAll();
+	}
+	Mutex.UnLock();
+}
+
+
+//------------------------------------------------------------------------------
+RBlockFileIO::~RBlockFileIO(void)
+{
+	for(size_t i=0;i<NbBuffers;i++)
+		delete[] Buffers[i];
+	delete[] Buffers;
+	delete[] Requests;
+	delete Error;
+}
+
+
+
 //------------------------------------------------------------------------------
 //
 // RBlockFile
@@ -50,8 +229,10 @@ const size_t HeaderSize=2048;
 
 //------------------------------------------------------------------------------
 RBlockFile::RBlockFile(const RURI& uri,size_t nbcaches)
-  : RIOFile(uri), Type(WriteBack), BlockSize(cNoRef), Cache(nbcaches),
-    Current(0), NbBlocks(0)
+  : RIOFile(uri), Type(WriteBack), BlockSize(cNoRef), Policy(LRU), Cache(nbcaches),
+    Buckets(0), Mask(0), First(0), Last(0), Hand(0), NbHits(0), NbMisses(0), NbEvictions(0),
+    NbWriteBacks(0), Current(0), NbBlocks(0), Async(false), ReadAhead(0), NbBuffers(0), IO(0),
+    LastId(0), NbPrefetches(0), lCache(), cCache(), NbPins(0)
 {
 	if(!BlockSize)
 		mThrowRIOException(this,"Block size cannot be null");
@@ -60,8 +241,10 @@ RBlockFile::RBlockFile(const RURI& uri,size_t nbcaches)
 
 //------------------------------------------------------------------------------
 RBlockFile::RBlockFile(const RURI& uri,size_t blocksize,size_t nbcaches)
-  : RIOFile(uri), Type(WriteBack), BlockSize(blocksize*1024), Cache(nbcaches),
-    Current(0), NbBlocks(0)
+  : RIOFile(uri), Type(WriteBack), BlockSize(blocksize*1024), Policy(LRU), Cache(nbcaches),
+    Buckets(0), Mask(0), First(0), Last(0), Hand(0), NbHits(0), NbMisses(0), NbEvictions(0),
+    NbWriteBacks(0), Current(0), NbBlocks(0), Async(false), ReadAhead(0), NbBuffers(0), IO(0),
+    LastId(0), NbPrefetches(0), lCache(), cCache(), NbPins(0)
 {
 	if(!BlockSize)
 		mThrowRIOException(this,"Block size cannot be null");
@@ -71,6 +254,7 @@ RBlockFile::RBlockFile(const RURI& uri,size_t blocksize,size_t nbcaches)
 //------------------------------------------------------------------------------
 void RBlockFile::Open(RIO::ModeType mode)
 {
+	StopIO();
 	RIOFile::Open(mode);
 	RIOFile::Seek(0);
 	if(End())
@@ -103,9 +287,21 @@ void RBlockFile::Open(RIO::ModeType mode)
 
 	// Clear internal structure
 	Cache.Clear();
+	if(!Buckets)
+	{
+		size_t NbBuckets(1);
+		while(NbBuckets<2*Cache.GetMaxNb())
+			NbBuckets<<=1;
+		Mask=NbBuckets-1;
+		Buckets=new RBlockFileData*[NbBuckets];
+	}
+	memset(Buckets,0,(Mask+1)*sizeof(RBlockFileData*));
+	First=Last=0;
+	Hand=0;
 	Current=0;
 	CurrentPos=0;
 	CurrentData=0;
+	LastId=0;
 }
 
 
@@ -114,6 +310,7 @@ void RBlockFile::Close(void)
 {
 	if(IsOpen())
 		Flush();
+	StopIO();
 }
 
 
@@ -124,6 +321,7 @@ void RBlockFile::Clear(void)
 		mThrowRIOException(this,"File not opened");
 
 	// Close the file, erase it, initialize the parameter
+	StopIO();
 	RIOFile::Close();
 	RFile::RemoveFile(GetURI());
 	NbBlocks=0;
@@ -143,6 +341,11 @@ void RBlockFile::SetCacheType(CacheType type)
 	Type=type;
 	if((Old==WriteBack)&&(Type==WriteThrough))
 		Flush();
+	else
+	{
+		RSmartMutexPtr Latch(&lCache);
+		RIOFile::Flush();
+	}
 }
 
 
@@ -152,90 +355,407 @@ void RBlockFile::Flush(void)
 	if(!IsOpen())
 		mThrowRIOException(this,"File not opened");
 
-	// Go trough all the blocks in memory and save those who are dirty
+	// The data written through the file and the blocks written in the
+	// background must be on disk
+	RSmartMutexPtr Latch(&lCache);
+	RIOFile::Flush();
+	if(IO)
+	{
+		IO->Mutex.Lock();
+		IO->WaitAll();
+		RString* Error(IO->Error);
+		IO->Error=0;
+		IO->Mutex.UnLock();
+		if(Error)
+		{
+			RString Msg(*Error);
+			delete Error;
+			mThrowRIOException(this,Msg);
+		}
+	}
+
+	// Go trough all the blocks in memory (ordered by identifiers to write
+	// contiguous blocks in sequence) and save those who are dirty
+	Cache.ReOrder();
 	RCursor<RBlockFileData> Cur(Cache);
 	for(Cur.Start();!Cur.End();Cur.Next())
 	{
-		if(Cur()->Dirty)
+		if(!Cur()->Dirty)
+			continue;
+		WriteBytes(Cur()->Data,BlockSize,((Cur()->Id-1)*BlockSize)+HeaderSize);
+		Cur()->Dirty=false;
+		NbWriteBacks++;
+	}
+}
+
+
+//------------------------------------------------------------------------------
+void RBlockFile::SetAsyncIO(bool async,size_t readahead,size_t nbbuffers)
+{
+	StopIO();
+	Async=async;
+	ReadAhead=readahead;
+	if(ReadAhead>Cache.GetMaxNb()/2)
+		ReadAhead=Cache.GetMaxNb()/2;
+	NbBuffers=nbbuffers;
+	if((!ReadAhead)&&(!NbBuffers))
+		Async=false;
+}
+
+
+//------------------------------------------------------------------------------
+void RBlockFile::StopIO(void)
+{
+	if(!IO)
+		return;
+
+	// Wait that the requests are done and stop the thread
+	IO->Mutex.Lock();
+	IO->WaitAll();
+	IO->Stop=true;
+	IO->Cond.WakeUpAll();
+	RString* Error(IO->Error);
+	IO->Error=0;
+	IO->Mutex.UnLock();
+	IO->Wait();
+	delete IO;
+	IO=0;
+	if(Error)
+	{
+		RString Msg(*Error);
+		delete Error;
+		mThrowRIOException(this,Msg);
+	}
+}
+
+
+//------------------------------------------------------------------------------
+void RBlockFile::MoveFirst(RBlockFileData* block)
+{
+	if(block==First)
+		return;
+
+	// Remove the block from the list
+	if(block->Prev)
+		block->Prev->Next=block->Next;
+	if(block->Next)
+		block->Next->Prev=block->Prev;
+	else if(block==Last)
+		Last=block->Prev;
+
+	// Insert it at the beginning
+	block->Prev=0;
+	block->Next=First;
+	if(First)
+		First->Prev=block;
+	First=block;
+	if(!Last)
+		Last=block;
+}
+
+
+//------------------------------------------------------------------------------
+RBlockFileData* RBlockFile::SelectVictim(RBlockFileData* keep)
+{
+	RBlockFileData* ptr;
+
+	if(Policy==LRU)
+	{
+		for(ptr=Last;ptr;ptr=ptr->Prev)
+			if((!ptr->Loading)&&(ptr!=keep)&&(!ptr->Access.GetNb()))
+				return(ptr);
+		return(0);
+	}
+
+	// Move the clock until a block not referenced is found (at most two turns
+	// are done since the blocks passed are no more referenced)
+	size_t Nb(Cache.GetNb());
+	for(size_t i=2*Nb+1;--i;)
+	{
+		if(Hand>=Nb)
+			Hand=0;
+		ptr=Cache[Hand++];
+		if(ptr->Loading||(ptr==keep)||ptr->Access.GetNb())
+			continue;
+		if(!ptr->Referenced)
+			return(ptr);
+		ptr->Referenced=false;
+	}
+	return(0);
+}
+
+
+//------------------------------------------------------------------------------
+RBlockFileData* RBlockFile::GetFreeBlock(RBlockFileData* keep)
+{
+	RBlockFileData* ptr;
+
+	// If the cache is not full -> create a new block
+	if(Cache.GetNb()<Cache.GetMaxNb())
+	{
+		ptr=new RBlockFileData(0,BlockSize);
+		Cache.InsertPtr(ptr);
+		return(ptr);
+	}
+
+	// Cache is full -> The block must replace another one
+	if(IO)
+		IO->Mutex.Lock();
+	ptr=SelectVictim(keep);
+	if(IO)
+		IO->Mutex.UnLock();
+	if(!ptr)
+		return(0);
+	NbEvictions++;
+	if(ptr->Dirty)
+		SaveBlock(ptr);
+	if(ptr==Current)
+		Current=0;
+	ptr->Failed=false;
+	ptr->NbAccess=0;
+
+	// Remove it from the index
+	RBlockFileData** Ptr(&Buckets[ptr->Id&Mask]);
+	while((*Ptr)!=ptr)
+		Ptr=&((*Ptr)->Collision);
+	(*Ptr)=ptr->Collision;
+	return(ptr);
+}
+
+
+//------------------------------------------------------------------------------
+void RBlockFile::SaveBlock(RBlockFileData* block)
+{
+	// The data written through the file must be on disk before
+	RIOFile::Flush();
+
+	if(Async&&NbBuffers)
+	{
+		if(!IO)
 		{
-			RIOFile::Seek(((Cur()->Id-1)*BlockSize)+HeaderSize);
-			RIOFile::Write(Cur()->Data,BlockSize);
-			Cur()->Dirty=true;
+			IO=new RBlockFileIO(this,ReadAhead,NbBuffers);
+			IO->Start();
 		}
+
+		// Exchange the data with a free buffer and write them in the background
+		IO->Mutex.Lock();
+		while(!IO->NbBuffers)
+			IO->Cond.Wait(&IO->Mutex);
+		char* Data(IO->Buffers[--IO->NbBuffers]);
+		IO->Push(0,block->Data,block->Id);
+		block->Data=Data;
+		IO->Mutex.UnLock();
 	}
+	else
+		WriteBytes(block->Data,BlockSize,((block->Id-1)*BlockSize)+HeaderSize);
+	block->Dirty=false;
+	NbWriteBacks++;
 }
 
 
 //------------------------------------------------------------------------------
-int RBlockFile::sortOrderAccess(const void* a,const void* b)
+void RBlockFile::ReadBlock(RBlockFileData* block)
 {
-	size_t af((*((RBlockFileData**)(a)))->NbAccess);
-	size_t bf((*((RBlockFileData**)(b)))->NbAccess);
+	// The data written through the file must be on disk before
+	RIOFile::Flush();
 
-	if(af==bf) return(0);
-	if(af>bf)
-		return(-1);
-	else
-		return(1);
+	// If the block is written in the background -> its data are the last ones
+	if(IO)
+	{
+		IO->Mutex.Lock();
+		RBlockFileIO::Request* Req(IO->FindWrite(block->Id));
+		if(Req)
+			memcpy(block->Data,Req->Data,BlockSize);
+		IO->Mutex.UnLock();
+		if(Req)
+			return;
+	}
+
+	ReadBytes(block->Data,BlockSize,((block->Id-1)*BlockSize)+HeaderSize);
 }
 
 
 //------------------------------------------------------------------------------
-RBlockFileData* RBlockFile::LoadBlock(size_t id)
+void RBlockFile::PreFetch(RBlockFileData* block)
+{
+	// The data written through the file must be on disk before
+	RIOFile::Flush();
+
+	if(!IO)
+	{
+		IO=new RBlockFileIO(this,ReadAhead,NbBuffers);
+		IO->Start();
+	}
+
+	size_t Max(block->Id+ReadAhead);
+	if(Max>NbBlocks)
+		Max=NbBlocks;
+	for(size_t next=block->Id+1;next<=Max;next++)
+	{
+		if(FindBlock(next))
+			continue;
+		RBlockFileData* ptr(GetFreeBlock(block));
+		if(!ptr)
+			break;
+
+		// Index the block and ask the thread to read it
+		ptr->Id=next;
+		ptr->Collision=Buckets[next&Mask];
+		Buckets[next&Mask]=ptr;
+		ptr->Referenced=true;
+		MoveFirst(ptr);
+		IO->Mutex.Lock();
+		ptr->Loading=true;
+		IO->Push(ptr,ptr->Data,next);
+		IO->Mutex.UnLock();
+		NbPrefetches++;
+	}
+}
+
+
+//------------------------------------------------------------------------------
+RBlockFileData* RBlockFile::LoadBlock(size_t id,RBlockFileData* keep)
 {
 	if(!IsOpen())
 		mThrowRIOException(this,"File not opened");
 
 	// Search for the block in memory
-	RBlockFileData* ptr(Cache.GetPtr(id));
-	if(ptr) return(ptr);
-
-	// Block must be load in memory
-	if(Cache.GetNb()<Cache.GetMaxNb())
+	RBlockFileData* ptr(FindBlock(id));
+	if(ptr)
 	{
-		// Cache is not full
-		ptr=new RBlockFileData(id,BlockSize);
-		Cache.InsertPtr(ptr);
-		if(id<=NbBlocks)
+		NbHits++;
+		ptr->Referenced=true;
+		MoveFirst(ptr);
+		if(IO)
 		{
-			RIOFile::Seek(((id-1)*BlockSize)+HeaderSize);
-			RIOFile::Read(ptr->Data,BlockSize);
+			// Wait that the block is read by the thread (if it fails -> read it again)
+			IO->Mutex.Lock();
+			while(ptr->Loading)
+				IO->Cond.Wait(&IO->Mutex);
+			IO->Mutex.UnLock();
+			if(ptr->Failed)
+			{
+				ptr->Failed=false;
+				ReadBlock(ptr);
+			}
 		}
-		else
-			NbBlocks=id;
 	}
 	else
 	{
-		// Cache is full -> The block must replace another one
-		// Select the less used block in cache
-		Cache.ReOrder(sortOrderAccess);
-		ptr=Cache[0];
-		if(ptr->Dirty)
+		NbMisses++;
+
+		// Block must be load in memory (if all the blocks are read by the thread -> wait)
+		ptr=GetFreeBlock(keep);
+		if((!ptr)&&IO)
 		{
-			// If necessary save the old block
-			RIOFile::Seek(((ptr->Id-1)*BlockSize)+HeaderSize);
-			RIOFile::Write(ptr->Data,BlockSize);
-			ptr->Dirty=false;
+			IO->Mutex.Lock();
+			IO->WaitAll();
+			IO->Mutex.UnLock();
+			ptr=GetFreeBlock(keep);
 		}
-		if(ptr==Current)
-			Current=0;
-		ptr->Id=id;
-		if(id<=NbBlocks)
+
+		// If all the blocks are used by accesses -> wait that one is released
+		while(!ptr)
 		{
-			RIOFile::Seek(((id-1)*BlockSize)+HeaderSize);
-			RIOFile::Read(ptr->Data,BlockSize);
+			if(!NbPins)
+				mThrowRIOException(this,"All the blocks in memory are used");
+			cCache.Wait(&lCache);
+			ptr=GetFreeBlock(keep);
 		}
+
+		// Index the block and read it (a new block is empty and must be saved)
+		ptr->Id=id;
+		ptr->Collision=Buckets[id&Mask];
+		Buckets[id&Mask]=ptr;
+		ptr->Referenced=true;
+		MoveFirst(ptr);
+		if(id<=NbBlocks)
+			ReadBlock(ptr);
 		else
+		{
+			memset(ptr->Data,0,BlockSize);
+			ptr->Dirty=true;
 			NbBlocks=id;
-		ptr->NbAccess=0;
-
-		// Since a identifier was replaced, Cache must be re-ordered by identifiers
-		Cache.ReOrder();
+		}
 	}
+
 	return(ptr);
 }
 
 
+//------------------------------------------------------------------------------
+void RBlockFile::PinBlock(RBlockFileAccess* access,size_t id)
+{
+	if(!IsOpen())
+		mThrowRIOException(this,"File not opened");
+	if(!id)
+		mThrowRIOException(this,"There is no block with a null identifier");
+
+	// The block used by the access and the current block cannot be replaced
+	RSmartMutexPtr Latch(&lCache);
+	if(access->Block)
+		Release(access);
+	access->Block=LoadBlock(id,Current);
+	access->Block->Access.InsertPtrAt(access,access->Block->Access.GetNb(),false);
+	NbPins++;
+}
+
+
+//------------------------------------------------------------------------------
+void RBlockFile::UnPinBlock(RBlockFileAccess* access)
+{
+	if(!access->Block)
+		return;
+
+	RSmartMutexPtr Latch(&lCache);
+	Release(access);
+}
+
+
+//------------------------------------------------------------------------------
+void RBlockFile::Release(RBlockFileAccess* access)
+{
+	RCursor<RBlockFileAccess> Cur(access->Block->Access);
+	for(Cur.Start();!Cur.End();Cur.Next())
+		if(Cur()==access)
+		{
+			access->Block->Access.DeletePtrAt(Cur.GetPos(),true);
+			break;
+		}
+	if(!access->Block->Access.GetNb())
+		cCache.WakeUpAll();
+	access->Block=0;
+	NbPins--;
+}
+
+
+//------------------------------------------------------------------------------
+void RBlockFile::WriteOnDisk(RBlockFileData* block,size_t pos,const char* buffer,size_t nb)
+{
+	RSmartMutexPtr Latch(&lCache);
+	RIOFile::Seek((block->Id-1)*BlockSize+pos+HeaderSize);
+	RIOFile::Write(buffer,nb);
+}
+
+
+//------------------------------------------------------------------------------
+void RBlockFile::Read(size_t blockid,size_t pos,char* buffer,size_t nb)
+{
+	if(!IsOpen())
+		mThrowRIOException(this,"File not opened");
+	if(!blockid)
+		mThrowRIOException(this,"There is no block with a null identifier");
+	if(pos+nb>BlockSize)
+		mThrowRIOException(this,"Size of a block is limited to "+RString::Number(BlockSize));
+
+	// The current block cannot be replaced
+	RSmartMutexPtr Latch(&lCache);
+	RBlockFileData* ptr(LoadBlock(blockid,Current));
+	memcpy(buffer,&ptr->Data[pos],nb*sizeof(char));
+	ptr->NbAccess++;
+}
+
+
 //------------------------------------------------------------------------------
 void RBlockFile::Read(char* buffer,size_t nb)
 {
@@ -264,11 +784,7 @@ void RBlockFile::Write(const char* buffer,size_t nb)
 		mThrowRIOException(this,"Size of a block is limited to "+RString::Number(BlockSize));
 	memcpy(CurrentData,buffer,nb*sizeof(char));
 	if(Type==WriteThrough)
-	{
-		// Must write it on file too
-		RIOFile::Seek((Current->Id-1)*BlockSize+CurrentPos+HeaderSize);
-		RIOFile::Write(buffer,nb);
-	}
+		WriteOnDisk(Current,CurrentPos,buffer,nb);
 	else
 		Current->Dirty=true;
 	CurrentPos+=nb;
@@ -285,11 +801,7 @@ void RBlockFile::MoveBlock(size_t blockid,size_t start,size_t end,size_t size)
 	Seek(blockid,end+size);
 	memmove(&Current->Data[end],&Current->Data[start],size);
 	if(Type==WriteThrough)
-	{
-		// Must write it on file too
-		RIOFile::Seek((Current->Id-1)*BlockSize+end+HeaderSize);
-		RIOFile::Write(&Current->Data[end],size);
-	}
+		WriteOnDisk(Current,end,&Current->Data[end],size);
 	else
 		Current->Dirty=true;
 }
@@ -325,7 +837,14 @@ void RBlockFile::Seek(size_t blockid,size_t pos)
 	// Select the current block
 	if((!Current)||(Current->Id!=blockid))
 	{
-		Current=LoadBlock(blockid);
+		RSmartMutexPtr Latch(&lCache);
+		Current=LoadBlock(blockid,0);
+
+		// If the blocks are accessed sequentially -> read the next ones in advance
+		if(Async&&ReadAhead&&(blockid==LastId+1))
+			PreFetch(Current);
+		LastId=blockid;
+
 		CurrentPos=pos;
 		CurrentData=&Current->Data[CurrentPos];
 	}
@@ -358,4 +877,5 @@ void RBlockFile::SeekRel(long pos)
 RBlockFile::~RBlockFile(void)
 {
 	Close();
+	delete[] Buckets;
 }
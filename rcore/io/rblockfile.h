@@ -37,6 +37,8 @@
 #include <riofile.h>
 #include <rcontainer.h>
 #include <rblockfiledata.h>
+#include <rmutex.h>
+#include <rconditionvar.h>
 
 
 //------------------------------------------------------------------------------
@@ -44,6 +46,12 @@ namespace R{
 //------------------------------------------------------------------------------
 
 
+//------------------------------------------------------------------------------
+// forward declaration
+class RBlockFileIO;
+class RBlockFileAccess;
+
+
 //------------------------------------------------------------------------------
 /**
 * The RBlockFile class represents a file composed from several blocks of a
@@ -77,6 +85,25 @@ namespace R{
 *	cout<<"Read "<<Buffer<<endl;
 * @endcode
 *
+* The blocks in memory are indexed by a hash table. When a block must be
+* loaded and the cache is full, a block is replaced following a given policy
+* (see CachePolicy): the least recently used block (LRU) or the first block
+* not referenced since the last pass of a clock (CLOCK). In both cases, a
+* block is found and replaced in constant time.
+*
+* Optionally (see SetAsyncIO), a separate thread reads and writes the blocks
+* asynchronously. When the blocks are accessed sequentially, the next blocks are
+* read in advance, and a dirty block that is replaced is written in the
+* background (its data is exchanged with a free buffer so that the block can
+* be reused immediately).
+*
+* The current position of the file (see Seek) is used by one thread. Several
+* threads can read and write the blocks at the same time through their own
+* RBlockFileAccess, or with positioned reads (see Read(size_t,size_t,char*,size_t)).
+* The cache is protected by a latch, and a block used by an access is never
+* replaced (if all the blocks are used, an access waits that another one
+* releases its block). A miss is read while the latch is held.
+*
 * The file has a header of 2 Kb. The first byte indicates the number of bytes to
 * store a size_t type. Then, the next bytes represent a size_t that store the
 * block size. The rest of the bytes are actually unused.
@@ -100,6 +127,17 @@ public:
 		                       directly saved on disk. */
 	};
 
+	/**
+	 * Policy used to replace a block when the cache is full.
+	 */
+	enum CachePolicy
+	{
+		LRU                /** The least recently used block is replaced. */,
+		CLOCK              /** The blocks are scanned circularly and the first
+		                       one not accessed since the previous scan is
+		                       replaced. */
+	};
+
 protected:
 
 	/**
@@ -112,10 +150,60 @@ protected:
 	 */
 	size_t BlockSize;
 
+	/**
+	 * Policy of the cache.
+	 */
+	CachePolicy Policy;
+
 	/**
 	 * Cache managed.
 	 */
-	RContainer<RBlockFileData,true,true> Cache;
+	RContainer<RBlockFileData,true,false> Cache;
+
+	/**
+	 * Buckets of the index of the cache (their number is a power of two).
+	 */
+	RBlockFileData** Buckets;
+
+	/**
+	 * Mask to apply on a block identifier to find its bucket.
+	 */
+	size_t Mask;
+
+	/**
+	 * Block most recently used.
+	 */
+	RBlockFileData* First;
+
+	/**
+	 * Block least recently used.
+	 */
+	RBlockFileData* Last;
+
+	/**
+	 * Position of the clock in the cache.
+	 */
+	size_t Hand;
+
+	/**
+	 * Number of blocks found in the cache.
+	 */
+	size_t NbHits;
+
+	/**
+	 * Number of blocks not found in the cache.
+	 */
+	size_t NbMisses;
+
+	/**
+	 * Number of blocks replaced in the cache.
+	 */
+	size_t NbEvictions;
+
+	/**
+	 * Number of dirty blocks saved on disk.
+	 */
+	size_t NbWriteBacks;
 
 	/**
 	 * Current block.
@@ -137,6 +225,51 @@ protected:
 	 */
 	size_t NbBlocks;
 
+	/**
+	 * Are the blocks read and written asynchronously ?
+	 */
+	bool Async;
+
+	/**
+	 * Number of blocks read in advance.
+	 */
+	size_t ReadAhead;
+
+	/**
+	 * Number of buffers used to write the blocks in the background.
+	 */
+	size_t NbBuffers;
+
+	/**
+	 * Thread doing the asynchronous reads and writes (created when needed).
+	 */
+	RBlockFileIO* IO;
+
+	/**
+	 * Identifier of the last block accessed.
+	 */
+	size_t LastId;
+
+	/**
+	 * Number of blocks read in advance.
+	 */
+	size_t NbPrefetches;
+
+	/**
+	 * Latch protecting the cache.
+	 */
+	RMutex lCache;
+
+	/**
+	 * Condition signaled when a block is released by an access.
+	 */
+	RConditionVar cCache;
+
+	/**
+	 * Number of accesses using a block.
+	 */
+	size_t NbPins;
+
 public:
 
 	/**
@@ -204,21 +337,164 @@ public:
 	 */
 	void Flush(void);
 
+	/**
+	 * Get the policy of the cache.
+	 */
+	CachePolicy GetCachePolicy(void) const {return(Policy);}
+
+	/**
+	 * Set the policy of the cache.
+	 * @param policy         Policy.
+	 */
+	void SetCachePolicy(CachePolicy policy) {Policy=policy;}
+
+	/**
+	 * Get the number of blocks found in the cache.
+	 */
+	size_t GetNbHits(void) const {return(NbHits);}
+
+	/**
+	 * Get the number of blocks not found in the cache.
+	 */
+	size_t GetNbMisses(void) const {return(NbMisses);}
+
+	/**
+	 * Get the number of blocks replaced in the cache.
+	 */
+	size_t GetNbEvictions(void) const {return(NbEvictions);}
+
+	/**
+	 * Get the number of dirty blocks saved on disk.
+	 */
+	size_t GetNbWriteBacks(void) const {return(NbWriteBacks);}
+
+	/**
+	 * Reset the counters of the cache.
+	 */
+	void ResetCounters(void) {NbHits=NbMisses=NbEvictions=NbWriteBacks=NbPrefetches=0;}
+
+	/**
+	 * Set if the blocks are read and written asynchronously by a separate
+	 * thread. The number of blocks read in advance is limited to the half of
+	 * the cache.
+	 * @param async          Asynchronous reads and writes ?
+	 * @param readahead      Number of blocks read in advance when the blocks
+	 *                       are accessed sequentially.
+	 * @param nbbuffers      Number of buffers used to write the dirty blocks in
+	 *                       the background.
+	 */
+	void SetAsyncIO(bool async,size_t readahead=4,size_t nbbuffers=4);
+
+	/**
+	 * Look if the blocks are read and written asynchronously.
+	 */
+	bool IsAsyncIO(void) const {return(Async);}
+
+	/**
+	 * Get the number of blocks read in advance.
+	 */
+	size_t GetNbPrefetches(void) const {return(NbPrefetches);}
+
 private:
 
 	/**
-	 * Method used to ordered the blocks by descending order of accesses.
-	 * @param a              Pointer to a block.
-	 * @param b              Pointer to the second block.
+	 * Make a block the most recently used one.
+	 * @param block          Block.
 	 */
-	static int sortOrderAccess(const void* a,const void* b);
+	void MoveFirst(RBlockFileData* block);
 
 	/**
-	 * Load a given block in to memory.
+	 * Look for a block in the cache.
 	 * @param id             Identifier.
+	 * @return Pointer to the block or null if it is not in memory.
+	 */
+	inline RBlockFileData* FindBlock(size_t id) const
+	{
+		RBlockFileData* ptr(Buckets[id&Mask]);
+		while(ptr&&(ptr->Id!=id))
+			ptr=ptr->Collision;
+		return(ptr);
+	}
+
+	/**
+	 * Select the block to replace. The blocks being read by the I/O thread
+	 * are never selected.
+	 * @param keep           Block that cannot be selected (may be null).
+	 * @return Pointer to the block or null if no block can be replaced.
+	 */
+	RBlockFileData* SelectVictim(RBlockFileData* keep);
+
+	/**
+	 * Get a block that can receive a new identifier: either a new block if
+	 * the cache is not full, or a replaced block (saved if necessary and
+	 * removed from the index).
+	 * @param keep           Block that cannot be replaced (may be null).
+	 * @return Pointer to the block or null if no block can be replaced.
+	 */
+	RBlockFileData* GetFreeBlock(RBlockFileData* keep);
+
+	/**
+	 * Save a dirty block on disk. If the blocks are written asynchronously,
+	 * its data are exchanged with a free buffer and written in the background.
+	 * @param block          Block.
+	 */
+	void SaveBlock(RBlockFileData* block);
+
+	/**
+	 * Read the data of a block from the disk.
+	 * @param block          Block.
+	 */
+	void ReadBlock(RBlockFileData* block);
+
+	/**
+	 * Read in advance the blocks following a given one.
+	 * @param block          Block just loaded (it is not replaced).
+	 */
+	void PreFetch(RBlockFileData* block);
+
+	/**
+	 * Wait that all the asynchronous reads and writes are done, and stop the
+	 * I/O thread.
+	 */
+	void StopIO(void);
+
+	/**
+	 * Load a given block in to memory. The latch of the cache must be locked.
+	 * @param id             Identifier.
+	 * @param keep           Block that cannot be replaced (may be null).
 	 * @return Pointer to the block.
 	 */
-	RBlockFileData* LoadBlock(size_t id);
+	RBlockFileData* LoadBlock(size_t id,RBlockFileData* keep);
+
+	/**
+	 * Make an access use a given block. The block previously used by the
+	 * access is released.
+	 * @param access         Access.
+	 * @param id             Identifier of the block.
+	 */
+	void PinBlock(RBlockFileAccess* access,size_t id);
+
+	/**
+	 * Release the block used by an access.
+	 * @param access         Access.
+	 */
+	void UnPinBlock(RBlockFileAccess* access);
+
+	/**
+	 * Release the block used by an access. The latch of the cache must be
+	 * locked.
+	 * @param access         Access.
+	 */
+	void Release(RBlockFileAccess* access);
+
+	/**
+	 * Write some data of a block used by an access on disk.
+	 * @param block          Block.
+	 * @param pos            Position in the block.
+	 * @param buffer         Buffer.
+	 * @param nb             Number of bytes to write.
+	 */
+	void WriteOnDisk(RBlockFileData* block,size_t pos,const char* buffer,size_t nb);
 
 public:
 
@@ -229,6 +505,17 @@ public:
 	*/
 	void Read(char* buffer,size_t nb);
 
+	/**
+	 * Read a given number of bytes at a given position of a block. The
+	 * current position of the file is not changed, and the method can be
+	 * called by several threads at the same time.
+	 * @param blockid        Identifier of the block.
+	 * @param pos            Position in the block.
+	 * @param buffer         Buffer (must be allocated).
+	 * @param nb             Number of bytes to read.
+	 */
+	void Read(size_t blockid,size_t pos,char* buffer,size_t nb);
+
 	/**
 	* Write a number of bytes of a buffer in the current position of
 	* the file.
@@ -272,6 +559,9 @@ public:
 	* Destruct the file.
 	*/
 	virtual ~RBlockFile(void);
+
+	friend class RBlockFileIO;
+	friend class RBlockFileAccess;
 };
 
 
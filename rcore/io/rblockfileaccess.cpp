@@ -45,7 +45,7 @@ using namespace std;
 
 //------------------------------------------------------------------------------
 RBlockFileAccess::RBlockFileAccess(RBlockFile* file)
-	: File(file), BlockId(0), CurrentPos(cNoRef), CurrentData(0), Lock(false)
+	: File(file), BlockId(0), Block(0), CurrentPos(cNoRef), CurrentData(0), Lock(false)
 {
 	if(!File)
 		mThrowRException("Null file pointer");
@@ -54,26 +54,115 @@ RBlockFileAccess::RBlockFileAccess(RBlockFile* file)
 
 //------------------------------------------------------------------------------
 RBlockFileAccess::RBlockFileAccess(RBlockFile* file,size_t blockid,size_t pos)
-	: File(file), BlockId(0), CurrentPos(cNoRef), CurrentData(0), Lock(false)
+	: File(file), BlockId(0), Block(0), CurrentPos(cNoRef), CurrentData(0), Lock(false)
 {
 	if(!File)
 		mThrowRException("Null file pointer");
-	File->Seek(BlockId,CurrentPos);
+	Seek(blockid,pos);
 }
 
 
 //------------------------------------------------------------------------------
 RBlockFileAccess::RBlockFileAccess(RBlockFile& file)
-	: File(&file), BlockId(0), CurrentPos(cNoRef), CurrentData(0), Lock(false)
+	: File(&file), BlockId(0), Block(0), CurrentPos(cNoRef), CurrentData(0), Lock(false)
 {
 }
 
 
 //------------------------------------------------------------------------------
 RBlockFileAccess::RBlockFileAccess(RBlockFile& file,size_t blockid,size_t pos)
-	: File(&file), BlockId(0), CurrentPos(cNoRef), CurrentData(0), Lock(false)
+	: File(&file), BlockId(0), Block(0), CurrentPos(cNoRef), CurrentData(0), Lock(false)
 {
-	File->Seek(BlockId,CurrentPos);
+	Seek(blockid,pos);
+}
+
+
+//------------------------------------------------------------------------------
+void RBlockFileAccess::Seek(size_t blockid,size_t pos)
+{
+	if(pos>File->BlockSize)
+		mThrowRException("Size of a block is limited to "+RString::Number(File->BlockSize));
+
+	// Select the block (it cannot change while it is locked)
+	if((!Block)||(BlockId!=blockid))
+	{
+		if(Lock)
+			mThrowRException("Block "+RString::Number(BlockId)+" is locked");
+		File->PinBlock(this,blockid);
+		BlockId=blockid;
+	}
+	CurrentPos=pos;
+	CurrentData=&Block->Data[CurrentPos];
+}
+
+
+//------------------------------------------------------------------------------
+void RBlockFileAccess::SeekRel(long pos)
+{
+	if(!Block)
+		mThrowRException("No block selected");
+	if(pos+CurrentPos>File->BlockSize)
+		mThrowRException("Size of a block is limited to "+RString::Number(File->BlockSize));
+	if(static_cast<ssize_t>(CurrentPos)+pos<0)
+		mThrowRException("Relative position outside the block");
+	CurrentPos+=pos;
+	CurrentData+=pos;
+}
+
+
+//------------------------------------------------------------------------------
+void RBlockFileAccess::Read(char* buffer,size_t nb)
+{
+	if(!Block)
+		mThrowRException("No block selected");
+	if(CurrentPos+nb>File->BlockSize)
+		mThrowRException("Size of a block is limited to "+RString::Number(File->BlockSize));
+	memcpy(buffer,CurrentData,nb*sizeof(char));
+	CurrentPos+=nb;
+	CurrentData+=nb;
+}
+
+
+//------------------------------------------------------------------------------
+void RBlockFileAccess::Write(const char* buffer,size_t nb)
+{
+	if(!Block)
+		mThrowRException("No block selected");
+	if(CurrentPos+nb>File->BlockSize)
+		mThrowRException("Size of a block is limited to "+RString::Number(File->BlockSize));
+	memcpy(CurrentData,buffer,nb*sizeof(char));
+	if(File->Type==RBlockFile::WriteThrough)
+		File->WriteOnDisk(Block,CurrentPos,buffer,nb);
+	else
+		Block->Dirty=true;
+	CurrentPos+=nb;
+	CurrentData+=nb;
+}
+
+
+//------------------------------------------------------------------------------
+const char* RBlockFileAccess::GetPtr(size_t size)
+{
+	if(!Block)
+		mThrowRException("No block selected");
+	if(CurrentPos+size>File->BlockSize)
+		mThrowRException("Size of a block is limited to "+RString::Number(File->BlockSize));
+	const char* ptr(CurrentData);
+	CurrentPos+=size;
+	CurrentData+=size;
+	return(ptr);
+}
+
+
+//------------------------------------------------------------------------------
+void RBlockFileAccess::Release(void)
+{
+	if(Lock)
+		mThrowRException("Block "+RString::Number(BlockId)+" is locked");
+	File->UnPinBlock(this);
+	BlockId=0;
+	CurrentPos=cNoRef;
+	CurrentData=0;
 }
 
 
@@ -120,4 +209,5 @@ void RBlockFileAccess::WriteUnLock(void)
 //------------------------------------------------------------------------------
 RBlockFileAccess::~RBlockFileAccess(void)
 {
+	File->UnPinBlock(this);
 }
\ No newline at end of file
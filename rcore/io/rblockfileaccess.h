@@ -50,14 +50,23 @@ class RBlockFile;
 //------------------------------------------------------------------------------
 /**
  * The RBlockFileAccess class provides an access to a given block file to read
- * and write data in a particular bloc.
+ * and write data in a particular bloc. Each access has its own position, so
+ * that several threads can use the same file (and its cache) at the same time:
+ * @code
+ * RBlockFileAccess Access(File);
+ * Access.Seek(blockid,pos);
+ * Access.Read(buffer,size);
+ * @endcode
+ * The block used by an access stays in memory until the access moves to
+ * another block or is released.
  *
  * When it is necessary to ensure the coherence of a serie of reads or writes
  * (for example to store data stored in multiple variables), we must first lock
  * the access in read or write mode. Don't forget to unlock at the end of the
  * reads and writes!
  * @warning While the RBlockFileAccess allows a multithread access to a block
- * file, it is itself not reentrant.
+ * file, it is itself not reentrant. The accesses must be released before the
+ * file is closed.
  * @see RBlockFile
  * @short Block File Access
  */
@@ -124,6 +133,56 @@ public:
 	 */
 	RBlockFileAccess(RBlockFile& file,size_t blockid,size_t pos=0);
 
+	/**
+	 * Get the identifier of the block used (null if no block is used).
+	 */
+	size_t GetBlockId(void) const {return(BlockId);}
+
+	/**
+	 * Get the current position in the block.
+	 */
+	size_t GetPos(void) const {return(CurrentPos);}
+
+	/**
+	 * Go to a specific position of the file.
+	 * @param blockid        Identifier of the block.
+	 * @param pos            Position to reach in the block.
+	 */
+	void Seek(size_t blockid,size_t pos);
+
+	/**
+	 * Go to a specific position in the current block.
+	 * @param pos            Relative position to reach in the block.
+	 */
+	void SeekRel(long pos);
+
+	/**
+	 * Read a given number of bytes at the current position.
+	 * @param buffer         Buffer (must be allocated).
+	 * @param nb             Number of bytes to read.
+	 */
+	void Read(char* buffer,size_t nb);
+
+	/**
+	 * Write a number of bytes of a buffer at the current position.
+	 * @param buffer         Buffer.
+	 * @param nb             Number of bytes to write.
+	 */
+	void Write(const char* buffer,size_t nb);
+
+	/**
+	 * Get a pointer to the memory at the current position. The position is
+	 * moved.
+	 * @param size           Number of bytes to manipulate from that position.
+	 */
+	const char* GetPtr(size_t size);
+
+	/**
+	 * Release the block used by the access. It can then be replaced in the
+	 * cache.
+	 */
+	void Release(void);
+
 	/**
 	* Read locking.
 	*/
@@ -44,7 +44,8 @@ using namespace std;
 
 //------------------------------------------------------------------------------
 RBlockFileData::RBlockFileData(size_t id,size_t size)
-	: Id(id), NbAccess(0), Dirty(false), Data(0), Access(10)
+	: Id(id), NbAccess(0), Dirty(false), Referenced(false), Loading(false), Failed(false),
+	  Prev(0), Next(0), Collision(0), Data(0), Access(10)
 {
 	Data=new char[size];
 	memset(Data,0,sizeof(char)*size);
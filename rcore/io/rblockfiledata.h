@@ -72,6 +72,37 @@ class RBlockFileData
 	 */
 	bool Dirty;
 
+	/**
+	 * Was the block accessed since the last pass of the clock (see
+	 * RBlockFile::CLOCK) ?
+	 */
+	bool Referenced;
+
+	/**
+	 * Is the block being read by the I/O thread of the file ?
+	 */
+	bool Loading;
+
+	/**
+	 * Did the last read of the block by the I/O thread fail ?
+	 */
+	bool Failed;
+
+	/**
+	 * Block used more recently.
+	 */
+	RBlockFileData* Prev;
+
+	/**
+	 * Block used less recently.
+	 */
+	RBlockFileData* Next;
+
+	/**
+	 * Next block in the same bucket of the index of the cache.
+	 */
+	RBlockFileData* Collision;
+
 	/**
 	 * Data contained in the block.
 	 */
@@ -121,6 +152,7 @@ public:
 
 	friend class RBlockFile;
 	friend class RBlockFileAccess;
+	friend class RBlockFileIO;
 };
 
 
@@ -78,8 +78,25 @@ public:
 		                                 the file doesn't exist, it is created.*/,
 		Create                       /** Create a new file. If the file already
 		                                 exists, it is destruct.*/,
+		ReadMapped                   /** Open a file to read it through a
+		                                 read-only memory mapping.*/,
 		Undefined                    /** The mode of the file is undefined.*/
 	};
+
+	/**
+	* The AccessType enum represents the way a file will be accessed. It is
+	* given as a hint to the operating system.
+	* @short File Access Pattern
+	*/
+	enum AccessType
+	{
+		Normal                       /** No particular access pattern.*/,
+		Sequential                   /** The file is read from the beginning
+		                                 to the end.*/,
+		Random                       /** The file is accessed at random
+		                                 positions.*/,
+		WillNeed                     /** The whole file will be needed soon.*/
+	};
 };
 
 
@@ -40,6 +40,9 @@
 	#include <io.h>
 #endif
 #include <fcntl.h>
+#if !defined(WIN32)
+	#include <sys/mman.h>
+#endif
 #include <string.h>
 #include <time.h>
 #include <errno.h>
@@ -56,6 +59,7 @@ using namespace std;
 //------------------------------------------------------------------------------
 // Global constants
 static const off_t InternalBufferSize=10240;
+static const size_t DefaultWriteBufferSize=65536;
 
 
 
@@ -69,32 +73,26 @@ static const off_t InternalBufferSize=10240;
 RDownloadFile RIOFile::Get;
 
 
-//------------------------------------------------------------------------------
-inline void RIOFile::Test(void)
-{
-	off_t real=lseek(Handle,0,SEEK_CUR);
-	if(real!=RealPos)
-		cout<<"Internal problem"<<endl;
-}
-
-
 //------------------------------------------------------------------------------
 RIOFile::RIOFile(void)
-  : RFile(), Handle(-1), Size(0), Pos(0), Internal(0), InternalToRead(0), RealPos(0), CurByte(0)
+  : RFile(), Handle(-1), Size(0), Pos(0), Internal(0), Mapped(0), InternalNb(0), RealInternalPos(MaxOffT),
+    WriteBuffer(0), WriteBufferSize(DefaultWriteBufferSize), WritePos(0), WriteNb(0)
 {
 }
 
 
 //------------------------------------------------------------------------------
 RIOFile::RIOFile(const RURI& uri)
-  : RFile(uri), Handle(-1), Size(0), Pos(0), Internal(0), InternalToRead(0), RealPos(0), CurByte(0)
+  : RFile(uri), Handle(-1), Size(0), Pos(0), Internal(0), Mapped(0), InternalNb(0), RealInternalPos(MaxOffT),
+    WriteBuffer(0), WriteBufferSize(DefaultWriteBufferSize), WritePos(0), WriteNb(0)
 {
 }
 
 
 //------------------------------------------------------------------------------
 RIOFile::RIOFile(RIOFile& file)
-	: RFile(file), Handle(-1), Size(0), Pos(0), Internal(0), InternalToRead(0), RealPos(0), CurByte(0)
+	: RFile(file), Handle(-1), Size(0), Pos(0), Internal(0), Mapped(0), InternalNb(0), RealInternalPos(MaxOffT),
+	  WriteBuffer(0), WriteBufferSize(DefaultWriteBufferSize), WritePos(0), WriteNb(0)
 {
 }
 
@@ -128,6 +126,7 @@ void RIOFile::Open(RIO::ModeType mode)
 	switch(Mode)
 	{
 		case RIO::Read:
+		case RIO::ReadMapped:
 			localmode=O_RDONLY;
 			CanWrite=false;
 			CanRead=true;
@@ -169,10 +168,6 @@ void RIOFile::Open(RIO::ModeType mode)
 			mThrowRIOException(this,"No valid mode");
 	};
 
-	// If reading is possible -> create an internal buffer
-	if(CanRead&&(!Internal))
-		Internal=new char[InternalBufferSize];
-
 	// If not local -> Download it
 	if(!local)
 		Get.Download(URI,File);
@@ -183,7 +178,7 @@ void RIOFile::Open(RIO::ModeType mode)
 	#endif
 
 	// Open the file
-	if(Mode==RIO::Read)
+	if((Mode==RIO::Read)||(Mode==RIO::ReadMapped))
 	{
 		Handle=open(File.GetPath().ToLatin1(),localmode);
 	}
@@ -224,12 +219,28 @@ void RIOFile::Open(RIO::ModeType mode)
 	fstat(Handle,&statbuf);
 	Size=statbuf.st_size;
 
+	// Map the file in memory if asked (if it fails, the internal buffer is used)
+	#if !defined(WIN32)
+		if((Mode==RIO::ReadMapped)&&Size)
+		{
+			void* Map(mmap(0,Size,PROT_READ,MAP_PRIVATE,Handle,0));
+			if(Map!=MAP_FAILED)
+				Mapped=static_cast<char*>(Map);
+		}
+	#endif
+
+	// If reading is possible through the internal buffer -> create it
+	if(CanRead&&(!Mapped)&&(!Internal))
+		Internal=new char[InternalBufferSize];
+
 	// Position virtually the file at the beginning or at the end if it is open in append mode
 	if(Mode==RIO::Append)
 		Pos=Size;
 
-	// Suppose nothing is in the buffer
+	// Suppose nothing is in the buffers
+	InternalNb=0;
 	RealInternalPos=MaxOffT;
+	WriteNb=0;
 }
 
 
@@ -250,15 +261,38 @@ bool RIOFile::IsOpen(void) const
 //------------------------------------------------------------------------------
 void RIOFile::Close(void)
 {
+	// Write the bytes not yet on the disk. If it fails, the file is closed
+	// anyway and the error is reported.
+	if(WriteNb&&(Handle!=-1))
+	{
+		try
+		{
+			Flush();
+		}
+		catch(...)
+		{
+			WriteNb=0;
+			RIOFile::Close();
+			throw;
+		}
+	}
+	WriteNb=0;
+
 	// If non-local file -> remove the temporary file
 	#if defined(_BSD_SOURCE) || (defined(__GNUC__) && !defined(__MINGW32__)) || defined(__APPLE__)
 		if(URI.GetScheme()!="file")
 				RFile::RemoveFile(File);
 	#endif
 	File=RString::Null;
-	RealPos=InternalToRead=Pos=Size=0;
+	#if !defined(WIN32)
+		if(Mapped)
+			munmap(Mapped,Size);
+	#endif
+	Mapped=0;
+	InternalNb=0;
+	RealInternalPos=MaxOffT;
+	Pos=Size=0;
 	Mode=RIO::Undefined;
-	CurByte=0;
 
 	if(Handle!=-1)
 	{
@@ -292,97 +326,136 @@ size_t RIOFile::Read(char* buffer,size_t nb,bool move)
 		mThrowRIOException(this,"Can't read in the file");
 	if(!CanRead)
 		mThrowRIOException(this,"No Read access");
-	if(End())
+	if(RIOFile::End())
 		mThrowRIOException(this,"End of the file reached");
 
 	// Compute the real number of bytes to read
 	if(static_cast<off_t>(nb)>Size-Pos)
 		nb=Size-Pos;
-	off_t left(nb);
 
-	// If the number of bytes to read is greater than the size of the internal buffer -> read it directly
-	if(static_cast<off_t>(nb)>InternalBufferSize)
+	// If the file is mapped -> copy the bytes
+	if(Mapped)
 	{
-		off_t total;
-
-		lseek(Handle,Pos,SEEK_SET);
-		total=read(Handle,buffer,left);
-		left=0;
+		memcpy(buffer,&Mapped[Pos],nb);
 		if(move)
-		{
-			Pos+=total;
-			RealPos+=total;
-		}
-		else
-			lseek(Handle,-total,SEEK_CUR);
+			Pos+=nb;
+		return(nb);
 	}
 
 	// While there are some bytes left to read
+	off_t Cur(Pos);
+	size_t left(nb);
 	while(left)
 	{
 		// Verify if something can be read from the internal buffer
-		if((Pos>=RealInternalPos)&&(Pos<RealInternalPos+static_cast<off_t>(InternalBufferSize)))
+		if((Cur>=RealInternalPos)&&(Cur<RealInternalPos+static_cast<off_t>(InternalNb)))
 		{
-			// Verify if everything can be get from the internal buffer
-			if(left>static_cast<off_t>(InternalToRead))
-			{
-				memcpy(buffer,CurByte,InternalToRead);
-				left-=static_cast<off_t>(InternalToRead);
-				buffer+=InternalToRead;
-				if(move)
-				{
-					Pos+=InternalToRead;
-					InternalToRead=0;
-					RealInternalPos=MaxOffT;
-				}
-			}
-			else
-			{
-				memcpy(buffer,CurByte,left);
-				if(move)
-				{
-					Pos+=left;
-					InternalToRead-=left;
-					CurByte+=left;
-				}
-				left=0;
-			}
+			size_t len(static_cast<size_t>(RealInternalPos+static_cast<off_t>(InternalNb)-Cur));
+			if(len>left)
+				len=left;
+			memcpy(buffer,&Internal[Cur-RealInternalPos],len);
+			buffer+=len;
+			left-=len;
+			Cur+=len;
+			continue;
 		}
 
-		// If there are some byte left to read -> fill the internal buffer
-		if(left)
+		// The disk must be read -> it must contain the bytes written
+		if(WriteNb)
+			Flush();
+
+		// If the number of bytes left is greater than the size of the internal buffer -> read it directly
+		if(static_cast<off_t>(left)>InternalBufferSize)
 		{
-			// Suppose that the whole buffer must be filled
-			off_t ToRead(InternalBufferSize);
-			size_t InternalPos(0);
+			ReadBytes(buffer,left,Cur);
+			Cur+=left;
+			left=0;
+			break;
+		}
+
+		// Fill the internal buffer
+		RealInternalPos=Cur;
+		InternalNb=ReadBytes(Internal,InternalBufferSize,Cur);
+	}
+
+	// Next position
+	if(move)
+		Pos=Cur;
 
-			// Verify if there still bytes to read in the internal buffer
-			if(InternalToRead)
+	// Return the number of byte read
+	return(nb);
+}
+
+
+//------------------------------------------------------------------------------
+const char* RIOFile::ReadSpan(size_t& nb,bool move)
+{
+	// Verify all internal conditions
+	if(Handle==-1)
+		mThrowRIOException(this,"Can't read in the file");
+	if(!Mapped)
+		mThrowRIOException(this,"File is not mapped in memory");
+	if(RIOFile::End())
+		mThrowRIOException(this,"End of the file reached");
+
+	// Compute the real number of bytes available
+	if(static_cast<off_t>(nb)>Size-Pos)
+		nb=Size-Pos;
+	const char* Bytes(&Mapped[Pos]);
+	if(move)
+		Pos+=nb;
+	return(Bytes);
+}
+
+
+//------------------------------------------------------------------------------
+void RIOFile::SetAccess(RIO::AccessType access)
+{
+	// Verify all internal conditions
+	if(Handle==-1)
+		mThrowRIOException(this,"Can't set the access of the file");
+
+	#if !defined(WIN32)
+		int Advice;
+		if(Mapped)
+		{
+			switch(access)
 			{
-				// Save the byte to the beginning of the internal buffer and modify the number of bytes to read
-				ToRead=InternalBufferSize-InternalToRead;
-				memmove(Internal,&Internal[ToRead],InternalToRead);
-				InternalPos=InternalToRead;
+				case RIO::Sequential:
+					Advice=MADV_SEQUENTIAL;
+					break;
+				case RIO::Random:
+					Advice=MADV_RANDOM;
+					break;
+				case RIO::WillNeed:
+					Advice=MADV_WILLNEED;
+					break;
+				default:
+					Advice=MADV_NORMAL;
 			}
-
-			// Verify that there are enough bytes to read left in the file
-			if(Size-RealPos<ToRead)
+			madvise(Mapped,Size,Advice);
+		}
+		else
+		{
+		#if defined(POSIX_FADV_NORMAL)
+			switch(access)
 			{
-				ToRead=Size-RealPos;
-				InternalToRead+=ToRead;
+				case RIO::Sequential:
+					Advice=POSIX_FADV_SEQUENTIAL;
+					break;
+				case RIO::Random:
+					Advice=POSIX_FADV_RANDOM;
+					break;
+				case RIO::WillNeed:
+					Advice=POSIX_FADV_WILLNEED;
+					break;
+				default:
+					Advice=POSIX_FADV_NORMAL;
 			}
-			else
-				InternalToRead=InternalBufferSize;
-
-			// Read the bytes from the file and synchronize the different positions
-			RealInternalPos=RealPos-InternalPos;                 // RealInternalPos is now at RealPos eventually decreases from the number of bytes saved
-			RealPos+=read(Handle,&Internal[InternalPos],ToRead); // RealPos is just incremented by the number of bytes read
-			CurByte=Internal;
+			posix_fadvise(Handle,0,0,Advice);
+		#endif
 		}
-	}
-
-	// Return the number of byte read
-	return(nb);
+	#endif
 }
 
 
@@ -394,75 +467,119 @@ void RIOFile::Write(const char* buffer,size_t nb)
 		mThrowRIOException(this,"Can't write into the file");
 	if(!CanWrite)
 		mThrowRIOException(this,"No write access");
+	if(!nb)
+		return;
+	off_t after=Pos+nb;
 
-	// Verify that the internal positions are OK
-	if(Pos!=RealPos)
+	// If the bytes written are in the internal buffer -> update it
+	if(InternalNb&&(Pos<RealInternalPos+static_cast<off_t>(InternalNb))&&(after>RealInternalPos))
 	{
-		RealPos=Pos;
-		lseek(Handle,Pos,SEEK_SET);
+		off_t Begin(Pos>RealInternalPos?Pos:RealInternalPos);
+		off_t End(after<RealInternalPos+static_cast<off_t>(InternalNb)?after:RealInternalPos+static_cast<off_t>(InternalNb));
+		memcpy(&Internal[Begin-RealInternalPos],&buffer[Begin-Pos],End-Begin);
 	}
 
-	// Write into the file
-	off_t after=Pos+nb;
-	const char* ptr=buffer;
-	for(ssize_t towrite=nb;towrite;)
+	// If the bytes are not contiguous to the write buffer or if they cannot be added -> flush it
+	if(WriteNb&&((Pos!=WritePos+static_cast<off_t>(WriteNb))||(WriteNb+nb>WriteBufferSize)))
+		Flush();
+
+	if(nb<=WriteBufferSize)
 	{
-		ssize_t written(write(Handle,ptr,towrite));
-		towrite-=written;
-		if(towrite)
-			ptr=&buffer[written];
+		// Add the bytes to the write buffer
+		if(!WriteBuffer)
+			WriteBuffer=new char[WriteBufferSize];
+		if(!WriteNb)
+			WritePos=Pos;
+		memcpy(&WriteBuffer[WriteNb],buffer,nb);
+		WriteNb+=nb;
 	}
+	else
+		WriteBytes(buffer,nb,Pos);
+
+	// Increase the size only if the current position is at the end
+	if(after>=Size)
+		Size=after;
+
+	// Next position
+	Pos=after;
+}
+
+
+//------------------------------------------------------------------------------
+void RIOFile::Flush(void)
+{
+	if(!WriteNb)
+		return;
+	if(Handle==-1)
+		mThrowRIOException(this,"Can't write into the file");
+	// The buffer is only emptied once it is written
+	WriteBytes(WriteBuffer,WriteNb,WritePos);
+	WriteNb=0;
+}
 
-	#if (defined WIN32)
-		_flushall();
-	#endif
 
-	// Verify if a part of the buffer must be stored into the internal buffer
-	if(CanRead&&(Pos<RealInternalPos+static_cast<off_t>(InternalBufferSize))&&(after>=RealInternalPos))
+//------------------------------------------------------------------------------
+void RIOFile::SetWriteBufferSize(size_t size)
+{
+	if(size==WriteBufferSize)
+		return;
+	if(WriteNb)
+		Flush();
+	delete[] WriteBuffer;
+	WriteBuffer=0;
+	WriteBufferSize=size;
+}
+
+
+//------------------------------------------------------------------------------
+size_t RIOFile::ReadBytes(char* buffer,size_t nb,off_t pos)
+{
+	size_t total(0);
+	while(total<nb)
 	{
-		// If after the write, we are still in the internal buffer -> update it
-    	// Else dirtied it.
-		if(after<RealInternalPos+static_cast<off_t>(InternalBufferSize))
+		ssize_t nbread(pread(Handle,&buffer[total],nb-total,pos+total));
+		if(nbread==-1)
 		{
-			char* begini;
-			const char* beginb;
-			size_t len(nb);
-			if(Pos<RealInternalPos)
-			{
-				begini=Internal;
-				beginb=&buffer[RealInternalPos-Pos];
-				len-=RealInternalPos-Pos;
-				if(static_cast<off_t>(len)>InternalBufferSize)
-					len=InternalBufferSize;
-			}
-			else
-			{
-				beginb=buffer;
-				begini=&Internal[Pos-RealInternalPos];
-				size_t max=InternalBufferSize+RealInternalPos-Pos;
-				if(len>max)
-					len=max;
-			}
-			memcpy(begini,beginb,len);
-
-			size_t pos=static_cast<size_t>(after-RealInternalPos);
-			CurByte=&Internal[pos];
-			InternalToRead=InternalBufferSize-pos-1;
+			if(errno==EINTR)
+				continue;
+			mThrowRIOException(this,"Cannot read the file");
 		}
+		if(!nbread)
+			break;
+		total+=nbread;
+	}
+	if(!total)
+		mThrowRIOException(this,"End of the file reached");
+	return(total);
+}
+
+
+//------------------------------------------------------------------------------
+void RIOFile::WriteBytes(const char* buffer,size_t nb,off_t pos)
+{
+	while(nb)
+	{
+		ssize_t written;
+		if(Mode==RIO::Append)
+			written=write(Handle,buffer,nb);
 		else
+			written=pwrite(Handle,buffer,nb,pos);
+		if(written==-1)
 		{
-			RealInternalPos=MaxOffT;
-			InternalToRead=0;
+			if(errno==EINTR)
+				continue;
+			if(errno==ENOSPC)
+				mThrowRIOException(this,"No disk space left");
+			mThrowRIOException(this,"Cannot write into the file");
 		}
+		nb-=written;
+		buffer+=written;
+		pos+=written;
 	}
 
-	// Increase the size only if the current position is at the end
-	if(after>=Size)
-		Size=after;
-
-	// Next position
-	Pos=after;
-	RealPos=after;
+	#if (defined WIN32)
+		_flushall();
+	#endif
 }
 
 
@@ -477,23 +594,6 @@ void RIOFile::Seek(off_t pos)
 
 	// Update current position
 	Pos=pos;
-
-	// Look if outside the internal buffer
-	if((Pos<RealInternalPos)||(Pos>RealInternalPos+static_cast<off_t>(InternalBufferSize)))
-	{
-		// Seek the file
-		RealPos=Pos;
-		lseek(Handle,RealPos,SEEK_SET);
-
-		// Dirty the internal buffer
-		InternalToRead=0;
-		RealInternalPos=MaxOffT;
-	}
-	else
-	{
-		CurByte=&Internal[Pos-RealInternalPos];
-		InternalToRead=InternalBufferSize+RealInternalPos-Pos;
-	}
 }
 
 
@@ -510,23 +610,6 @@ void RIOFile::SeekRel(off_t rel)
 
 	// Update current position
 	Pos+=rel;
-
-	// Look if outside the internal buffer
-	if((Pos<RealInternalPos)||(Pos>RealInternalPos+static_cast<off_t>(InternalBufferSize)))
-	{
-		// Seek the file
-		RealPos=Pos;
-		lseek(Handle,Pos,SEEK_SET);
-
-		// Dirty the internal buffer
-		InternalToRead=0;
-		RealInternalPos=MaxOffT;
-	}
-	else
-	{
-		CurByte+=rel;
-		InternalToRead-=rel;
-	}
 }
 
 
@@ -548,6 +631,8 @@ void RIOFile::Truncate(off_t newsize)
 		mThrowRIOException(this,"Can't truncate the file");
 	if(!CanWrite)
 		mThrowRIOException(this,"No write access");
+	if(WriteNb)
+		Flush();
 
 	if(ftruncate(Handle,newsize)==-1)
 	{
@@ -569,17 +654,29 @@ void RIOFile::Truncate(off_t newsize)
 	}
 
 	Size=newsize;
-	if(RealPos>=Size)
+	if(RealInternalPos+static_cast<off_t>(InternalNb)>Size)
+	{
+		InternalNb=0;
+		RealInternalPos=MaxOffT;
+	}
+	if(Pos>Size)
 		Seek(Size);
-	else
-		Seek(RealPos);
 }
 
 
 //------------------------------------------------------------------------------
 RIOFile::~RIOFile(void)
 {
-	Close();
+	// A destructor cannot throw: Close must be called to know if the bytes
+	// were written
+	try
+	{
+		Close();
+	}
+	catch(...)
+	{
+	}
 	if(Internal)
 		delete[] Internal;
+	delete[] WriteBuffer;
 }
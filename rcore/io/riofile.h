@@ -80,8 +80,27 @@ const off_t MaxOffT=MAX_INT_VAL(off_t);
 * @endcode
 * \note
 * When the file is read, an internal buffer is used to avoid to many accesses to
-* the disk. When something must be written, it is first physically written on
-* the disk and, if the file can also be read, the internal buffer is updated.
+* the disk. When something must be written, it is first stored in a write
+* buffer (64 Kb by default, see SetWriteBufferSize) where consecutive writes are
+* coalesced. The write buffer is physically written on the disk when a write
+* is not contiguous to it, when it is full, before the disk is read, when the
+* file is closed or when Flush is called. If the file can also be read, the
+* internal buffer is updated by each write. Since the destructor ignores the
+* errors, Close should be called explicitly to know if all the bytes were
+* written.
+*
+* When the file is opened with the RIO::ReadMapped mode, it is mapped in memory
+* (if the system supports it) and no internal buffer is used: Read becomes a
+* simple copy and Seek only changes the current position. The ReadSpan method
+* gives a direct access to the bytes of the file without copying them:
+* @code
+* RIOFile In("/home/user/Data.bin");
+* In.Open(RIO::ReadMapped);
+* In.SetAccess(RIO::Random);
+* In.Seek(1024);
+* size_t len(512);
+* const char* Bytes(In.ReadSpan(len));
+* @endcode
 * @short Generic File for Input/Output.
 */
 class RIOFile : public RFile
@@ -117,14 +136,14 @@ class RIOFile : public RFile
 	char* Internal;
 
 	/**
-	 * Number of bytes left to read in the internal buffer.
+	 * Memory mapping of the file (only in RIO::ReadMapped mode).
 	 */
-	size_t InternalToRead;
+	char* Mapped;
 
 	/**
-	 * Physical (real) position in the file.
+	 * Number of bytes of the file stored in the internal buffer.
 	 */
-	off_t RealPos;
+	size_t InternalNb;
 
 	/**
 	 * Physical (real) position of the first byte of the internal buffer.
@@ -132,14 +151,24 @@ class RIOFile : public RFile
 	off_t RealInternalPos;
 
 	/**
-	 * Current byte to read.
+	 * Buffer of the bytes written but not yet on the disk.
+	 */
+	char* WriteBuffer;
+
+	/**
+	 * Size of the write buffer.
+	 */
+	size_t WriteBufferSize;
+
+	/**
+	 * Physical (real) position of the first byte of the write buffer.
 	 */
-	char* CurByte;
+	off_t WritePos;
 
-	/*
-	 * Internal test method.
+	/**
+	 * Number of bytes in the write buffer.
 	 */
-	inline void Test(void);
+	size_t WriteNb;
 
 protected:
 
@@ -153,6 +182,25 @@ protected:
 	*/
 	bool CanRead;
 
+	/**
+	 * Physically read some bytes from the disk. The internal buffers are not
+	 * used, and the method can be called by several threads at the same time.
+	 * @param buffer         Buffer.
+	 * @param nb             Number of bytes to read.
+	 * @param pos            Position in the file.
+	 * @return Number of bytes read.
+	 */
+	size_t ReadBytes(char* buffer,size_t nb,off_t pos);
+
+	/**
+	 * Physically write some bytes on the disk. The internal buffers are not
+	 * used, and the method can be called by several threads at the same time.
+	 * @param buffer         Buffer.
+	 * @param nb             Number of bytes to write.
+	 * @param pos            Position in the file.
+	 */
+	void WriteBytes(const char* buffer,size_t nb,off_t pos);
+
 public:
 
 	/**
@@ -199,7 +247,8 @@ public:
 	bool IsOpen(void) const;
 
 	/**
-	* Close the file.
+	* Close the file. The file is closed even if the bytes of the write buffer
+	* cannot be written, but an exception is then thrown.
 	*/
 	virtual void Close(void);
 
@@ -212,6 +261,30 @@ public:
 	*/
 	size_t Read(char* buffer,size_t nb,bool move=true);
 
+	/**
+	* Get a pointer to a given number of bytes at the current position of the
+	* file without copying them. The file must be mapped in memory (see
+	* IsMapped). The pointer stays valid until the file is closed.
+	* @param nb             Number of bytes to read. It is set to the number of
+	*                       bytes really available.
+	* @param move           The file position is moved (default).
+	* @return Pointer to the bytes.
+	*/
+	const char* ReadSpan(size_t& nb,bool move=true);
+
+	/**
+	* Verify if the file is mapped in memory. It is the case if it was opened
+	* with the RIO::ReadMapped mode, is not empty and if the mapping succeeds
+	* (otherwise the file is read through the internal buffer).
+	*/
+	inline bool IsMapped(void) const {return(Mapped!=0);}
+
+	/**
+	* Give a hint to the operating system on how the file will be accessed.
+	* @param access         Access pattern.
+	*/
+	void SetAccess(RIO::AccessType access);
+
 	/**
 	* Write the first number of bytes of a buffer in the current position of
 	* the file.
@@ -220,6 +293,25 @@ public:
 	*/
 	void Write(const char* buffer,size_t nb);
 
+	/**
+	* Physically write on the disk the bytes stored in the write buffer. If it
+	* fails, the bytes stay in the write buffer.
+	*/
+	void Flush(void);
+
+	/**
+	* Set the size of the write buffer. The bytes already stored in it are
+	* written on the disk.
+	* @param size           Size (in bytes). If null, each write is physically
+	*                       done on the disk.
+	*/
+	void SetWriteBufferSize(size_t size);
+
+	/**
+	* Get the size of the write buffer.
+	*/
+	size_t GetWriteBufferSize(void) const {return(WriteBufferSize);}
+
 	/**
 	* Go to a specific position of the file.
 	* @param pos            Position to reach.
@@ -246,7 +338,7 @@ public:
 	/**
 	* Return true if the file is at the end.
 	*/
-	inline bool End(void) const {return(Pos>=Size);}
+	virtual bool End(void) const {return(Pos>=Size);}
 
 	/**
 	* Return the size of the file.
@@ -256,7 +348,7 @@ public:
 	/**
 	* Return the current position in the file.
 	*/
-	inline off_t GetPos(void) const {return(Pos);}
+	virtual off_t GetPos(void) const {return(Pos);}
 
 	/**
 	* Destruct the file.
@@ -112,6 +112,15 @@ public:
 		file.Write((char*)(&Id),sizeof(size_t));
 	}
 
+	/**
+	 * Copy the bytes of the key as written in a key-value file.
+	 * @param data           Buffer (of GetSize() bytes at least).
+	 */
+	inline void GetRaw(char* data) const
+	{
+		memcpy(data,&Id,sizeof(size_t));
+	}
+
 	/**
 	 * Get a string version of a key.
 	 * @return a RString.
@@ -216,6 +225,16 @@ public:
 		file.Write((char*)(&Id2),sizeof(size_t));
 	}
 
+	/**
+	 * Copy the bytes of the key as written in a key-value file.
+	 * @param data           Buffer (of GetSize() bytes at least).
+	 */
+	inline void GetRaw(char* data) const
+	{
+		memcpy(data,&Id1,sizeof(size_t));
+		memcpy(data+sizeof(size_t),&Id2,sizeof(size_t));
+	}
+
 	/**
 	 * Get a string version of a key.
 	 * @return a RString.
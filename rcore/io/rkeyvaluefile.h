@@ -35,6 +35,7 @@
 //------------------------------------------------------------------------------
 // include files for R Project
 #include <rblockfile.h>
+#include <rblockfileaccess.h>
 #include <rnumcontainer.h>
 #include <rcursor.h>
 #include <rnumcursor.h>
@@ -87,6 +88,7 @@ namespace R{
 *   int Compare(const char* data) const;           // Compare method.
 *   void Read(R::RKeyValueFile<cKey>& file);       // Read the key from the current position.
 *   void Write(R::RKeyValueFile<cKey>& file);      // Write the key to the current position.
+*   void GetRaw(char* data) const;                 // Copy the bytes written by Write (GetSize() bytes).
 *   R::RString GetKey(void) const;                 // Build a string representing the key.
 *   cKey& operator=(const cKey &src)               // Assignment operator.
 * };
@@ -170,8 +172,66 @@ template<class K>
 {
 public:
 
+	/**
+	 * Record moved to another block by a compaction (see Compact).
+	 */
+	class Relocation
+	{
+	public:
+		/**
+		 * Key of the record.
+		 */
+		K Key;
+
+		/**
+		 * Block containing the record before the compaction.
+		 */
+		size_t OldBlockId;
+
+		/**
+		 * Block containing the record after the compaction.
+		 */
+		size_t NewBlockId;
+
+		/**
+		 * Construct a relocation.
+		 * @param key         Key.
+		 * @param oldid       Old identifier of the block.
+		 * @param newid       New identifier of the block.
+		 */
+		Relocation(const K& key,size_t oldid,size_t newid) : Key(key), OldBlockId(oldid), NewBlockId(newid) {}
+
+		/**
+		 * Compare two relocations based on the old identifiers of the blocks.
+		 * @param rel         Relocation to compare with.
+		 */
+		int Compare(const Relocation& rel) const {return(CompareIds(OldBlockId,rel.OldBlockId));}
+	};
+
 	using RBlockFile::GetURI;
 
+private:
+
+	/**
+	 * Cursor on the address table of a block during a compaction (the entries
+	 * of a table are ordered by keys).
+	 */
+	class BlockCursor
+	{
+	public:
+		K Key;                 // Current key.
+		char* RawKey;          // Current key as stored in the address table.
+		size_t BlockId;        // Identifier of the block.
+		size_t NbRecs;         // Number of records in the block.
+		size_t Entry;          // Current entry.
+		size_t Pos;            // Position of the current record in the block.
+		size_t Size;           // Size of the current record.
+
+		BlockCursor(size_t keysize,size_t blockid,size_t nbrecs)
+			: Key(), RawKey(new char[keysize]), BlockId(blockid), NbRecs(nbrecs), Entry(0), Pos(0), Size(0) {}
+		~BlockCursor(void) {delete[] RawKey;}
+	};
+
 protected:
 
 	/**
@@ -190,6 +250,18 @@ protected:
 	 */
 	RNumContainer<size_t,false> FreeSpaces;
 
+	/**
+	 * Tree of the maximal free spaces (greater than the tolerance) of the
+	 * blocks. The node i has the children 2i and 2i+1, and the leaves
+	 * correspond to the blocks.
+	 */
+	size_t* FreeTree;
+
+	/**
+	 * Number of leaves of the tree (a power of two).
+	 */
+	size_t NbLeaves;
+
 	/**
 	 * Tolerance.
 	 */
@@ -200,6 +272,42 @@ protected:
 	 */
 	size_t NbRecs;
 
+	/**
+	 * Number of hash functions of the Bloom filters.
+	 */
+	static const size_t NbHashes=4;
+
+	/**
+	 * Size of a key.
+	 */
+	size_t KeySize;
+
+	/**
+	 * Size (in bytes) of the Bloom filter of each block. If null, the blocks
+	 * are not indexed.
+	 */
+	size_t FilterSize;
+
+	/**
+	 * First and last keys of each block indexed.
+	 */
+	char* Fences;
+
+	/**
+	 * Bloom filters of the blocks indexed.
+	 */
+	char* Filters;
+
+	/**
+	 * Number of blocks indexed.
+	 */
+	size_t NbIndexed;
+
+	/**
+	 * Maximal number of blocks that can be indexed without reallocating.
+	 */
+	size_t MaxIndexed;
+
 public:
 
 	/**
@@ -242,6 +350,28 @@ public:
 	 */
 	size_t GetNbBlocks(void) const {return(NbBlocks);}
 
+	/**
+	 * Get the fragmentation of the file, i.e. the ratio of the free spaces of
+	 * the blocks on the size of the blocks.
+	 */
+	double GetFragmentation(void) const;
+
+	/**
+	 * Compact the file. All the records are rewritten in the order of their
+	 * keys in a new file where the blocks are filled as much as possible (the
+	 * tolerance is ignored). Since the address table of each block is ordered,
+	 * the blocks are merged and only their current keys are in memory. The
+	 * new file is then renamed over the current one, which is opened again in
+	 * the same mode and with its tolerance. If an error occurs, the new file
+	 * is removed and the current one is unchanged.
+	 *
+	 * Since the records can change of block, the identifiers of the blocks
+	 * stored elsewhere must be updated.
+	 * @param moves          Container that will hold the records that have
+	 *                       changed of block.
+	 */
+	void Compact(RContainer<Relocation,true,false>& moves);
+
 	/**
 	 * Get the type of the cache.
 	 */
@@ -260,8 +390,63 @@ public:
 	 */
 	void Flush(void) {RBlockFile::Flush();}
 
+	/**
+	 * Get the policy of the cache.
+	 */
+	CachePolicy GetCachePolicy(void) const {return(Policy);}
+
+	/**
+	 * Set the policy of the cache.
+	 * @param policy         Policy.
+	 */
+	void SetCachePolicy(CachePolicy policy) {RBlockFile::SetCachePolicy(policy);}
+
+	using RBlockFile::GetNbHits;
+	using RBlockFile::GetNbMisses;
+	using RBlockFile::GetNbEvictions;
+	using RBlockFile::GetNbWriteBacks;
+	using RBlockFile::ResetCounters;
+	using RBlockFile::IsAsyncIO;
+
+	/**
+	 * Get the size of the Bloom filter of each block.
+	 */
+	size_t GetFilterSize(void) const {return(FilterSize);}
+
+	/**
+	 * Set the size of the Bloom filter of each block. If the size is not
+	 * null, the first and last keys and a Bloom filter of each block are kept
+	 * in memory (they are built when the file is opened). A lookup for a key
+	 * that is not in a block is then mostly answered without loading the
+	 * block. The erased keys stay in the filters until the file is opened
+	 * again.
+	 * @param size           Size (in bytes). About 10 bits are needed per key
+	 *                       for 1% of false positives.
+	 */
+	void SetFilterSize(size_t size);
+	using RBlockFile::GetNbPrefetches;
+
+	/**
+	 * Read and write the blocks of the file asynchronously (see
+	 * RBlockFile::SetAsyncIO).
+	 * @param async          Asynchronous reads and writes ?
+	 * @param readahead      Number of blocks read in advance.
+	 * @param nbbuffers      Number of buffers used to write in the background.
+	 */
+	void SetAsyncIO(bool async,size_t readahead=4,size_t nbbuffers=4) {RBlockFile::SetAsyncIO(async,readahead,nbbuffers);}
+
 private:
 
+	/**
+	 * Search for a key in the address table of a block.
+	 * @param table          Address table.
+	 * @param nbrecs         Number of records in the table.
+	 * @param key            Key.
+	 * @param find           Was it found ?
+	 * @return Position in the block address table.
+	 */
+	static size_t Search(const char* table,size_t nbrecs,K& key,bool& find);
+
 	/**
 	 * Get the index of the a identifier in the current block address table.
 	 * @param block          Block number.
@@ -271,6 +456,87 @@ private:
 	 */
 	size_t GetIndex(size_t block,K& key,bool& find);
 
+	/**
+	 * Set the free space of a block.
+	 * @param blockid        Identifier of the block.
+	 * @param free           Free space.
+	 */
+	void SetFreeSpace(size_t blockid,size_t free);
+
+	/**
+	 * Find the first block having a free space greater than the tolerance
+	 * that can hold a given size.
+	 * @param size           Size.
+	 * @return Identifier of the block or null if no block can hold the size.
+	 */
+	size_t FindFreeBlock(size_t size) const;
+
+	/**
+	 * Read the current entry of the address table of a block.
+	 * @param cur            Cursor on the block.
+	 */
+	void ReadEntry(BlockCursor* cur);
+
+	/**
+	 * Move down a cursor in a heap ordered by the current keys.
+	 * @param heap           Heap.
+	 * @param nb             Number of cursors in the heap.
+	 * @param pos            Position of the cursor to move.
+	 */
+	static void SiftDown(BlockCursor** heap,size_t nb,size_t pos);
+
+	/**
+	 * Build the index of all the blocks of the file.
+	 */
+	void BuildIndex(void);
+
+	/**
+	 * Update the first and last keys of a block from its address table (the
+	 * number of records must be the one of the block). If the block is the
+	 * next one to index, it is added to the index.
+	 * @param blockid        Identifier of the block.
+	 */
+	void UpdateFences(size_t blockid);
+
+	/**
+	 * Compute the hash code of a key as stored in the address tables.
+	 * @param raw            Bytes of the key (KeySize bytes).
+	 */
+	size_t HashKey(const char* raw) const;
+
+	/**
+	 * Compute the hash code of a key. The bytes of the key stored in the
+	 * address tables are given by K::GetRaw.
+	 * @param key            Key.
+	 */
+	size_t HashKey(K& key) const;
+
+	/**
+	 * Add a key to the Bloom filter of a block.
+	 * @param blockid        Identifier of the block.
+	 * @param hash           Hash code of the key (see HashKey).
+	 */
+	void AddToFilter(size_t blockid,size_t hash);
+
+	/**
+	 * Look if a block may contain a given key. If the block is indexed, the
+	 * answer is given without loading the block.
+	 * @param blockid        Identifier of the block.
+	 * @param key            Key.
+	 * @return false if the key is certainly not in the block.
+	 */
+	bool MayContain(size_t blockid,K& key) const;
+
+	/**
+	 * Position an access to the record of a given key in a given block. The
+	 * current position of the file is not used.
+	 * @param access         Access.
+	 * @param blockid        Identifier of the block.
+	 * @param key            Key.
+	 * @return true if the key was found.
+	 */
+	bool Seek(RBlockFileAccess& access,size_t blockid,K& key);
+
 	/**
 	 * Move all the records of all entries in the table.
 	 * @param blockid        Identifier of the block.
@@ -384,6 +650,35 @@ public:
 		}
 	}
 
+	/**
+	 * Find a vector of integers associated to a given index in a given block.
+	 * The current position of the file is not used: several threads can look
+	 * for keys at the same time (but no thread can write in the file).
+	 * @tparam I             Type of the numbers contained.
+	 * @tparam bOrder        Determine is the container to read is ordered.
+	 * @param blockid        Identifier of the block.
+	 * @param key            Key.
+	 * @param vec            Vector to fill.
+	 * @return true if the key was found.
+	 */
+	template<class I,bool bOrder> bool Find(size_t blockid,K& key,RNumContainer<I,bOrder>& vec)
+	{
+		vec.Clear();
+		RBlockFileAccess Access(this);
+		if(!Seek(Access,blockid,key))
+			return(false);
+		size_t size;
+		I nb;
+		Access.Read((char*)&size,sizeof(size_t));
+		vec.Verify(size);
+		for(size_t i=0;i<size;i++)
+		{
+			Access.Read((char*)&nb,sizeof(I));
+			vec.InsertAt(nb,i,false);
+		}
+		return(true);
+	}
+
 	/**
 	 * Read a RContainer of associated to a given index in a given block.
 	 * @tparam C             Class of the object contained in the container.
@@ -37,7 +37,8 @@
 //------------------------------------------------------------------------------
 template<class K>
 	RKeyValueFile<K>::RKeyValueFile(const RURI& uri,size_t blocksize,size_t nbcaches,size_t tolerance)
-	: RBlockFile(uri,blocksize,nbcaches), FreeSpaces(30), Tolerance(tolerance*1024)
+	: RBlockFile(uri,blocksize,nbcaches), FreeSpaces(30), FreeTree(0), NbLeaves(0), Tolerance(tolerance*1024),
+	  KeySize(K().GetSize()), FilterSize(0), Fences(0), Filters(0), NbIndexed(0), MaxIndexed(0)
 {
 }
 
@@ -47,6 +48,7 @@ template<class K>
 	void RKeyValueFile<K>::Open(RIO::ModeType mode)
 {
 	RBlockFile::Open(mode);
+	FreeSpaces.Clear();
 	FreeSpaces.Verify(GetNbBlocks()+10);
 	for(size_t i=0;i<GetNbBlocks();i++)
 	{
@@ -54,8 +56,9 @@ template<class K>
 		size_t Free;
 		RBlockFile::Seek(i+1,0);
 		Read((char*)&Free,sizeof(size_t));
-		FreeSpaces.InsertAt(Free,i,true);
+		SetFreeSpace(i+1,Free);
 	}
+	BuildIndex();
 }
 
 
@@ -74,38 +77,365 @@ template<class K>
 	if(!IsOpen())
 		mThrowRIOException(this,"File not opened");
 
-	// Clear the block file and the free spaces
+	// Clear the block file, the free spaces and the index of the blocks
 	RBlockFile::Clear();
 	FreeSpaces.Clear();
+	if(NbLeaves)
+		memset(FreeTree,0,2*NbLeaves*sizeof(size_t));
+	NbIndexed=0;
 }
 
 
 //------------------------------------------------------------------------------
 template<class K>
-	size_t RKeyValueFile<K>::GetIndex(size_t block,K& key,bool& find)
+	void RKeyValueFile<K>::SetFreeSpace(size_t blockid,size_t free)
+{
+	FreeSpaces.InsertAt(free,blockid-1,true);
+
+	// Double the number of leaves of the tree if necessary
+	if(blockid>NbLeaves)
+	{
+		size_t Nb(NbLeaves?NbLeaves:16);
+		while(Nb<blockid)
+			Nb*=2;
+		delete[] FreeTree;
+		FreeTree=new size_t[2*Nb];
+		memset(FreeTree,0,2*Nb*sizeof(size_t));
+		NbLeaves=Nb;
+		for(size_t i=0;i<FreeSpaces.GetNb();i++)
+			FreeTree[NbLeaves+i]=(FreeSpaces[i]>Tolerance)?FreeSpaces[i]:0;
+		for(size_t i=NbLeaves;--i;)
+			FreeTree[i]=(FreeTree[2*i]>FreeTree[2*i+1])?FreeTree[2*i]:FreeTree[2*i+1];
+		return;
+	}
+
+	// Only the free spaces greater than the tolerance can be used. Update the
+	// maximum of the parent nodes.
+	size_t Node(NbLeaves+blockid-1);
+	FreeTree[Node]=(free>Tolerance)?free:0;
+	for(Node/=2;Node;Node/=2)
+	{
+		size_t Max((FreeTree[2*Node]>FreeTree[2*Node+1])?FreeTree[2*Node]:FreeTree[2*Node+1]);
+		if(FreeTree[Node]==Max)
+			break;
+		FreeTree[Node]=Max;
+	}
+}
+
+
+//------------------------------------------------------------------------------
+template<class K>
+	size_t RKeyValueFile<K>::FindFreeBlock(size_t size) const
+{
+	if((!NbLeaves)||(FreeTree[1]<size))
+		return(0);
+
+	// Go down to the first leaf that can hold the size
+	size_t Node(1);
+	while(Node<NbLeaves)
+	{
+		Node*=2;
+		if(FreeTree[Node]<size)
+			Node++;
+	}
+	return(Node-NbLeaves+1);
+}
+
+
+//------------------------------------------------------------------------------
+template<class K>
+	double RKeyValueFile<K>::GetFragmentation(void) const
+{
+	if(!FreeSpaces.GetNb())
+		return(0.0);
+	double Free(0.0);
+	for(size_t i=0;i<FreeSpaces.GetNb();i++)
+		Free+=static_cast<double>(FreeSpaces[i]);
+	return(Free/(static_cast<double>(FreeSpaces.GetNb())*static_cast<double>(BlockSize)));
+}
+
+
+//------------------------------------------------------------------------------
+template<class K>
+	void RKeyValueFile<K>::ReadEntry(BlockCursor* cur)
+{
+	// A record ends where the record of the previous entry begins
+	size_t End(cur->Entry?cur->Pos:BlockSize);
+	RBlockFile::Seek(cur->BlockId,cLen2+(cur->Entry*(KeySize+cLen)));
+	memcpy(cur->RawKey,GetPtr(KeySize),KeySize);
+	RBlockFile::SeekRel(-static_cast<long>(KeySize));
+	cur->Key.Read(*this);
+	Read((char*)&cur->Pos,cLen);
+	cur->Size=End-cur->Pos;
+}
+
+
+//------------------------------------------------------------------------------
+template<class K>
+	void RKeyValueFile<K>::SiftDown(BlockCursor** heap,size_t nb,size_t pos)
+{
+	// K::Compare is positive if the key given is greater than the key
+	BlockCursor* Cur(heap[pos]);
+	size_t Child;
+	while((Child=2*pos+1)<nb)
+	{
+		if((Child+1<nb)&&(heap[Child+1]->Key.Compare(heap[Child]->RawKey)>0))
+			Child++;
+		if(Cur->Key.Compare(heap[Child]->RawKey)>=0)
+			break;
+		heap[pos]=heap[Child];
+		pos=Child;
+	}
+	heap[pos]=Cur;
+}
+
+
+//------------------------------------------------------------------------------
+template<class K>
+	void RKeyValueFile<K>::Compact(RContainer<Relocation,true,false>& moves)
 {
 	if(!IsOpen())
 		mThrowRIOException(this,"File not opened");
+	moves.Clear();
+
+	// A created file is opened again without being truncated
+	RIO::ModeType OldMode((Mode==RIO::Create)?RIO::ReadWrite:Mode);
+	RURI TmpURI(GetURI()()+".tmp");
+	BlockCursor** Heap(new BlockCursor*[GetNbBlocks()+1]);
+	size_t NbCursors(0);
+	try
+	{
+		// Build a heap with a cursor on each non-empty block
+		for(size_t i=1;i<=GetNbBlocks();i++)
+		{
+			size_t Nb;
+			RBlockFile::Seek(i,cLen);
+			Read((char*)&Nb,cLen);
+			if(!Nb)
+				continue;
+			BlockCursor* Cur(new BlockCursor(KeySize,i,Nb));
+			Heap[NbCursors++]=Cur;
+			ReadEntry(Cur);
+		}
+		for(size_t i=NbCursors/2;i;)
+			SiftDown(Heap,NbCursors,--i);
+
+		// Write the records in a new file in the order of the keys. Its
+		// blocks are filled without tolerance: the tolerance of the file is
+		// used again once it is opened.
+		{
+			RKeyValueFile<K> Tmp(TmpURI,BlockSize/1024,Cache.GetMaxNb(),0);
+			Tmp.Open();
+			Tmp.Clear();
+			Tmp.SetCacheType(WriteBack);
+			while(NbCursors)
+			{
+				BlockCursor* Cur(Heap[0]);
+				size_t BlockId(0);
+				Tmp.Seek(BlockId,Cur->Key,Cur->Size);
+				RBlockFile::Seek(Cur->BlockId,Cur->Pos);
+				Tmp.Write(GetPtr(Cur->Size),Cur->Size);
+				if(BlockId!=Cur->BlockId)
+					moves.InsertPtr(new Relocation(Cur->Key,Cur->BlockId,BlockId));
+
+				// Go to the next entry of the block or remove it from the heap
+				if((++Cur->Entry)<Cur->NbRecs)
+					ReadEntry(Cur);
+				else
+				{
+					delete Cur;
+					Heap[0]=Heap[--NbCursors];
+				}
+				if(NbCursors)
+					SiftDown(Heap,NbCursors,0);
+			}
+			Tmp.Close();
+		}
+		Close();
+	}
+	catch(...)
+	{
+		for(size_t i=0;i<NbCursors;i++)
+			delete Heap[i];
+		delete[] Heap;
+		try
+		{
+			RFile::RemoveFile(TmpURI);
+		}
+		catch(...)
+		{
+		}
+		throw;
+	}
+	delete[] Heap;
+
+	// Replace the file by the new one (the rename is atomic)
+	RFile::RenameFile(TmpURI,GetURI());
+	Open(OldMode);
+}
+
+
+//------------------------------------------------------------------------------
+template<class K>
+	void RKeyValueFile<K>::SetFilterSize(size_t size)
+{
+	if(size==FilterSize)
+		return;
+	delete[] Fences;
+	delete[] Filters;
+	Fences=Filters=0;
+	FilterSize=size;
+	NbIndexed=MaxIndexed=0;
+	if(IsOpen())
+		BuildIndex();
+}
+
+
+//------------------------------------------------------------------------------
+template<class K>
+	void RKeyValueFile<K>::BuildIndex(void)
+{
+	NbIndexed=0;
+	if(!FilterSize)
+		return;
+
+	for(size_t i=1;i<=GetNbBlocks();i++)
+	{
+		RBlockFile::Seek(i,cLen);
+		Read((char*)&NbRecs,cLen);
+		UpdateFences(i);
+		for(size_t j=0;j<NbRecs;j++)
+		{
+			RBlockFile::Seek(i,cLen2+(j*(KeySize+cLen)));
+			AddToFilter(i,HashKey(GetPtr(KeySize)));
+		}
+	}
+}
 
-	size_t NbMin(0),NbMax,i=0,cur;
-	const char* Table;
+
+//------------------------------------------------------------------------------
+template<class K>
+	void RKeyValueFile<K>::UpdateFences(size_t blockid)
+{
+	if((!FilterSize)||(blockid>NbIndexed+1))
+		return;
+
+	if(blockid>NbIndexed)
+	{
+		// A new block is indexed
+		if(NbIndexed==MaxIndexed)
+		{
+			size_t Max(MaxIndexed?2*MaxIndexed:GetNbBlocks()+10);
+			char* Tmp(new char[Max*2*KeySize]);
+			if(NbIndexed)
+				memcpy(Tmp,Fences,NbIndexed*2*KeySize);
+			delete[] Fences;
+			Fences=Tmp;
+			Tmp=new char[Max*FilterSize];
+			if(NbIndexed)
+				memcpy(Tmp,Filters,NbIndexed*FilterSize);
+			delete[] Filters;
+			Filters=Tmp;
+			MaxIndexed=Max;
+		}
+		memset(&Filters[NbIndexed*FilterSize],0,FilterSize);
+		NbIndexed++;
+	}
+
+	// The first and the last entries of the address table are the smallest
+	// and the greatest keys (an empty block keeps its previous fences)
+	if(!NbRecs)
+		return;
+	RBlockFile::Seek(blockid,cLen2);
+	const char* Table(GetPtr(NbRecs*(KeySize+cLen)));
+	char* Fence(&Fences[(blockid-1)*2*KeySize]);
+	memcpy(Fence,Table,KeySize);
+	memcpy(Fence+KeySize,Table+((NbRecs-1)*(KeySize+cLen)),KeySize);
+}
+
+
+//------------------------------------------------------------------------------
+template<class K>
+	size_t RKeyValueFile<K>::HashKey(const char* raw) const
+{
+	// FNV-1a hash of the bytes
+	size_t Hash(static_cast<size_t>(14695981039346656037ULL));
+	for(size_t i=0;i<KeySize;i++)
+	{
+		Hash^=static_cast<unsigned char>(raw[i]);
+		Hash*=static_cast<size_t>(1099511628211ULL);
+	}
+	return(Hash);
+}
+
+
+//------------------------------------------------------------------------------
+template<class K>
+	size_t RKeyValueFile<K>::HashKey(K& key) const
+{
+	// Small keys are copied on the stack
+	char Tmp[64];
+	char* Raw(KeySize<=sizeof(Tmp)?Tmp:new char[KeySize]);
+	key.GetRaw(Raw);
+	size_t Hash(HashKey(Raw));
+	if(Raw!=Tmp)
+		delete[] Raw;
+	return(Hash);
+}
+
+
+//------------------------------------------------------------------------------
+template<class K>
+	void RKeyValueFile<K>::AddToFilter(size_t blockid,size_t hash)
+{
+	if((!FilterSize)||(blockid>NbIndexed))
+		return;
+	char* Filter(&Filters[(blockid-1)*FilterSize]);
+	size_t Nb(FilterSize*8),Hash(hash),Inc((Hash>>17)|(Hash<<15)|1);
+	for(size_t i=0;i<NbHashes;i++,Hash+=Inc)
+		Filter[(Hash%Nb)/8]|=static_cast<char>(1<<((Hash%Nb)%8));
+}
+
+
+//------------------------------------------------------------------------------
+template<class K>
+	bool RKeyValueFile<K>::MayContain(size_t blockid,K& key) const
+{
+	if((!FilterSize)||(!blockid)||(blockid>NbIndexed))
+		return(true);
+
+	// Look if the key is outside the fences of the block
+	const char* Fence(&Fences[(blockid-1)*2*KeySize]);
+	if((key.Compare(Fence)>0)||(key.Compare(Fence+KeySize)<0))
+		return(false);
+
+	// Look if all the bits of the key are set in the filter
+	const char* Filter(&Filters[(blockid-1)*FilterSize]);
+	size_t Nb(FilterSize*8),Hash(HashKey(key)),Inc((Hash>>17)|(Hash<<15)|1);
+	for(size_t i=0;i<NbHashes;i++,Hash+=Inc)
+		if(!(Filter[(Hash%Nb)/8]&(1<<((Hash%Nb)%8))))
+			return(false);
+	return(true);
+}
+
+
+//------------------------------------------------------------------------------
+template<class K>
+	size_t RKeyValueFile<K>::Search(const char* table,size_t nbrecs,K& key,bool& find)
+{
+	size_t NbMin(0),NbMax,i=0;
 	bool CompNeg(true);
 	bool Cont=true,NotLast=true;
 
-	// Read number of records in that block
-	RBlockFile::Seek(block,cLen);
-	Read((char*)&NbRecs,cLen);
-	Table=GetPtr(NbRecs*(key.GetSize()+cLen));
-
 	find=false;
-	if(!NbRecs)
+	if(!nbrecs)
 		return(0);
-	NbMax=NbRecs-1;
+	NbMax=nbrecs-1;
 	NbMin=0;
 	while(Cont)
 	{
 		i=(NbMax+NbMin)/2;
-		int Ret(key.Compare(Table+i*(key.GetSize()+cLen)));
+		int Ret(key.Compare(table+i*(key.GetSize()+cLen)));
 		if(Ret==0)
 		{
 			find=true;
@@ -130,6 +460,48 @@ template<class K>
 }
 
 
+//------------------------------------------------------------------------------
+template<class K>
+	size_t RKeyValueFile<K>::GetIndex(size_t block,K& key,bool& find)
+{
+	if(!IsOpen())
+		mThrowRIOException(this,"File not opened");
+
+	// Read number of records in that block
+	RBlockFile::Seek(block,cLen);
+	Read((char*)&NbRecs,cLen);
+	const char* Table(GetPtr(NbRecs*(key.GetSize()+cLen)));
+	return(Search(Table,NbRecs,key,find));
+}
+
+
+//------------------------------------------------------------------------------
+template<class K>
+	bool RKeyValueFile<K>::Seek(RBlockFileAccess& access,size_t blockid,K& key)
+{
+	if(!IsOpen())
+		mThrowRIOException(this,"File not opened");
+	if(!MayContain(blockid,key))
+		return(false);
+
+	// Read the number of records and find the key in the table of the block
+	size_t Nb;
+	access.Seek(blockid,cLen);
+	access.Read((char*)&Nb,cLen);
+	const char* Table(access.GetPtr(Nb*(key.GetSize()+cLen)));
+	bool Find;
+	size_t Entry(Search(Table,Nb,key,Find));
+	if(!Find)
+		return(false);
+
+	// Read the position of the record and seek to it
+	size_t Pos;
+	memcpy(&Pos,Table+(Entry*(key.GetSize()+cLen))+key.GetSize(),cLen);
+	access.Seek(blockid,Pos);
+	return(true);
+}
+
+
 //------------------------------------------------------------------------------
 template<class K>
 	void RKeyValueFile<K>::MoveRecords(size_t blockid,size_t entry,long rel)
@@ -170,7 +542,7 @@ template<class K>
 
 	RBlockFile::Seek(blockid,0);
 	rel+=FreeSpaces[blockid-1];
-	FreeSpaces.InsertAt(rel,blockid-1,true);
+	SetFreeSpace(blockid,rel);
 	RBlockFile::Write((char*)&rel,cLen);
 }
 
@@ -189,7 +561,7 @@ template<class K>
 		// Write that only one record is present
 		RBlockFile::Seek(blockid,0);
 		size_t Info(BlockSize-size-cLen2-key.GetSize()-cLen);
-		FreeSpaces.InsertAt(Info,blockid-1,true);
+		SetFreeSpace(blockid,Info);
 		Write((char*)(&Info),cLen);
 		NbRecs=1;
 		Write((char*)(&NbRecs),cLen);
@@ -293,7 +665,10 @@ template<class K>
 		Pos-=size;
 	}
 
-	// Position the block at the right place
+	// Index the key and position the block at the right place
+	UpdateFences(blockid);
+	if(FilterSize)
+		AddToFilter(blockid,HashKey(key));
 	RBlockFile::Seek(blockid,Pos);
 }
 
@@ -405,7 +780,9 @@ template<class K>
 	RBlockFile::Seek(blockid,cLen);
 	RBlockFile::Write((char*)&NbRecs,cLen);
 
-	// Position the block at the right place
+	// Update the fences (the key stays in the filter) and position the block at
+	// the right place
+	UpdateFences(blockid);
 	RBlockFile::Seek(blockid,FirstPos+Size);
 }
 
@@ -418,8 +795,10 @@ template<class K>
 		mThrowRIOException(this,"File not opened");
 
 	// Find the right index in the table
-	bool Find;
-	size_t Entry(GetIndex(blockid,key,Find));
+	bool Find(MayContain(blockid,key));
+	size_t Entry(0);
+	if(Find)
+		Entry=GetIndex(blockid,key,Find);
 	if(!Find)
 		mThrowRIOException(this,"No record "+key.GetKey()+" in block "+RString::Number(blockid));
 
@@ -507,16 +886,9 @@ template<class K>
 	}
 
 	// A block must be search
-	// Look if an existing block can hold the size asked
-	blockid=0;
-	RNumCursor<size_t> Cur(FreeSpaces);
-	for(Cur.Start();!Cur.End();Cur.Next())
-	{
-		blockid++;
-		if((Cur()>Tolerance)&&(Cur()>=(size+key.GetSize()+cLen)))
-			break;
-	}
-	if(Cur.End())
+	// Look for the first existing block that can hold the size asked
+	blockid=FindFreeBlock(size+key.GetSize()+cLen);
+	if(!blockid)
 	{
 		// New block to create :
 		// Position it to the beginning and specify that they are one record.
@@ -543,4 +915,7 @@ template<class K>
 	RKeyValueFile<K>::~RKeyValueFile(void)
 {
 	Close();
+	delete[] FreeTree;
+	delete[] Fences;
+	delete[] Filters;
 }
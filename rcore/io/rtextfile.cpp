@@ -47,6 +47,12 @@ using namespace R;
 using namespace std;
 
 
+//------------------------------------------------------------------------------
+// Global constants
+static const size_t BufferSize=65536;      // Size of the blocks read.
+static const size_t MaxChars=BufferSize;    // Size of the window.
+
+
 
 //------------------------------------------------------------------------------
 //
@@ -56,7 +62,8 @@ using namespace std;
 
 //------------------------------------------------------------------------------
 RTextFile::RTextFile(void)
-  : RIOFile(), NewLine(true),
+  : RIOFile(), Buffer(0), NbBytes(0), PosBytes(0), Chars(0), SizeChars(0),
+    NextRead(0), SizeNextRead(0), LastRead(0), SkipBytes(0), CurPos(0), Reading(false), NewLine(true),
     Rem("%"), BeginRem("/*"), EndRem("*/"),
     CommentType(NoComment), ActivComment(NoComment), ParseSpace(SkipAllSpaces),
 	Separator(" "), SkipSeparator(false), Line(0), LastLine(0), Codec(0)
@@ -66,7 +73,8 @@ RTextFile::RTextFile(void)
 
 //------------------------------------------------------------------------------
 RTextFile::RTextFile(const RURI& uri,const RCString& encoding)
-  : RIOFile(uri), NewLine(true),
+  : RIOFile(uri), Buffer(0), NbBytes(0), PosBytes(0), Chars(0), SizeChars(0),
+    NextRead(0), SizeNextRead(0), LastRead(0), SkipBytes(0), CurPos(0), Reading(false), NewLine(true),
     Rem("%"), BeginRem("/*"), EndRem("*/"),
     CommentType(NoComment), ActivComment(NoComment), ParseSpace(SkipAllSpaces),
 	Separator(" "), SkipSeparator(false), Line(0), LastLine(0), Codec(RTextEncoding::GetTextEncoding(encoding))
@@ -76,7 +84,8 @@ RTextFile::RTextFile(const RURI& uri,const RCString& encoding)
 
 //------------------------------------------------------------------------------
 RTextFile::RTextFile(RIOFile& file,const RCString& encoding)
-	: RIOFile(file), NewLine(true),
+	: RIOFile(file), Buffer(0), NbBytes(0), PosBytes(0), Chars(0), SizeChars(0),
+	NextRead(0), SizeNextRead(0), LastRead(0), SkipBytes(0), CurPos(0), Reading(false), NewLine(true),
 	Rem("%"), BeginRem("/*"), EndRem("*/"),
 	CommentType(NoComment), ActivComment(NoComment), ParseSpace(SkipAllSpaces),
 	Separator(" "), SkipSeparator(false), Line(0), LastLine(0), Codec(RTextEncoding::GetTextEncoding(encoding))
@@ -87,6 +96,7 @@ RTextFile::RTextFile(RIOFile& file,const RCString& encoding)
 //------------------------------------------------------------------------------
 void RTextFile::Open(RIO::ModeType mode)
 {
+	Reading=false;
 	RIOFile::Open(mode);
 	LastLine=Line=0;
 	if(CanRead&&mode!=RIO::Append)
@@ -107,6 +117,7 @@ void RTextFile::Open(const RURI& uri,RIO::ModeType mode,const RCString& encoding
 //------------------------------------------------------------------------------
 void RTextFile::Close(void)
 {
+	Reading=false;
 	RIOFile::Close();
 }
 
@@ -115,33 +126,27 @@ void RTextFile::Close(void)
 void RTextFile::Seek(off_t pos)
 {
 	RIOFile::Seek(pos);
-
-	// Initialize the buffer
-	NextWrite=NextRead=Chars;
-	SizeNextWrite=SizeNextRead=SizeChars;
-	PosChars=0;
-	SkipBytes=0;
-	Resting=0;
-
-	// Read the first characters at the new position
-	ReadChars();
+	if(Reading)
+		ResetWindow();
 }
 
 
 //------------------------------------------------------------------------------
 void RTextFile::SeekRel(off_t pos)
 {
-	RIOFile::SeekRel(pos);
+	if(Reading)
+		Seek(CurPos+pos);
+	else
+		RIOFile::SeekRel(pos);
+}
 
-	// Initialize the buffer
-	NextWrite=NextRead=Chars;
-	SizeNextWrite=SizeNextRead=SizeChars;
-	PosChars=0;
-	SkipBytes=0;
-	Resting=0;
 
-	// Read the first characters at the new position
-	ReadChars();
+//------------------------------------------------------------------------------
+void RTextFile::SeekToEnd(void)
+{
+	RIOFile::SeekToEnd();
+	if(Reading)
+		ResetWindow();
 }
 
 
@@ -151,22 +156,31 @@ void RTextFile::Begin(void)
 	if(!CanRead)
 		throw(RIOException(this,"File Mode is not Read"));
 	LastLine=Line=1;
-	NextWrite=NextRead=Chars;
-	SizeNextWrite=SizeNextRead=SizeChars;
-	PosChars=0;
-	SkipBytes=0;
-	Resting=0;
-	Read(Buffer,2,false);
-	if((Buffer[0]==char(0xfe))&&(Buffer[1]==char(0xff)))
+	if(!Buffer)
 	{
-		cout<<"networkOrder = TRUE"<<endl;
-		RIOFile::SeekRel(2);
+		Buffer=new char[BufferSize];
+		Chars=new RChar[MaxChars];
+		SizeChars=new size_t[MaxChars];
 	}
-	else if((Buffer[0]==char(0xff))&&(Buffer[1]==char(0xfe)))
+	NbBytes=PosBytes=SkipBytes=0;
+	NextRead=LastRead=Chars;
+	SizeNextRead=SizeChars;
+	Reading=true;
+	if(!RIOFile::End())
 	{
-		cout<<"networkOrder = FALSE"<<endl;
-		RIOFile::SeekRel(2);
+		Read(Buffer,2,false);
+		if((Buffer[0]==char(0xfe))&&(Buffer[1]==char(0xff)))
+		{
+			cout<<"networkOrder = TRUE"<<endl;
+			RIOFile::SeekRel(2);
+		}
+		else if((Buffer[0]==char(0xff))&&(Buffer[1]==char(0xfe)))
+		{
+			cout<<"networkOrder = FALSE"<<endl;
+			RIOFile::SeekRel(2);
+		}
 	}
+	CurPos=RIOFile::GetPos();
 
 	// Read the first characters
 	ReadChars();
@@ -178,95 +192,98 @@ void RTextFile::Begin(void)
 
 
 //------------------------------------------------------------------------------
-void RTextFile::ReadChars(void)
+void RTextFile::ReadChars(size_t min)
 {
-	// Verify that there is something to read
-	if(End())
-		return;
+	// Move the characters not treated at the beginning of the window
+	size_t Left(LastRead-NextRead);
+	if(NextRead!=Chars)
+	{
+		memmove(Chars,NextRead,Left*sizeof(RChar));
+		memmove(SizeChars,SizeNextRead,Left*sizeof(size_t));
+		NextRead=Chars;
+		SizeNextRead=SizeChars;
+		LastRead=Chars+Left;
+	}
 
-	// Initialize some local variables
-	size_t treat,len=20*4+SkipBytes,s;
-	char* ptr=Buffer+SkipBytes;
-	bool end;
-	RTextEncoding::UnicodeCharacter NextCar;
-
-	// Read next 20 Unicode characters
-	len=Read(Buffer,len,false);
-	len-=SkipBytes;
-	SkipBytes=0;
-	for(size_t n=21;(--n)&&len;NextWrite++,SizeNextWrite++)
+	while((Left<min)&&(Left+1<MaxChars))
 	{
-		for(end=false,treat=0,s=len;!end;)
+		// Fill the buffer with the next block of the file
+		if((NbBytes-PosBytes<BufferSize)&&(!RIOFile::End()))
 		{
-			try
-			{
-				if(Resting.Unicode())
-				{
-					(*NextWrite)=Resting;
-					(*SizeNextWrite)=0;;
-					Resting=0;
-					end=true;
-					continue;
-				}
-
-				// Try to read an unicode character with accepting invalid characters
-				NextCar=Codec->NextUnicode(ptr,s,true);
-				if(!NextCar.Valid)
-				{
-					ptr++;
-					treat++;
-					continue;
-				}
-
-				// Valid Unicode character
-				(*NextWrite)=NextCar.Codes[0];
-				ptr+=s;
-				len-=treat+s;
-				if(n<11)
-					SkipBytes+=treat+s;
-				if(s>2)
-					Resting=NextCar.Codes[1];
-				else
-					Resting=0;
-				(*SizeNextWrite)=treat+s;
-				end=true;
-			}
-			catch(RException e)
-			{
-				throw RIOException(this,e.GetMsg());
-			}
+			memmove(Buffer,&Buffer[PosBytes],NbBytes-PosBytes);
+			NbBytes-=PosBytes;
+			PosBytes=0;
+			NbBytes+=Read(&Buffer[NbBytes],BufferSize-NbBytes);
+		}
+		if(PosBytes==NbBytes)
+			return;
+
+		// Decode the bytes
+		size_t Len(NbBytes-PosBytes),Nb;
+		try
+		{
+			Nb=Codec->NextUnicodes(&Buffer[PosBytes],Len,LastRead,&SizeChars[Left],MaxChars-Left,true);
+		}
+		catch(RException& e)
+		{
+			throw RIOException(this,e.GetMsg());
+		}
+		if(Nb)
+		{
+			SizeChars[Left]+=SkipBytes;
+			SkipBytes=0;
+			PosBytes+=Len;
+			LastRead+=Nb;
+			Left+=Nb;
+		}
+		else if(RIOFile::End()||(!PosBytes&&(NbBytes==BufferSize)))
+		{
+			// The remaining bytes cannot be decoded (they contain only invalid
+			// bytes or an incomplete character at the end of the file): skip them
+			SkipBytes+=NbBytes-PosBytes;
+			PosBytes=NbBytes=0;
 		}
 	}
 }
 
 
 //------------------------------------------------------------------------------
-inline void RTextFile::FillBuffer(void)
+void RTextFile::ResetWindow(void)
 {
-	if(PosChars==10)
-		ReadChars();
-	else if(PosChars==30)
-	{
-		NextWrite=Chars;
-		SizeNextWrite=SizeChars;
-		ReadChars();
-	}
-	else if(PosChars==40)
+	NbBytes=PosBytes=SkipBytes=0;
+	NextRead=LastRead=Chars;
+	SizeNextRead=SizeChars;
+	CurPos=RIOFile::GetPos();
+	ReadChars();
+}
+
+
+//------------------------------------------------------------------------------
+void RTextFile::WriteEncoded(const char* buffer,size_t nb)
+{
+	if(!Reading)
 	{
-		PosChars=0;
-		NextRead=Chars;
-		SizeNextRead=SizeChars;
+		Write(buffer,nb);
+		return;
 	}
+
+	// The file is ahead of the next character to handle
+	RIOFile::Seek(CurPos);
+	Write(buffer,nb);
+	ResetWindow();
 }
 
 
 //------------------------------------------------------------------------------
-void RTextFile::Next(void)
+void RTextFile::MoveNext(void)
 {
-	bool ReadTwice(false);
+	if(NextRead==LastRead)
+		return;
 
 	Cur=(*(NextRead++));
-	PosChars++;
+	CurPos+=(*(SizeNextRead++));
+	if(NextRead==LastRead)
+		ReadChars();
 
 	if(Cur==10)          // UNIX case
 	{
@@ -277,23 +294,13 @@ void RTextFile::Next(void)
 		Line++;
 
 		// DOS only
-		if((!End())&&(*NextRead)==10) ReadTwice=true;
-	}
-
-	if(End())
-		return;
-
-	RIOFile::SeekRel(*(SizeNextRead++)); // Seek file
-
-	FillBuffer();
-
-	if(ReadTwice)
-	{
-		Cur=(*(NextRead++));
-		RIOFile::SeekRel(*(SizeNextRead++));
-		PosChars++;
-
-		FillBuffer();
+		if((NextRead!=LastRead)&&((*NextRead)==10))
+		{
+			Cur=(*(NextRead++));
+			CurPos+=(*(SizeNextRead++));
+			if(NextRead==LastRead)
+				ReadChars();
+		}
 	}
 }
 
@@ -333,48 +340,24 @@ bool RTextFile::CurString(const RString& str,bool CaseSensitive,bool skip)
 	if((CaseSensitive&&((*tofind)!=(*NextRead)))||(!CaseSensitive&&(RChar::ToLower(*tofind)!=RChar::ToLower(*NextRead))))
 		return(false);
 
-	// Place the second character
-	RChar* search;
-	size_t* ssearch;
-	size_t possearch(PosChars+1);
-	off_t end(GetPos()+(*SizeNextRead));
-	if(possearch==40)
-	{
-		search=Chars;
-		ssearch=SizeChars;
-		possearch=0;
-	}
-	else
+	// The string cannot end the file: the window must contain at least one
+	// character after it
+	if(static_cast<size_t>(LastRead-NextRead)<=max)
 	{
-		search=NextRead+1;
-		ssearch=SizeNextRead+1;
+		ReadChars(max+1);
+		if(static_cast<size_t>(LastRead-NextRead)<=max)
+			return(false);
 	}
 
-	for(tofind++;(--max)&&(end<GetSize());tofind++)
+	// Compare the other characters
+	const RChar* search(NextRead+1);
+	for(tofind++;--max;tofind++,search++)
 	{
 		// If current characters are the same -> return false -> nothing to do
 		if((CaseSensitive&&((*tofind)!=(*search)))||(!CaseSensitive&&(RChar::ToLower(*tofind)!=RChar::ToLower(*search))))
 			return(false);
-
-		// Look for next character
-		end+=(*ssearch);
-		possearch++;
-		if(possearch==40)
-		{
-			search=Chars;
-			ssearch=SizeChars;
-			possearch=0;
-		}
-		else
-		{
-			search++;
-			ssearch++;
-		}
 	}
 
-	if(end==GetSize())
-		return(false);
-
 	// String found -> skip it
 	if(skip)
 	{
@@ -934,7 +917,7 @@ void RTextFile::WriteSeparator(void)
 {
 	if(NewLine||SkipSeparator) return;
 	RCString str=Codec->FromUnicode(Separator,false);
-	Write(str,str.GetLen());
+	WriteEncoded(str,str.GetLen());
 }
 
 
@@ -943,7 +926,7 @@ void RTextFile::WriteLine(void)
 {
 	RString endofline("\n");
 	RCString str=Codec->FromUnicode(endofline,false);
-	Write(str,str.GetLen());
+	WriteEncoded(str,str.GetLen());
 	LastLine=Line++;
 	#ifdef windows
 		flushall();
@@ -958,7 +941,7 @@ void RTextFile::WriteStr(const RString& str,bool invalid)
 	mReturnIfFail(str.GetLen()>0);
 	WriteSeparator();
 	RCString res=Codec->FromUnicode(str,invalid);
-	Write(res,res.GetLen());
+	WriteEncoded(res,res.GetLen());
 	#ifdef windows
 		flushall();
 	#endif
@@ -978,7 +961,7 @@ void RTextFile::WriteStr(const char* c,size_t l,bool)
 {
 	if(!l) return;
 	WriteSeparator();
-	Write(c,l);
+	WriteEncoded(c,l);
 	#ifdef windows
 		flushall();
 	#endif
@@ -1230,6 +1213,9 @@ void RTextFile::WriteLog(const RString& entry,bool invalid)
 RTextFile::~RTextFile(void)
 {
 	Close();
+	delete[] Buffer;
+	delete[] Chars;
+	delete[] SizeChars;
 }
 
 
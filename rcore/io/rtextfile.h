@@ -102,16 +102,12 @@ class RTextEncoding;
 * }
 * @endcode
 * \note
-* Internally, when a file is read, a buffer holds a small number of Unicode
-* characters (Chars), and a buffer holds the size in bytes of each character
-* read (SizeChars). Two pointers (NextRead and SizeNextRead) parse these buffers
-* when characters already read must be treated. Two other buffers (NextWrite and
-* SizeNextWrite) parse the buffers when new characters must be read from the
-* file.
-* \par
-* Each character is decoded one by one. This multiplies the call to
-* RTextEnconding which is time-consumming, but ensure that the file always now
-* the exact position (in byte) of every Unicode character read.
+* Internally, when a file is read, blocks of 64 Kb are read and decoded at once
+* (see RTextEncoding::NextUnicodes) in a window of Unicode characters (Chars).
+* The size in bytes of each character is also stored (SizeChars), so that the
+* file knows the exact position (in byte) of every Unicode character read
+* without moving the position of the underlying file. Two pointers (NextRead
+* and SizeNextRead) parse the window when characters must be treated.
 * @short Text File.
 */
 class RTextFile : public RIOFile
@@ -143,54 +139,60 @@ public:
 private:
 
 	/**
-	* Temporary buffer (Used only if read mode).
+	* Buffer of the bytes read from the file (Used only if read mode).
 	*/
-	char Buffer[512];
+	char* Buffer;
 
 	/**
-	 * Buffer of Unicode characters already read.
-	 */
-	RChar Chars[40];
+	* Number of bytes in the buffer.
+	*/
+	size_t NbBytes;
 
 	/**
-	 * Size of Unicode characters already read in the buffer.
-	 */
-	size_t SizeChars[40];
+	* Position of the first byte of the buffer not decoded yet.
+	*/
+	size_t PosBytes;
 
 	/**
-	 * Resting (if any) character if a 4-byte Unicode character is read.
-	 */
-	RChar Resting;
+	* Window of the Unicode characters decoded but not treated yet.
+	*/
+	RChar* Chars;
 
 	/**
-	 * Position of the next Unicode to handle.
-	 */
-	size_t PosChars;
+	* Size (in bytes) of each Unicode character of the window.
+	*/
+	size_t* SizeChars;
 
 	/**
-	 * Next character to handle.
-	 */
+	* Next character to handle.
+	*/
 	RChar* NextRead;
 
 	/**
-	 * Size of the next character to handle.
-	 */
+	* Size of the next character to handle.
+	*/
 	size_t* SizeNextRead;
 
 	/**
-	 * Next character to treat.
-	 */
-	RChar* NextWrite;
+	* End of the characters of the window.
+	*/
+	RChar* LastRead;
 
 	/**
-	 * Size of the next character to treat.
-	 */
-	size_t* SizeNextWrite;
+	* Number of invalid bytes skipped that must be added to the size of the next
+	* character decoded.
+	*/
+	size_t SkipBytes;
 
 	/**
-	 * Number of bytes to skip the next time Unicode characters must be extracted.
-	 */
-	size_t SkipBytes;
+	* Position (in bytes) of the next character to handle.
+	*/
+	off_t CurPos;
+
+	/**
+	* Is the file read through the window?
+	*/
+	bool Reading;
 
 	/**
 	* At NewLine? (Used only if created or append mode).
@@ -312,6 +314,34 @@ public:
 	*/
 	virtual void SeekRel(off_t pos);
 
+	/**
+	* Go to the end of the file.
+	* @warning this method doesn't take the count of lines into account.
+	*/
+	virtual void SeekToEnd(void);
+
+	/**
+	* Verify if the end of the file is reached. When the file is read, it is the
+	* case when all the characters were treated.
+	*/
+	virtual bool End(void) const
+	{
+		if(Reading)
+			return(NextRead==LastRead);
+		return(RIOFile::End());
+	}
+
+	/**
+	* Get the position of the file. When the file is read, it is the position
+	* (in bytes) of the next character to handle.
+	*/
+	virtual off_t GetPos(void) const
+	{
+		if(Reading)
+			return(CurPos);
+		return(RIOFile::GetPos());
+	}
+
 	/**
 	* Read the next character but without to move the internal pointer of the
 	* file.
@@ -363,15 +393,28 @@ private:
 	void Begin(void);
 
 	/**
-	 * Must the buffer be filled again.
-	 */
-	inline void FillBuffer(void);
+	* Decode the next block of the file in the window. The characters not yet
+	* treated are first moved to the beginning of the window. If the file is at
+	* the end, nothing is done.
+	* @param min            Minimum number of characters that the window should
+	*                       contain.
+	*/
+	void ReadChars(size_t min=1);
+
+	/**
+	* Empty the window and decode the characters from the current position of
+	* the file.
+	*/
+	void ResetWindow(void);
 
 	/**
-	* Read a series of 20 characters of variable size and store the result in
-	* an internal buffer. If the file is at the end, nothing is done.
+	* Write encoded bytes. When the file is read, they are written at the
+	* position of the next character to handle, and the window is filled again
+	* with the characters following them.
+	* @param buffer         Buffer.
+	* @param nb             Number of bytes.
 	*/
-	void ReadChars(void);
+	void WriteEncoded(const char* buffer,size_t nb);
 
 public:
 
@@ -399,12 +442,29 @@ private:
 	*/
 	bool EndComment(void);
 
+	/**
+	* Goes to the next character when the current one is the last one of the
+	* window or a carriage return.
+	*/
+	void MoveNext(void);
+
 protected:
 
 	/**
 	* Goes to the next character.
 	*/
-	void Next(void);
+	inline void Next(void)
+	{
+		if((NextRead+1<LastRead)&&((*NextRead)!=13))
+		{
+			Cur=(*(NextRead++));
+			CurPos+=(*(SizeNextRead++));
+			if(Cur==10)
+				Line++;
+		}
+		else
+			MoveNext();
+	}
 
 public:
 
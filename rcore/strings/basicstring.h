@@ -104,12 +104,14 @@ protected:
 		size_t MaxLen;
 		/**Latin1 version of the string. */
 		char* Latin1;
+		/** Hash code of the string (0 if not computed). */
+		size_t Hash;
 
 		/**
 		 * Constructor.
 		 */
 		CharBuffer(void)
-			: RSharedData(), Text(0), Len(0), MaxLen(0), Latin1(0) {}
+			: RSharedData(), Text(0), Len(0), MaxLen(0), Latin1(0), Hash(0) {}
 		/**
 		 * Constructor.
 		 * @param tab        Array corresponding to a string.
@@ -117,7 +119,7 @@ protected:
 		 * @param maxlen     Length of the array.
 		 */
 		CharBuffer(C* tab,size_t len,size_t maxlen)
-			: RSharedData(), Text(tab), Len(len), MaxLen(maxlen),Latin1(0) {}
+			: RSharedData(), Text(tab), Len(len), MaxLen(maxlen),Latin1(0), Hash(0) {}
 
 		/**
 		 * Verify if the buffer can contained a given number of parameters.
@@ -137,6 +139,11 @@ protected:
 			}
 		}
 
+		/**
+		 * Invalid the hash code.
+		 */
+		inline void InvalidHash(void) {Hash=0;}
+
 		/**
 		 * Destruct the buffer.
 		 */
@@ -452,6 +459,14 @@ public:
 	*/
 	size_t HashIndex(size_t idx) const;
 
+	/**
+	* Compute a hash code in the range [0,max-1]. The hash code is computed on
+	* the bytes of the characters, read by words of 64 bits, and it is kept in
+	* the buffer until the string is modified.
+	* @param max             Maximal value.
+	*/
+	size_t HashCode(size_t max) const;
+
 	/**
 	 * Destruct the string.
 	 */
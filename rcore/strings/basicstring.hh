@@ -168,7 +168,10 @@ template<class C,class S>
 		Data=new CharBuffer(ptr,len,maxlen);
 	}
 	else if(Data)
+	{
 		Data->InvalidLatin1();
+		Data->InvalidHash();
+	}
 }
 
 
@@ -784,6 +787,47 @@ template<class C,class S>
 }
 
 
+//-----------------------------------------------------------------------------
+template<class C,class S>
+	size_t R::BasicString<C,S>::HashCode(size_t max) const
+{
+	if(!Data)
+		return(0);
+	if(!Data->Hash)
+	{
+		// MurmurHash64A applied on the bytes of the characters
+		const uint64_t m(0xc6a4a7935bd1e995ULL);
+		const unsigned char* ptr(reinterpret_cast<const unsigned char*>(Data->Text));
+		size_t len(Data->Len*sizeof(C));
+		uint64_t h(len*m),k;
+		for(const unsigned char* end=ptr+(len&~static_cast<size_t>(7));ptr!=end;ptr+=8)
+		{
+			memcpy(&k,ptr,8);
+			k*=m;
+			k^=k>>47;
+			k*=m;
+			h^=k;
+			h*=m;
+		}
+		if(len&7)
+		{
+			for(size_t i=len&7;i--;)
+				h^=static_cast<uint64_t>(ptr[i])<<(8*i);
+			h*=m;
+		}
+		h^=h>>47;
+		h*=m;
+		h^=h>>47;
+
+		// The null value means that the hash code is not computed
+		Data->Hash=static_cast<size_t>(h);
+		if(!Data->Hash)
+			Data->Hash=1;
+	}
+	return(Data->Hash%max);
+}
+
+
 //-----------------------------------------------------------------------------
 template<class C,class S>
 	R::BasicString<C,S>::~BasicString(void)
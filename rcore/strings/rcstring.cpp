@@ -148,15 +148,7 @@ RCString& RCString::operator+=(const char src)
 //-----------------------------------------------------------------------------
 size_t RCString::HashCode(size_t max) const
 {
-    size_t hash(5381);
-
-	 if(!Data)
-		 return(0);
-    for(const char* ptr=Data->Text;!ptr;ptr++)
-	 {
-        hash =((hash<<5)+hash)+(*ptr);   // hash * 33 + c
-	 }
-    return (hash%max);
+	return(BasicString<char,RCString>::HashCode(max));
 }
 
 
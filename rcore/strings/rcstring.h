@@ -338,10 +338,11 @@ public:
 	inline int Compare(const char* src) const {return(strcmp(Data->Text,src)); }
 
 	/**
-	* Compute a hash code that in the range [0,max-1]. In practice, in computes
-	* a sum based on the Unicode values the characters.
+	* Compute a hash code that in the range [0,max-1]. The hash code is kept
+	* until the string is modified (see BasicString::HashCode).
 	*
-	* This method is R::RHashContainer to manage string.
+	* This method is used by R::RHashContainer and R::RHashTable to manage
+	* strings.
 	* @param max             Maximal value.
 	* @return a number in the range [0,max-1].
 	*/
@@ -195,6 +195,7 @@ RString& RString::operator+=(const char* src)
 		(*ptr2)=0;
 		Data->Len+=len;
 		static_cast<CharBuffer*>(Data)->InvalidLatin1();
+		Data->InvalidHash();
 	}
 	return(*this);
 }
@@ -221,6 +222,7 @@ RString& RString::operator+=(const char src)
 			(*(ptr++))=src;
 			(*ptr)=0;
 			static_cast<CharBuffer*>(Data)->InvalidLatin1();
+			Data->InvalidHash();
 		}
 	}
 	return(*this);
@@ -249,6 +251,7 @@ RString& RString::operator+=(const RChar src)
 			(*(ptr++))=src;
 			(*ptr)=0;
 			static_cast<CharBuffer*>(Data)->InvalidLatin1();
+			Data->InvalidHash();
 		}
 	}
 	return(*this);
@@ -302,15 +305,7 @@ void RString::Concat(const iRContainer<RString>& elements,const RChar car)
 //-----------------------------------------------------------------------------
 size_t RString::HashCode(size_t max) const
 {
-    size_t hash(5381);
-
-	 if(!Data)
-		 return(0);
-    for(const RChar* ptr=Data->Text;!ptr->IsNull();ptr++)
-	 {
-        hash =((hash<<5)+hash)+ptr->Unicode();   // hash * 33 + c
-	 }
-    return (hash%max);
+	return(BasicString<RChar,RString>::HashCode(max));
 }
 
 
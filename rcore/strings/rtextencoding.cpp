@@ -118,8 +118,15 @@ RCString GetOfficialName(const RCString& alias)
 
 //------------------------------------------------------------------------------
 RTextEncoding::RTextEncoding(const RCString& name)
-	: Name(name.ToLower())
+	: Name(name.ToLower()), Scheme(Generic)
 {
+	if(Name=="utf-8")
+		Scheme=UTF8;
+	else if(Name=="iso_8859-1:1987")
+		Scheme=Latin1;
+	else if(Name=="ansi_x3.4-1968")
+		Scheme=ASCII;
+
 	ToUTF16=static_cast<void*>(iconv_open("utf-16le",Name));
 	if((ToUTF16==(iconv_t)-1)&&(errno==EINVAL))
 		throw REncodingException(RString(Name())+" encoding not supported");
@@ -295,6 +302,169 @@ RTextEncoding::UnicodeCharacter RTextEncoding::NextUnicode(const char* text,size
 }
 
 
+//------------------------------------------------------------------------------
+size_t RTextEncoding::NextUnicodes(const char* text,size_t& len,RChar* chars,size_t* sizes,size_t max,bool invalid) const
+{
+	const unsigned char* ptr(reinterpret_cast<const unsigned char*>(text));
+	const unsigned char* end(ptr+len);
+	const unsigned char* last(ptr);  // End of the last character read
+	size_t nb(0);
+
+	while((ptr<end)&&(nb<max))
+	{
+		unsigned int Code;
+		size_t s;
+
+		switch(Scheme)
+		{
+			case Latin1:
+				Code=(*ptr);
+				s=1;
+				break;
+
+			case ASCII:
+				Code=(*ptr);
+				s=(Code<0x80)?1:0;
+				break;
+
+			case UTF8:
+			{
+				// Find the number of bytes and the valid range of the second one
+				unsigned int Min(0x80),Max(0xBF);
+				Code=(*ptr);
+				if(Code<0x80)
+					s=1;
+				else if((Code>=0xC2)&&(Code<=0xDF))
+				{
+					s=2;
+					Code&=0x1F;
+				}
+				else if((Code>=0xE0)&&(Code<=0xEF))
+				{
+					s=3;
+					if(Code==0xE0)
+						Min=0xA0;
+					else if(Code==0xED)
+						Max=0x9F;  // No surrogates
+					Code&=0x0F;
+				}
+				else if((Code>=0xF0)&&(Code<=0xF4))
+				{
+					s=4;
+					if(Code==0xF0)
+						Min=0x90;
+					else if(Code==0xF4)
+						Max=0x8F;
+					Code&=0x07;
+				}
+				else
+				{
+					s=0;
+					break;
+				}
+
+				// Verify the continuation bytes
+				for(size_t i=1;i<s;i++,Min=0x80,Max=0xBF)
+				{
+					if(ptr+i==end)
+					{
+						// Incomplete character
+						len=last-reinterpret_cast<const unsigned char*>(text);
+						return(nb);
+					}
+					if((ptr[i]<Min)||(ptr[i]>Max))
+					{
+						s=0;
+						break;
+					}
+					Code=(Code<<6)|(ptr[i]&0x3F);
+				}
+				break;
+			}
+
+			default:
+			{
+				// Decode the next character with iconv
+				char Tab[4];
+				char* ptr1(reinterpret_cast<char*>(const_cast<unsigned char*>(ptr)));
+				char* ptr2(Tab);
+				size_t s1(end-ptr),s2(2),err;
+				for(bool ToFill=true;ToFill;)
+				{
+					#ifdef _LIBICONV_VERSION
+						#if (defined __APPLE__ || defined WIN32)
+							err=iconv(static_cast<iconv_t>(ToUTF16),&ptr1,&s1,&ptr2,&s2);
+						#else
+							err=iconv(static_cast<iconv_t>(ToUTF16),const_cast<const char**>(&ptr1),&s1,&ptr2,&s2);
+						#endif
+					#else
+						err=iconv(static_cast<iconv_t>(ToUTF16),&ptr1,&s1,&ptr2,&s2);
+					#endif
+					ToFill=false;
+					if((err==(size_t)-1)&&(errno==E2BIG)&&(ptr2==Tab)&&(s2==2))
+					{
+						// The character needs two RChar
+						s2=4;
+						ToFill=true;
+					}
+					else if((err==(size_t)-1)&&(errno==EINVAL))
+					{
+						// Incomplete character
+						len=last-reinterpret_cast<const unsigned char*>(text);
+						return(nb);
+					}
+					else if((err==(size_t)-1)&&(errno==EBADF))
+						throw RException("Invalid descriptor for encoding  "+RString(Name()));
+				}
+				s=reinterpret_cast<unsigned char*>(ptr1)-ptr;
+				if((!s)||(ptr2==Tab))
+				{
+					s=0;
+					break;
+				}
+				Code=*reinterpret_cast<UChar*>(Tab);
+				if(ptr2-Tab==4)
+				{
+					// Rebuild the code point from the surrogates
+					Code=0x10000+((Code-0xD800)<<10)+(*reinterpret_cast<UChar*>(Tab+2)-0xDC00);
+				}
+				break;
+			}
+		}
+
+		// Invalid byte: skip it
+		if(!s)
+		{
+			if(!invalid)
+				throw RInvalidByteException("Invalid byte sequence for encoding "+RString(Name()));
+			ptr++;
+			continue;
+		}
+
+		// Store the character
+		if(Code>0xFFFF)
+		{
+			if(nb+2>max)
+				break;
+			Code-=0x10000;
+			chars[nb]=RChar(static_cast<UChar>(0xD800+(Code>>10)));
+			sizes[nb++]=(ptr+s)-last;
+			chars[nb]=RChar(static_cast<UChar>(0xDC00+(Code&0x3FF)));
+			sizes[nb++]=0;
+		}
+		else
+		{
+			chars[nb]=RChar(static_cast<UChar>(Code));
+			sizes[nb++]=(ptr+s)-last;
+		}
+		ptr+=s;
+		last=ptr;
+	}
+	len=last-reinterpret_cast<const unsigned char*>(text);
+	return(nb);
+}
+
+
 //------------------------------------------------------------------------------
 RCString RTextEncoding::FromUnicode(const RChar* text,size_t len,bool invalid) const
 {
@@ -128,11 +128,27 @@ public:
 
 private:
 
+	/**
+	* Schemes decoded without iconv by NextUnicodes.
+	*/
+	enum tScheme
+	{
+		Generic                  /** Decoded with iconv.*/,
+		ASCII                    /** US-ASCII.*/,
+		Latin1                   /** ISO-8859-1.*/,
+		UTF8                     /** UTF-8.*/
+	};
+
 	/**
 	* The name of the encoding (always in upper case).
 	*/
 	RCString Name;
 
+	/**
+	* Scheme of the encoding.
+	*/
+	tScheme Scheme;
+
 	/**
 	* Descriptor used to make the conversion to Unicode UTF-16.
 	*/
@@ -199,6 +215,31 @@ public:
 	*/
 	virtual UnicodeCharacter NextUnicode(const char* text,size_t& len,bool invalid=false) const;
 
+	/**
+	* Read the Unicode characters contained in a block of text of the given
+	* encoding. The ASCII, Latin-1 and UTF-8 encodings are decoded directly,
+	* the other ones with iconv.
+	*
+	* The decoding stops when all the bytes are read, when max characters are
+	* read, or when the remaining bytes form an incomplete character or contain
+	* only invalid bytes (they must be read again with the following bytes of
+	* the text).
+	* @param text           Text in the given encoding.
+	* @param len            Number of bytes to analyze. After the call, this
+	*                       parameters contains the number of bytes read.
+	* @param chars          Array receiving the characters. A Unicode
+	*                       character stored in two RChar takes two entries.
+	* @param sizes          Array receiving the number of bytes of each
+	*                       character (the invalid bytes skipped before it
+	*                       included). The second RChar of a Unicode character
+	*                       has a size of zero.
+	* @param max            Maximum number of RChar to read.
+	* @param invalid        If true, invalid bytes are skipped. If false, an
+	*                       exception is generated.
+	* @return the number of RChar read.
+	*/
+	virtual size_t NextUnicodes(const char* text,size_t& len,RChar* chars,size_t* sizes,size_t max,bool invalid=false) const;
+
 	/**
 	* Transform a string in Unicode to a string of the given encoding.
 	* @param text           Unicode string.
@@ -38,6 +38,7 @@
 #include <rstd.h>
 #include <rstring.h>
 #include <rexception.h>
+#include <rsort.h>
 
 
 //-----------------------------------------------------------------------------
@@ -188,6 +189,32 @@ private:
 	*/
 	iRContainer(bool dealloc,bool order,size_t m,size_t i);
 
+	/**
+	* Change the size of the array. The new positions are set to null.
+	* @param max             New size of the array.
+	*/
+	void ReAllocTab(size_t max);
+
+	/**
+	* Sort an array of elements with their 'Compare' method. The sort is
+	* stable: equal elements keep their order.
+	* @param tab             Array to sort.
+	* @param nb              Number of elements.
+	* @param tmp             Temporary array of (at least) nb elements.
+	*/
+	static void MergeSort(C** tab,size_t nb,C** tmp);
+
+	/**
+	* Merge an ordered array of elements with the elements of the container
+	* in one pass. A new array is built for the container.
+	* @param tab             Ordered array of elements (not null).
+	* @param nb              Number of elements.
+	* @param del             Specify if a similar existing element must be
+	*                        replaced (and deleted if the container is
+	*                        responsible for the deallocation).
+	*/
+	void MergePtrs(C** tab,size_t nb,bool del);
+
 public:
 
 	/**
@@ -219,13 +246,28 @@ public:
 
 	/**
 	* Verify if the container can hold a certain number of elements. If not,
-	* the container is extended.
+	* the container is extended. The size of the array is increased by the
+	* half of its current size (and at least by the increment), so that
+	* filling a container element by element takes a linear time.
    * @param max             Maximal number of elements that must be contained.
 	*                        If null, the method verifies that one element can
 	*                        be added.
 	*/
 	void VerifyTab(size_t max=0);
 
+	/**
+	* Reserve the memory for a given number of elements. Contrary to
+	* VerifyTab, the array is not extended beyond this number.
+	* @param max             Number of elements.
+	*/
+	void Reserve(size_t max);
+
+	/**
+	* Release the memory not used by the container, i.e. the size of the array
+	* is reduced to the position next to the last element.
+	*/
+	void ShrinkToFit(void);
+
 	/**
 	* Clear the container and destruct the elements if it is responsible for
 	* the deallocation. The container can also be extended.
@@ -274,6 +316,26 @@ public:
 	*    for the ordering.
 	*/
 	inline void ReOrder(int sortOrder(const void*,const void*),size_t min,size_t max)
+	{
+		ReOrder(RSortFunction<C*>(sortOrder),min,max);
+	}
+
+	/**
+	* ReOrder a part of the container based on a function object (see
+	* R::RSort). Contrary to a sort function, the comparisons can be inlined:
+	* @code
+	* Cont.ReOrder(RSortStatic<MyElement*,MyElement::SortOrder>(),0,0);
+	* @endcode
+	* @tparam cCompare       Function object.
+	* @param comp            Function object used for the ordering.
+	* @param min             Starting index of the container part concerned.
+	* @param max             Ending index of the container part concerned.
+	* @param nbthreads       Maximum number of threads used to sort the large
+	*                        parts (see R::RSort). If null, the number of
+	*                        processors is used. If greater than 1, the function
+	*                        object must be thread-safe.
+	*/
+	template<class cCompare> inline void ReOrder(const cCompare& comp,size_t min,size_t max,size_t nbthreads=1)
 	{
        if(!NbPtr)
            return;  // No elements -> no sorting
@@ -287,7 +349,10 @@ public:
        else
           NbMax=max;
 		if(NbMax>NbMin)
-			qsort(static_cast<void*>(&Tab[NbMin]),NbMax-NbMin+1,sizeof(void*),sortOrder);
+		{
+			RSort<C*,cCompare> Engine(comp,nbthreads);
+			Engine.Sort(&Tab[NbMin],NbMax-NbMin+1);
+		}
 	}
 
 	/**
@@ -304,11 +369,17 @@ public:
 
 	/**
 	* ReOrder the whole container based on the 'Compare' method of the objects
-	* contained.
+	* contained. The calls to the method are inlined.
    * @warning This method must be used with caution, because it can crash the
    * container if the container contains null pointers.
 	*/
-	inline void ReOrder(void) {ReOrder(SortOrder,0,0);}
+	inline void ReOrder(void)
+	{
+		if(!NbPtr)
+			return;
+		RSort<C*,RSortPtr<C> > Engine;
+		Engine.Sort(Tab,LastPtr);
+	}
 
 	/**
 	* Exchange two elements in the container. The method does not verify if the
@@ -664,6 +735,31 @@ public:
 	*/
 	void InsertPtr(C* ins,bool del=false,size_t min=0,size_t max=0);
 
+	/**
+	* Insert a batch of elements in the container. If the container is
+	* ordered, the elements are sorted once, and merged with the existing ones
+	* in a single pass, which is much faster than inserting them one by one.
+	* The elements of the batch are inserted in their order: when del is true
+	* and several elements are similar, the last one remains.
+	* @param tab             Array of the elements to insert (in any order).
+	* @param nb              Number of elements.
+	* @param del             Specify if a similar existing element must be
+	*                        deleted.
+	*/
+	void InsertPtrs(C** tab,size_t nb,bool del=false);
+
+	/**
+	* Merge the elements of another container into this one. If both
+	* containers are ordered, the merge is done in one pass. Contrary to
+	* Union, the container is not emptied and the similar elements are kept
+	* (or replaced by those of src if del is true). If the container is
+	* responsible for the deallocation, the elements are copied.
+	* @param src             Container to merge.
+	* @param del             Specify if a similar existing element must be
+	*                        deleted.
+	*/
+	void Merge(const iRContainer<C>& src,bool del=false);
+
 	/**
 	* Delete an element from the container at a given position.
 	* @param pos             Position of the element.
@@ -45,7 +45,7 @@ template<class C>
 	IncPtr=src.IncPtr;
 	if(!src.NbPtr)
 		return;
-	VerifyTab(src.LastPtr);
+	Reserve(src.LastPtr);
 	NbPtr=src.NbPtr;
 	LastPtr=src.LastPtr;
 	if(Dealloc&&src.Dealloc)
@@ -74,7 +74,7 @@ template<class C>
 	Clear();
 	if(!src.NbPtr)
 		return(*this);
-	VerifyTab(src.LastPtr);
+	Reserve(src.LastPtr);
 	if(Dealloc&&src.Dealloc)
 	{
 		for(i=src.LastPtr+1,tab=src.Tab,tab2=Tab;--i;tab++,tab2++)
@@ -104,7 +104,7 @@ template<class C>
 	Clear();
 	if(!src.NbPtr)
 		return;
-	VerifyTab(src.LastPtr);
+	Reserve(src.LastPtr);
 	for(i=src.LastPtr+1,tab=src.Tab,tab2=Tab;--i;tab++,tab2++)
 	{
 		if(*tab)
@@ -170,33 +170,69 @@ template<class C>
 	}
 	if(MaxPtr)
 	{
-		Tab = new C*[MaxPtr];
-		memset(Tab,0x0,MaxPtr*sizeof(C*));
+		Tab=static_cast<C**>(calloc(MaxPtr,sizeof(C*)));
+		if(!Tab)
+			throw std::bad_alloc();
 	}
 }
 
 
+//-----------------------------------------------------------------------------
+template<class C>
+	void iRContainer<C>::ReAllocTab(size_t max)
+{
+	// The array only holds pointers: it can be reallocated
+	C** ptr(static_cast<C**>(realloc(Tab,max*sizeof(C*))));
+	if(max&&(!ptr))
+		throw std::bad_alloc();
+	Tab=ptr;
+	if(max>MaxPtr)
+		memset(&Tab[MaxPtr],0x0,(max-MaxPtr)*sizeof(C*));
+	MaxPtr=max;
+}
+
+
 //-----------------------------------------------------------------------------
 template<class C>
 	void iRContainer<C>::VerifyTab(size_t max)
 {
 	if((!max)&&(LastPtr==MaxPtr))
-		max=MaxPtr+IncPtr;
+		max=MaxPtr+1;
 	if(max>MaxPtr)
 	{
-		C** ptr;
-		size_t OldSize;
+		size_t Inc(MaxPtr/2);
+		if(Inc<IncPtr)
+			Inc=IncPtr;
+		if(max<MaxPtr+Inc)
+			max=MaxPtr+Inc;
+		ReAllocTab(max);
+	}
+}
+
+
+//-----------------------------------------------------------------------------
+template<class C>
+	void iRContainer<C>::Reserve(size_t max)
+{
+	if(max>MaxPtr)
+		ReAllocTab(max);
+}
+
 
-		OldSize=MaxPtr;
-		MaxPtr=max;
-		ptr=new C*[MaxPtr];
-		if(Tab)
+//-----------------------------------------------------------------------------
+template<class C>
+	void iRContainer<C>::ShrinkToFit(void)
+{
+	if(LastPtr<MaxPtr)
+	{
+		if(LastPtr)
+			ReAllocTab(LastPtr);
+		else
 		{
-			memcpy(ptr,Tab,OldSize*sizeof(C*));
-			delete[] Tab;
+			free(Tab);
+			Tab=0;
+			MaxPtr=0;
 		}
-		Tab=ptr;
-		memset(&Tab[OldSize],0x0,(MaxPtr-OldSize)*sizeof(C*));
 	}
 }
 
@@ -223,7 +259,7 @@ template<class C>
 	if(i)
 		IncPtr=i;
 	if(m)
-		VerifyTab(m);
+		Reserve(m);
 }
 
 
@@ -565,6 +601,138 @@ template<class C>
 }
 
 
+//-----------------------------------------------------------------------------
+template<class C>
+	void iRContainer<C>::MergeSort(C** tab,size_t nb,C** tmp)
+{
+	// Bottom-up merge of runs of increasing widths between tab and tmp
+	C** From(tab);
+	C** To(tmp);
+	for(size_t Width=1;Width<nb;Width*=2)
+	{
+		for(size_t i=0;i<nb;i+=2*Width)
+		{
+			size_t Mid((i+Width<nb)?i+Width:nb),End((i+2*Width<nb)?i+2*Width:nb);
+			size_t Left(i),Right(Mid),Pos(i);
+			while((Left<Mid)&&(Right<End))
+				To[Pos++]=(From[Right]->Compare(*From[Left])<0)?From[Right++]:From[Left++];
+			if(Left<Mid)
+				memcpy(&To[Pos],&From[Left],(Mid-Left)*sizeof(C*));
+			else if(Right<End)
+				memcpy(&To[Pos],&From[Right],(End-Right)*sizeof(C*));
+		}
+		C** Swap(From);
+		From=To;
+		To=Swap;
+	}
+	if(From!=tab)
+		memcpy(tab,From,nb*sizeof(C*));
+}
+
+
+//-----------------------------------------------------------------------------
+template<class C>
+	void iRContainer<C>::MergePtrs(C** tab,size_t nb,bool del)
+{
+	size_t Max(LastPtr+nb);
+	if(Max<MaxPtr)
+		Max=MaxPtr;
+	C** New(static_cast<C**>(calloc(Max,sizeof(C*))));
+	if(!New)
+		throw std::bad_alloc();
+
+	// Parse both arrays once (the existing elements are placed before the new similar ones)
+	C** Ptr1(Tab);
+	C** End1(Tab+LastPtr);
+	C** End2(tab+nb);
+	C** Out(New);
+	while((Ptr1!=End1)||(tab!=End2))
+	{
+		if((Ptr1!=End1)&&(!(*Ptr1)))
+		{
+			Ptr1++;
+			continue;
+		}
+		if((tab==End2)||((Ptr1!=End1)&&((*Ptr1)->Compare(**tab)<=0)))
+		{
+			(*(Out++))=(*(Ptr1++));
+			continue;
+		}
+		C* Cur(*(tab++));
+		if(del&&(Out!=New)&&(!Out[-1]->Compare(*Cur)))
+		{
+			if(Dealloc&&(Out[-1]!=Cur))
+				delete Out[-1];
+			Out[-1]=Cur;
+		}
+		else
+			(*(Out++))=Cur;
+	}
+	free(Tab);
+	Tab=New;
+	MaxPtr=Max;
+	NbPtr=LastPtr=Out-New;
+}
+
+
+//-----------------------------------------------------------------------------
+template<class C>
+	void iRContainer<C>::InsertPtrs(C** tab,size_t nb,bool del)
+{
+	if(!nb)
+		return;
+	if(!tab)
+		throw std::invalid_argument("iRContainer<C>::InsertPtrs : Cannot insert a null array");
+	for(size_t i=0;i<nb;i++)
+		if(!tab[i])
+			throw std::invalid_argument("iRContainer<C>::InsertPtrs : Cannot insert a null pointer");
+	if(!Order)
+	{
+		VerifyTab(LastPtr+nb);
+		memcpy(&Tab[LastPtr],tab,nb*sizeof(C*));
+		LastPtr+=nb;
+		NbPtr+=nb;
+		return;
+	}
+	C** Batch(new C*[2*nb]);
+	memcpy(Batch,tab,nb*sizeof(C*));
+	MergeSort(Batch,nb,&Batch[nb]);
+	MergePtrs(Batch,nb,del);
+	delete[] Batch;
+}
+
+
+//-----------------------------------------------------------------------------
+template<class C>
+	void iRContainer<C>::Merge(const iRContainer<C>& src,bool del)
+{
+	if((!src.NbPtr)||(&src==this))
+		return;
+
+	// Build the batch of the (copied) elements of src
+	C** Batch(new C*[2*src.NbPtr]);
+	size_t Nb(0);
+	C** ptr(src.Tab);
+	for(size_t i=src.LastPtr+1;--i;ptr++)
+		if(*ptr)
+			Batch[Nb++]=Dealloc?new C(**ptr):(*ptr);
+	if(Order)
+	{
+		if(!src.Order)
+			MergeSort(Batch,Nb,&Batch[Nb]);
+		MergePtrs(Batch,Nb,del);
+	}
+	else
+	{
+		VerifyTab(LastPtr+Nb);
+		memcpy(&Tab[LastPtr],Batch,Nb*sizeof(C*));
+		LastPtr+=Nb;
+		NbPtr+=Nb;
+	}
+	delete[] Batch;
+}
+
+
 //-----------------------------------------------------------------------------
 template<class C>
 	void iRContainer<C>::DeletePtrAt(size_t pos,bool shift,bool del)
@@ -762,6 +930,6 @@ template<class C>
 			for(LastPtr++,ptr=Tab;--LastPtr;ptr++)
 				delete(*ptr);
 		}
-		delete[] Tab;
+		free(Tab);
 	}
 }
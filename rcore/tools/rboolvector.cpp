@@ -48,7 +48,9 @@ RBoolVector::RBoolVector(size_t nb,bool val)
 {
 	if(!MaxBool)
 		MaxBool=100;
-	List = new bool[MaxBool];
+	List=static_cast<bool*>(malloc(MaxBool*sizeof(bool)));
+	if(!List)
+		throw std::bad_alloc();
 	memset(List,char(Default),MaxBool*sizeof(bool));
 }
 
@@ -59,7 +61,9 @@ RBoolVector::RBoolVector(const RBoolVector& vector)
 {
 	NbBool = vector.NbBool;
 	MaxBool = vector.MaxBool;
-	List = new bool[MaxBool];
+	List=static_cast<bool*>(malloc(MaxBool*sizeof(bool)));
+	if(!List)
+		throw std::bad_alloc();
 	memcpy(List,vector.List,vector.MaxBool*sizeof(bool));
 }
 
@@ -76,13 +80,14 @@ void RBoolVector::Verify(size_t max)
 {
 	if(max>MaxBool)
 	{
-		size_t OldSize(MaxBool);
-		MaxBool=max;
-		bool* ptr(new bool[MaxBool]);
-		memcpy(ptr,List,OldSize*sizeof(bool));
-		delete[] List;
+		size_t NewSize(MaxBool+(MaxBool/2));
+		if(max>NewSize)
+			NewSize=max;
+		bool* ptr(static_cast<bool*>(realloc(List,NewSize*sizeof(bool))));
+		if(!ptr)
+			throw std::bad_alloc();
 		List=ptr;
-
+		MaxBool=NewSize;
 	}
 }
 
@@ -186,5 +191,5 @@ bool& RBoolVector::operator[](size_t i)
 //------------------------------------------------------------------------------
 RBoolVector::~RBoolVector(void)
 {
-	delete[] List;
+	free(List);
 }
@@ -107,7 +107,8 @@ private:
 
 	/**
 	* Verify if the vector can hold a certain number of elements. If necessary,
-	* the vector is extended with undefined values.
+	* the vector is extended (at least by the half of its size) with undefined
+	* values.
    * @param max              Number of elements in the vector.
 	*/
 	void Verify(size_t max);
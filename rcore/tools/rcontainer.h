@@ -73,16 +73,12 @@ namespace R{
 *
 * When a lot of elements must be inserted into a ordered container, each element
 * may require that some existing elements are shifted to the right. This can be
-* time consumming. A better approach is then to force the elements to be
-* inserted at the end of the container, and then to sort it:
+* time consumming. A better approach is then to insert them as a batch, which
+* is sorted once and merged with the existing elements:
 * @code
 * RContainer<RString,true,true> Test(20);
-* Test.InsertPtrAt(new RString("This"),Test.GetNb());
-* Test.InsertPtrAt(new RString("is"),Test.GetNb());
-* Test.InsertPtrAt(new RString("a"),Test.GetNb());
-* Test.InsertPtrAt(new RString("little"),Test.GetNb());
-* Test.InsertPtrAt(new RString("test"),Test.GetNb());
-* Test.ReOrder();
+* RString* Batch[]={new RString("This"),new RString("is"),new RString("a"),new RString("little"),new RString("test")};
+* Test.InsertPtrs(Batch,5);
 * @endcode
 *
 * At least, a compare function must be implemented in the class C:
@@ -207,6 +203,18 @@ public:
 	*/
 	inline void VerifyTab(size_t max=0) {iRContainer<C>::VerifyTab(max);}
 
+	/**
+	* Reserve the memory for a given number of elements. Contrary to
+	* VerifyTab, the array is not extended beyond this number.
+	* @param max             Number of elements.
+	*/
+	inline void Reserve(size_t max) {iRContainer<C>::Reserve(max);}
+
+	/**
+	* Release the memory not used by the container.
+	*/
+	inline void ShrinkToFit(void) {iRContainer<C>::ShrinkToFit();}
+
 	/**
 	* Clear the container and destruct the elements if it is responsible for
 	* the deallocation.The container can also be extended.
@@ -268,6 +276,18 @@ public:
 	*/
 	inline void ReOrder(int sortOrder(const void*,const void*),size_t min,size_t max) {iRContainer<C>::ReOrder(sortOrder,min,max);}
 
+	/**
+	* ReOrder a part of the container based on a function object (see
+	* R::RSort).
+	* @tparam cCompare       Function object.
+	* @param comp            Function object used for the ordering.
+	* @param min             Starting index of the container part concerned.
+	* @param max             Ending index of the container part concerned.
+	* @param nbthreads       Maximum number of threads used to sort the large
+	*                        parts. If null, the number of processors is used.
+	*/
+	template<class cCompare> inline void ReOrder(const cCompare& comp,size_t min,size_t max,size_t nbthreads=1) {iRContainer<C>::ReOrder(comp,min,max,nbthreads);}
+
 	/**
 	* ReOrder the whole container based on a given sort function.
 	*
@@ -288,7 +308,7 @@ public:
    * @warning This method must be used with caution, because it can crash the
    * container if the container contains null pointers.
 	*/
-	inline void ReOrder(void) {iRContainer<C>::ReOrder(SortOrder,0,0);}
+	inline void ReOrder(void) {iRContainer<C>::ReOrder();}
 
 	/**
 	* Exchange two elements in the container. The method does not verify if the
@@ -618,6 +638,26 @@ public:
 	*/
 	inline void InsertPtr(C* ins,bool del=false,size_t min=0,size_t max=0) {iRContainer<C>::InsertPtr(ins,del,min,max);}
 
+	/**
+	* Insert a batch of elements in the container. If the container is
+	* ordered, the elements are sorted once, and merged with the existing ones
+	* in a single pass.
+	* @param tab             Array of the elements to insert (in any order).
+	* @param nb              Number of elements.
+	* @param del             Specify if a similar existing element must be
+	*                        deleted.
+	*/
+	inline void InsertPtrs(C** tab,size_t nb,bool del=false) {iRContainer<C>::InsertPtrs(tab,nb,del);}
+
+	/**
+	* Merge the elements of another container into this one. If both
+	* containers are ordered, the merge is done in one pass.
+	* @param src             Container to merge.
+	* @param del             Specify if a similar existing element must be
+	*                        deleted.
+	*/
+	inline void Merge(const iRContainer<C>& src,bool del=false) {iRContainer<C>::Merge(src,del);}
+
 	/**
 	* Delete an element from the container at a given position.
 	* @param pos             Position of the element.
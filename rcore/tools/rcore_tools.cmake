@@ -14,6 +14,8 @@ SET(rcore_tools_INST_INCLUDES
 	rteststd.h
 	rstack.h
 	rhashcontainer.h
+	rhashtable.h
+	rhashtable.hh
 	rnode.h
 	rnode.hh
 	rtree.h
@@ -34,6 +36,8 @@ SET(rcore_tools_INST_INCLUDES
 	rvalue.h
 	rquicksort.h
 	rquicksort.hh
+	rsort.h
+	rsort.hh
 )
 
 SET(rcore_tools_TARGET_SOURCES
@@ -53,7 +53,9 @@ namespace R{
 *
 * In practice, a table of the given size is allocated, each row representing a
 * possible hash code. For each hash code, a container is maintained to manage
-* elements sharing the same hash code.
+* elements sharing the same hash code. Since the size of the table never
+* changes, R::RHashTable should be preferred when the number of elements is
+* not known in advance.
 *
 * @tparam C                 The class of the element to be contained.
 * @tparam bAlloc            Specify if the elements are deallocated by the
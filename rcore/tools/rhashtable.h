@@ -0,0 +1,384 @@
+/*
+
+	R Project Library
+
+	RHashTable.h
+
+	Hash Table with Open Addressing - Header
+
+	Copyright 2000-2015 by Pascal Francq (pascal@francq.info).
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Library General Public
+	License as published by the Free Software Foundation; either
+	version 2.0 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Library General Public License for more details.
+
+	You should have received a copy of the GNU Library General Public
+	License along with this library, as a file COPYING.LIB; if not, write
+	to the Free Software Foundation, Inc., 59 Temple Place, Suite 330,
+	Boston, MA  02111-1307  USA
+
+*/
+
+
+
+//------------------------------------------------------------------------------
+#ifndef RHashTable_H
+#define RHashTable_H
+
+
+//------------------------------------------------------------------------------
+// include files for R Project
+#include <rstd.h>
+
+
+//------------------------------------------------------------------------------
+namespace R{
+//------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------
+// forward declaration
+template<class C,bool bAlloc> class RHashTableCursor;
+
+
+//------------------------------------------------------------------------------
+/**
+* The RHashTable provides a container of elements (class C) managed through a
+* hash table. Each element must have a key (such an unique name), but the hash
+* codes must not be unique. The container can be responsible for the
+* deallocation of the elements (bAlloc).
+*
+* Contrary to R::RHashContainer, the size of the table does not have to be
+* known in advance. The elements are stored directly in the table (open
+* addressing with a linear probing) which grows when it is filled at 80%. The
+* elements are placed with the "Robin Hood" strategy: an element that is far
+* from its ideal slot takes the place of an element that is nearer from its
+* own. The searches stop therefore as soon as a slot "richer" than the tag is
+* found. The hash code of each element is stored with it, so that the
+* elements are only compared when their hash codes are identical, and that the
+* table can grow without computing the hash codes again.
+*
+* @tparam C                 The class of the element to be contained.
+* @tparam bAlloc            Specify if the elements are deallocated by the
+*                           container.
+*
+* The container uses the same methods than R::RHashContainer:
+* @code
+* int Compare(const TUse& tag) const;
+* size_t HashCode(size_t max) const;
+* @endcode
+* The HashCode methods are called with cNoRef as maximum value, and the
+* elements are supposed to be equal to a tag if Compare returns 0. Look at
+* R::RString and R::RCString for example of implementations.
+*
+* Here is an example of a hash table managing instances of the class
+* MyElement:
+* @code
+* #include <rhashtable.h>
+* using namespace R;
+*
+*
+* class MyElement
+* {
+*    RString Text;
+* public:
+*    MyElement(const RString& text) : Text(text) {}
+*    int Compare(const MyElement& e) const {return(Text.Compare(e.Text));}
+*    int Compare(const RString& text) const {return(Text.Compare(text));}
+*    size_t HashCode(size_t max) const {return(Text.HashCode(max));}
+*    void DoSomething(void) {cout<<Text<<endl;}
+* };
+*
+*
+* int main()
+* {
+*    RHashTable<MyElement,true> c(1000);
+*
+*    c.InsertPtr(new MyElement("Hello World"));
+*    if(c.IsIn(RString("Hello World")))
+*       cout<<"An element of value \"Hello World\" is in the container"<<endl;
+*    c.GetInsertPtr(RString("Other"));
+*
+*    // Parse the hash table
+*    RHashTableCursor<MyElement,true> Cur(c);
+*    for(Cur.Start();!Cur.End();Cur.Next())
+*       Cur()->DoSomething();
+* }
+* @endcode
+*
+* @short Hash Table.
+*/
+template<class C,bool bAlloc>
+	class RHashTable
+{
+	/**
+	* A slot of the table.
+	*/
+	class Slot
+	{
+	public:
+		C* Ptr;                    // Element.
+		size_t Hash;               // Hash code of the element.
+		size_t Dist;               // Distance to the ideal slot plus one (0 if the slot is empty).
+	};
+
+	/**
+	* Slots of the table (their number is a power of two).
+	*/
+	Slot* Slots;
+
+	/**
+	* Number of slots.
+	*/
+	size_t NbSlots;
+
+	/**
+	* Mask to apply on a hash code to find its ideal slot.
+	*/
+	size_t Mask;
+
+	/**
+	* Number of elements.
+	*/
+	size_t NbPtr;
+
+	/**
+	* Number of elements from which the table grows.
+	*/
+	size_t MaxPtr;
+
+public:
+
+	/**
+	* Construct the hash table.
+	* @param max             Number of elements that the table can hold
+	*                        without growing.
+	*/
+	RHashTable(size_t max=0);
+
+private:
+
+	/**
+	* Copy constructor (not allowed).
+	*/
+	RHashTable(const RHashTable<C,bAlloc>&);
+
+	/**
+	* Assignment operator (not allowed).
+	*/
+	RHashTable<C,bAlloc>& operator=(const RHashTable<C,bAlloc>&);
+
+	/**
+	* Compute the hash code used by the table from the hash code of an element.
+	* The bits are mixed so that poor hash functions remain usable.
+	* @param hash            Hash code.
+	*/
+	static inline size_t Mix(size_t hash)
+	{
+		hash*=static_cast<size_t>(0x9E3779B97F4A7C15ULL);
+		return(hash^(hash>>(4*sizeof(size_t))));
+	}
+
+	/**
+	* Find the slot of the element represented by a tag.
+	* @tparam TUse           The type of tag, the container uses the
+	*                        Compare(TUse &) member function of the elements.
+	* @param tag             The tag used.
+	* @param hash            Hash code of the tag.
+	* @return the index of the slot or cNoRef if the element is not in the
+	* table.
+	*/
+	template<class TUse> size_t Find(const TUse& tag,size_t hash) const;
+
+	/**
+	* Place an element that is not in the table.
+	* @param ptr             Pointer to the element.
+	* @param hash            Hash code of the element.
+	*/
+	void Place(C* ptr,size_t hash);
+
+	/**
+	* Remove the element of a given slot. The next elements are shifted
+	* backward.
+	* @param idx             Index of the slot.
+	*/
+	void Remove(size_t idx);
+
+	/**
+	* Change the number of slots and place the elements again.
+	* @param nb              Number of slots (a power of two).
+	*/
+	void ReHash(size_t nb);
+
+public:
+
+	/**
+	* Verify if the table can hold a given number of elements. If not, the
+	* table grows.
+	* @param max             Number of elements.
+	*/
+	void Verify(size_t max);
+
+	/**
+	* Get the number of elements in the container.
+	*/
+	inline size_t GetNb(void) const {return(NbPtr);}
+
+	/**
+	* Get the number of slots of the table.
+	*/
+	inline size_t GetNbSlots(void) const {return(NbSlots);}
+
+	/**
+	* Clear the container. The elements are destroyed if the container is
+	* responsible for the deallocation. The slots remain allocated.
+	*/
+	void Clear(void);
+
+	/**
+	* Look if a certain element is in the container.
+	* @tparam TUse           The type of tag, the container uses the
+	*                        Compare(TUse &) member function of the elements.
+	* @param tag             The tag used.
+	* @return true if the element is in the container.
+	*/
+	template<class TUse> inline bool IsIn(const TUse& tag) const
+	{
+		return(Find(tag,Mix(tag.HashCode(cNoRef)))!=cNoRef);
+	}
+
+	/**
+	* Get a pointer to a certain element in the container.
+	* @tparam TUse           The type of tag, the container uses the
+	*                        Compare(TUse &) member function of the elements.
+	* @param tag             The tag used.
+	* @return the pointer or 0 if the element is not in the container.
+	*/
+	template<class TUse> inline C* GetPtr(const TUse& tag) const
+	{
+		size_t Idx(Find(tag,Mix(tag.HashCode(cNoRef))));
+		if(Idx==cNoRef)
+			return(0);
+		return(Slots[Idx].Ptr);
+	}
+
+	/**
+	* Get a pointer to a certain element in the container. If the element
+	* doesn't exist, the container creates it by using the constructor with
+	* TUse as parameter.
+	* @tparam TUse           The type of tag, the container uses the
+	*                        Compare(TUse &) member function of the elements.
+	* @param tag             The tag used.
+	* @return a pointer to the element of the container.
+	*/
+	template<class TUse> C* GetInsertPtr(const TUse& tag);
+
+	/**
+	* Insert an element in the container. If an element with the same key is
+	* already in the container, it is replaced.
+	* @param ins             A pointer to the element to insert.
+	* @param del             Specify if a replaced element must be deleted.
+	*/
+	void InsertPtr(C* ins,bool del=bAlloc);
+
+	/**
+	* Delete an element from the container.
+	* @tparam TUse           The type of tag, the container uses the
+	*                        Compare(TUse &) member function of the elements.
+	* @param tag             The tag used.
+	* @param del             Specify if the object must deleted or not. By
+	*                        default, the element is destruct if the container
+	*                        is responsible of the deallocation.
+	*/
+	template<class TUse> void DeletePtr(const TUse& tag,bool del=bAlloc);
+
+	/**
+	* Get the average distance between the slots of the elements and their
+	* ideal slots (0 means that all the elements are at their ideal slots).
+	*/
+	double GetAvgDist(void) const;
+
+	/**
+	* Destruct the hash table.
+	*/
+	virtual ~RHashTable(void);
+
+	friend class RHashTableCursor<C,bAlloc>;
+};
+
+
+//------------------------------------------------------------------------------
+/**
+* The RHashTableCursor class provides a cursor iterating the elements of a
+* R::RHashTable. The elements are iterated in the order of the slots. The
+* table should not be modified while it is iterated.
+* @tparam C                 The class of the elements.
+* @tparam bAlloc            Specify if the elements are deallocated by the
+*                           table.
+* @short Hash Table Cursor.
+*/
+template<class C,bool bAlloc>
+	class RHashTableCursor
+{
+	/**
+	* Table iterated.
+	*/
+	const RHashTable<C,bAlloc>* Table;
+
+	/**
+	* Current slot.
+	*/
+	size_t Pos;
+
+public:
+
+	/**
+	* Construct the cursor.
+	* @param table           Table to iterate.
+	*/
+	RHashTableCursor(const RHashTable<C,bAlloc>& table) : Table(&table), Pos(0) {Start();}
+
+	/**
+	* Start the iteration.
+	*/
+	inline void Start(void)
+	{
+		for(Pos=0;(Pos<Table->NbSlots)&&(!Table->Slots[Pos].Dist);Pos++) ;
+	}
+
+	/**
+	* Test if the end of the table is reached.
+	*/
+	inline bool End(void) const {return(Pos>=Table->NbSlots);}
+
+	/**
+	* Go to the next element.
+	*/
+	inline void Next(void)
+	{
+		for(Pos++;(Pos<Table->NbSlots)&&(!Table->Slots[Pos].Dist);Pos++) ;
+	}
+
+	/**
+	* Get the current element.
+	*/
+	inline C* operator()(void) const {return(Table->Slots[Pos].Ptr);}
+};
+
+
+//------------------------------------------------------------------------------
+// inline implementation
+#include <rhashtable.hh>
+
+
+}  //-------- End of namespace R -----------------------------------------------
+
+
+//------------------------------------------------------------------------------
+#endif
@@ -0,0 +1,217 @@
+/*
+
+	R Project Library
+
+	RHashTable.hh
+
+	Hash Table with Open Addressing - Inline Implementation
+
+	Copyright 2000-2015 by Pascal Francq (pascal@francq.info).
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Library General Public
+	License as published by the Free Software Foundation; either
+	version 2.0 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Library General Public License for more details.
+
+	You should have received a copy of the GNU Library General Public
+	License along with this library, as a file COPYING.LIB; if not, write
+	to the Free Software Foundation, Inc., 59 Temple Place, Suite 330,
+	Boston, MA  02111-1307  USA
+
+*/
+
+
+
+//------------------------------------------------------------------------------
+//
+// RHashTable<C,bAlloc>
+//
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+template<class C,bool bAlloc>
+	R::RHashTable<C,bAlloc>::RHashTable(size_t max)
+		: Slots(0), NbSlots(0), Mask(0), NbPtr(0), MaxPtr(0)
+{
+	Verify(max?max:8);
+}
+
+
+//------------------------------------------------------------------------------
+template<class C,bool bAlloc>
+	template<class TUse> size_t R::RHashTable<C,bAlloc>::Find(const TUse& tag,size_t hash) const
+{
+	// An element cannot be after a slot nearer from its ideal slot than the tag
+	Slot* Cur;
+	for(size_t Idx=hash&Mask,Dist=1;(Cur=&Slots[Idx])->Dist>=Dist;Idx=(Idx+1)&Mask,Dist++)
+		if((Cur->Hash==hash)&&(!Cur->Ptr->Compare(tag)))
+			return(Idx);
+	return(cNoRef);
+}
+
+
+//------------------------------------------------------------------------------
+template<class C,bool bAlloc>
+	void R::RHashTable<C,bAlloc>::Place(C* ptr,size_t hash)
+{
+	Slot Ins;
+	Ins.Ptr=ptr;
+	Ins.Hash=hash;
+	Ins.Dist=1;
+	for(size_t Idx=hash&Mask;;Idx=(Idx+1)&Mask,Ins.Dist++)
+	{
+		Slot& Cur(Slots[Idx]);
+		if(!Cur.Dist)
+		{
+			Cur=Ins;
+			break;
+		}
+
+		// The element to place is farther from its ideal slot: take the place
+		if(Cur.Dist<Ins.Dist)
+		{
+			Slot Tmp(Cur);
+			Cur=Ins;
+			Ins=Tmp;
+		}
+	}
+	NbPtr++;
+}
+
+
+//------------------------------------------------------------------------------
+template<class C,bool bAlloc>
+	void R::RHashTable<C,bAlloc>::Remove(size_t idx)
+{
+	// Shift backward the next elements until an empty slot or an element at its ideal slot
+	for(size_t Next=(idx+1)&Mask;Slots[Next].Dist>1;idx=Next,Next=(Next+1)&Mask)
+	{
+		Slots[idx]=Slots[Next];
+		Slots[idx].Dist--;
+	}
+	Slots[idx].Ptr=0;
+	Slots[idx].Dist=0;
+	NbPtr--;
+}
+
+
+//------------------------------------------------------------------------------
+template<class C,bool bAlloc>
+	void R::RHashTable<C,bAlloc>::ReHash(size_t nb)
+{
+	Slot* Old(Slots);
+	size_t OldNb(NbSlots);
+	Slots=new Slot[nb];
+	memset(Slots,0,nb*sizeof(Slot));
+	NbSlots=nb;
+	Mask=nb-1;
+	MaxPtr=(nb/5)*4;
+	NbPtr=0;
+	for(Slot* Cur=Old;OldNb--;Cur++)
+		if(Cur->Dist)
+			Place(Cur->Ptr,Cur->Hash);
+	delete[] Old;
+}
+
+
+//------------------------------------------------------------------------------
+template<class C,bool bAlloc>
+	void R::RHashTable<C,bAlloc>::Verify(size_t max)
+{
+	if(max<=MaxPtr)
+		return;
+	size_t Nb(NbSlots?NbSlots:8);
+	while((Nb/5)*4<max)
+		Nb<<=1;
+	ReHash(Nb);
+}
+
+
+//------------------------------------------------------------------------------
+template<class C,bool bAlloc>
+	void R::RHashTable<C,bAlloc>::Clear(void)
+{
+	for(Slot* Cur=Slots,*End=&Slots[NbSlots];Cur!=End;Cur++)
+	{
+		if(bAlloc&&Cur->Dist)
+			delete Cur->Ptr;
+		Cur->Ptr=0;
+		Cur->Dist=0;
+	}
+	NbPtr=0;
+}
+
+
+//------------------------------------------------------------------------------
+template<class C,bool bAlloc>
+	template<class TUse> C* R::RHashTable<C,bAlloc>::GetInsertPtr(const TUse& tag)
+{
+	size_t Hash(Mix(tag.HashCode(cNoRef)));
+	size_t Idx(Find(tag,Hash));
+	if(Idx!=cNoRef)
+		return(Slots[Idx].Ptr);
+	C* Ptr(new C(tag));
+	Verify(NbPtr+1);
+	Place(Ptr,Hash);
+	return(Ptr);
+}
+
+
+//------------------------------------------------------------------------------
+template<class C,bool bAlloc>
+	void R::RHashTable<C,bAlloc>::InsertPtr(C* ins,bool del)
+{
+	mReturnIfFail(ins);
+	size_t Hash(Mix(ins->HashCode(cNoRef)));
+	size_t Idx(Find(*ins,Hash));
+	if(Idx!=cNoRef)
+	{
+		if(del&&(Slots[Idx].Ptr!=ins))
+			delete Slots[Idx].Ptr;
+		Slots[Idx].Ptr=ins;
+		return;
+	}
+	Verify(NbPtr+1);
+	Place(ins,Hash);
+}
+
+
+//------------------------------------------------------------------------------
+template<class C,bool bAlloc>
+	template<class TUse> void R::RHashTable<C,bAlloc>::DeletePtr(const TUse& tag,bool del)
+{
+	size_t Idx(Find(tag,Mix(tag.HashCode(cNoRef))));
+	if(Idx==cNoRef)
+		return;
+	if(del)
+		delete Slots[Idx].Ptr;
+	Remove(Idx);
+}
+
+
+//------------------------------------------------------------------------------
+template<class C,bool bAlloc>
+	double R::RHashTable<C,bAlloc>::GetAvgDist(void) const
+{
+	if(!NbPtr)
+		return(0.0);
+	size_t Sum(0);
+	for(Slot* Cur=Slots,*End=&Slots[NbSlots];Cur!=End;Cur++)
+		if(Cur->Dist)
+			Sum+=Cur->Dist-1;
+	return(static_cast<double>(Sum)/static_cast<double>(NbPtr));
+}
+
+
+//------------------------------------------------------------------------------
+template<class C,bool bAlloc>
+	R::RHashTable<C,bAlloc>::~RHashTable(void)
+{
+	Clear();
+	delete[] Slots;
+}
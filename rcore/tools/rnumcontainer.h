@@ -39,6 +39,7 @@
 #include <rstd.h>
 #include <rrandom.h>
 #include <rstring.h>
+#include <rsort.h>
 
 
 //------------------------------------------------------------------------------
@@ -97,11 +98,23 @@ public:
 
 	/**
 	* Verify if the container can hold a certain number of elements. If not,
-	* the container is extended.
+	* the container is extended by the half of its current size (at least).
     * @param max             Number of elements that must be contained.
 	*/
 	void Verify(size_t max);
 
+	/**
+	* Reserve the memory for a given number of elements. Contrary to Verify,
+	* the container is not extended beyond this number.
+	* @param max             Number of elements.
+	*/
+	void Reserve(size_t max);
+
+	/**
+	* Release the memory not used by the container.
+	*/
+	void ShrinkToFit(void);
+
 	/**
 	 * Initialize the container with a given values.
 	 * @param nb             Number of elements.
@@ -181,9 +194,10 @@ public:
 private:
 
 	/**
-	 * Static function needed to order a list.
-	 */
-	static int ReOrderFunction(const void* num1, const void* num2);
+	* Change the size of the list. The new values are set to zero.
+	* @param max             New size of the list.
+	*/
+	void ReAlloc(size_t max);
 
 public:
 
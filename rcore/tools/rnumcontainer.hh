@@ -43,8 +43,9 @@ template<class I,bool bOrder>
 	NbInt = 0;
 	if(max<50)
 		MaxInt=100;
-	List = new I[MaxInt];
-	memset(List,0,MaxInt*sizeof(I));
+	List=static_cast<I*>(calloc(MaxInt,sizeof(I)));
+	if(!List)
+		throw std::bad_alloc();
 }
 
 
@@ -54,30 +55,62 @@ template<class I,bool bOrder>
 	: MaxInt(vec.MaxInt)
 {
 	NbInt = vec.NbInt;
-	List = new I[MaxInt];
+	List=static_cast<I*>(malloc(MaxInt*sizeof(I)));
+	if(!List)
+		throw std::bad_alloc();
 	memcpy(List,vec.List,vec.MaxInt*sizeof(I));
 }
 
 
+//------------------------------------------------------------------------------
+template<class I,bool bOrder>
+	void RNumContainer<I,bOrder>::ReAlloc(size_t max)
+{
+	// The values are numbers: the list can be reallocated
+	I* ptr(static_cast<I*>(realloc(List,max*sizeof(I))));
+	if(!ptr)
+		throw std::bad_alloc();
+	List=ptr;
+	if(max>MaxInt)
+		memset(&List[MaxInt],0,(max-MaxInt)*sizeof(I));
+	MaxInt=max;
+}
+
+
 //------------------------------------------------------------------------------
 template<class I,bool bOrder>
 	void RNumContainer<I,bOrder>::Verify(size_t max)
 {
 	if(max>=MaxInt)
 	{
-		size_t OldSize(MaxInt);
-		MaxInt+=(MaxInt/2);
-		if(max>MaxInt)
-			MaxInt=max;
-		I* ptr(new I[MaxInt]);
-		memcpy(ptr,List,OldSize*sizeof(I));
-		delete[] List;
-		List=ptr;
-		memset(&List[OldSize],0,(MaxInt-OldSize)*sizeof(I));
+		size_t NewSize(MaxInt+(MaxInt/2));
+		if(max>=NewSize)
+			NewSize=max+1;
+		ReAlloc(NewSize);
 	}
 }
 
 
+//------------------------------------------------------------------------------
+template<class I,bool bOrder>
+	void RNumContainer<I,bOrder>::Reserve(size_t max)
+{
+	if(max>MaxInt)
+		ReAlloc(max);
+}
+
+
+//------------------------------------------------------------------------------
+template<class I,bool bOrder>
+	void RNumContainer<I,bOrder>::ShrinkToFit(void)
+{
+	// At least one value is kept so that the list is never null
+	size_t Max(NbInt?NbInt:1);
+	if(Max<MaxInt)
+		ReAlloc(Max);
+}
+
+
 //------------------------------------------------------------------------------
 template<class I,bool bOrder>
 	void RNumContainer<I,bOrder>::Init(size_t nb,I val)
@@ -269,21 +302,12 @@ template<class I,bool bOrder>
 }
 
 
-//------------------------------------------------------------------------------
-template<class I,bool bOrder>
-	int RNumContainer<I,bOrder>::ReOrderFunction(const void* num1, const void* num2)
-{
-	const I *a=static_cast<const I*>(num1);
-	const I *b=static_cast<const I*>(num2);
-	return((*a)-(*b));
-}
-
-
 //------------------------------------------------------------------------------
 template<class I,bool bOrder>
 	void RNumContainer<I,bOrder>::ReOrder(void)
 {
-	qsort(static_cast<void*>(List),NbInt,sizeof(I),ReOrderFunction);
+	RSort<I,RSortNumber<I> > Engine;
+	Engine.Sort(List,NbInt);
 }
 
 
@@ -479,7 +503,7 @@ template<class I,bool bOrder>
 {
 	if(List)
 	{
-		delete[] List;
+		free(List);
 		List=0;
 	}
 }
@@ -35,6 +35,7 @@
 //-----------------------------------------------------------------------------
 // include files for R Project
 #include <ircontainer.h>
+#include <rsort.h>
 
 
 //-----------------------------------------------------------------------------
@@ -81,9 +82,8 @@ namespace R{
  *    Q.Order();
  * }
  * @endcode
- * @warning This implementation is slower than the qsort method of the C/C++
- * library. It is therefore only useful, if the comparison method between two
- * elements cannot not be implemented as a static method of the class C.
+ * The elements are sorted by R::RSort. Since the Compare method may use some
+ * data of the class, the sort is always done in the current thread.
  * @short Quicksort template.
 */
 template<class C> class RQuickSort
@@ -98,6 +98,17 @@ template<class C> class RQuickSort
 	 */
 	size_t Max;
 
+	/**
+	 * Function object calling the Compare method.
+	 */
+	class Comparison
+	{
+		RQuickSort<C>* Owner;
+	public:
+		Comparison(RQuickSort<C>* owner) : Owner(owner) {}
+		inline int operator()(C* obj1,C* obj2) const {return(Owner->Compare(obj1,obj2));}
+	};
+
 public:
 
 	/**
@@ -126,22 +137,6 @@ private:
 	 */
 	virtual int Compare(C* obj1,C* obj2);
 
-	/**
-	 * Manage a partition.
-	 * @param left           First element.
-	 * @param right          Last element.
-	 * @param pivotIndex     Index of the pivot.
-	 * @return Index of the last element sorted before the pivot.
-	 */
-	size_t Partition(size_t left,size_t  right,size_t  pivotIndex);
-
-	/**
-	 * Do a quicksort.
-	 * @param left           First element.
-	 * @param right          Second element.
-	 */
-	void Quicksort(size_t left, size_t right);
-
 public:
 
 	/**
@@ -149,9 +144,8 @@ public:
 	 */
 	inline void Order(void)
 	{
-		if(!Max)
-			return;
-		Quicksort(0,Max-1);
+		RSort<C*,Comparison> Engine(Comparison(this),1);
+		Engine.Sort(Tab,Max);
 	}
 
 	/**
@@ -163,9 +157,7 @@ public:
 	{
 		Tab=tab;
 		Max=max;
-		if(!Max)
-			return;
-		Quicksort(0,Max-1);
+		Order();
 	}
 
 	/**
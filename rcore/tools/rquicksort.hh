@@ -58,49 +58,6 @@ template<class C>
 }
 
 
-//-----------------------------------------------------------------------------
-template<class C>
-	size_t RQuickSort<C>::Partition(size_t left,size_t  right,size_t  pivotIndex)
-{
-	C** pivotPtr(&Tab[pivotIndex]);
-	C** rightPtr(&Tab[right]);
-	C* pivot(*pivotPtr);
-	(*pivotPtr)=(*rightPtr);
-	(*rightPtr)=pivot;
-	size_t storeIndex(left);
-	C** iPtr(&Tab[left]);
-	C** Store(iPtr);
-	for(size_t i=left;i<right;i++,iPtr++)
-	{
-		if(Compare(pivot,*iPtr)>0)
-		{
-			C* tmp(*iPtr);
-			storeIndex++;
-			(*iPtr)=(*Store);
-			(*Store)=tmp;
-			Store++;
-		}
-	}
-	C* tmp(*rightPtr);
-	(*rightPtr)=(*Store);
-	(*Store)=tmp;
-	return(storeIndex);
-}
-
-
-//-----------------------------------------------------------------------------
-template<class C>
-	void RQuickSort<C>::Quicksort(size_t left, size_t right)
-{
-	if(right<=left) return;
-	size_t pivotIndex(left);
-	size_t pivotNewIndex(Partition(left,right,pivotIndex));
-	if(pivotNewIndex)
-		Quicksort(left, pivotNewIndex - 1);
-	Quicksort(pivotNewIndex + 1, right);
-}
-
-
 //-----------------------------------------------------------------------------
 template<class C>
 	RQuickSort<C>::~RQuickSort(void)
@@ -0,0 +1,362 @@
+/*
+
+	R Project Library
+
+	RSort.h
+
+	Sort Engine - Header
+
+	Copyright 1999-2015 by Pascal Francq (pascal@francq.info).
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Library General Public
+	License as published by the Free Software Foundation; either
+	version 2.0 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Library General Public License for more details.
+
+	You should have received a copy of the GNU Library General Public
+	License along with this library, as a file COPYING.LIB; if not, write
+	to the Free Software Foundation, Inc., 59 Temple Place, Suite 330,
+	Boston, MA  02111-1307  USA
+
+*/
+
+
+
+//-----------------------------------------------------------------------------
+#ifndef RSortH
+#define RSortH
+
+
+//------------------------------------------------------------------------------
+// include files for POSIX
+#include <pthread.h>
+#include <unistd.h>
+
+
+//-----------------------------------------------------------------------------
+// include files for R Project
+#include <rstd.h>
+
+
+//-----------------------------------------------------------------------------
+namespace R{
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+/**
+* The RSort class provides a sort engine for arrays of elements of type T
+* (pointers or numbers). It implements the "pattern-defeating quicksort": the
+* small parts are sorted with an insertion sort, the pivot is the median of
+* three elements (or of three medians for the large parts), the already
+* sorted parts are detected, the many equal elements are grouped in one
+* partition, and a heap sort is used when too many partitions are
+* unbalanced. The sort is therefore never quadratic.
+*
+* The comparisons are done by a function object (cCompare) which is called
+* directly, and can therefore be inlined:
+* @code
+* int operator()(const T& a,const T& b) const;
+* @endcode
+* It works like the strcmp function: it returns a negative value if a must be
+* sorted before b, 0 if they are equal and a positive value if a must be
+* sorted after b. The classes RSortPtr, RSortNumber, RSortFunction and
+* RSortStatic provide the most common comparisons.
+*
+* By default, the sort is done by the calling thread. If several threads are
+* explicitly asked, the large parts (at least cParallelSort elements) are
+* split: once a part is partitioned, one of the sub-parts is sorted by a new
+* thread. The comparisons must then be thread-safe, and they should not throw
+* exceptions.
+*
+* Here is an example:
+* @code
+* #include <rsort.h>
+* using namespace R;
+*
+* int main()
+* {
+*    double Values[]={3.0,1.0,2.0};
+*    RSort<double,RSortNumber<double> > Sort;
+*    Sort.Sort(Values,3);
+* }
+* @endcode
+* @tparam T                  Type of the elements.
+* @tparam cCompare           Function object used to compare two elements.
+* @short Sort Engine.
+*/
+template<class T,class cCompare>
+	class RSort
+{
+	/**
+	* Task of a thread sorting a part of the array.
+	*/
+	class Task
+	{
+	public:
+		RSort* Engine;         // Engine.
+		T* Begin;              // First element.
+		T* End;                // Element after the last one.
+		size_t Bad;            // Number of unbalanced partitions still allowed.
+		bool LeftMost;         // Is the part the left most one?
+		size_t Depth;          // Number of times the sort can be split again.
+
+		Task(RSort* engine,T* begin,T* end,size_t bad,bool leftmost,size_t depth)
+			: Engine(engine), Begin(begin), End(end), Bad(bad), LeftMost(leftmost), Depth(depth) {}
+	};
+
+	/**
+	* Function object used for the comparisons.
+	*/
+	cCompare Comp;
+
+	/**
+	* Number of times that the sort can be split between two threads.
+	*/
+	size_t MaxDepth;
+
+public:
+
+	/**
+	* Parts smaller than this size are sorted with an insertion sort.
+	*/
+	static const size_t cInsertionSort=24;
+
+	/**
+	* Parts larger than this size use the median of three medians as pivot.
+	*/
+	static const size_t cNinther=128;
+
+	/**
+	* Minimum size of a part to be sorted by several threads.
+	*/
+	static const size_t cParallelSort=65536;
+
+	/**
+	* Construct the sort engine.
+	* @param comp            Function object used for the comparisons.
+	* @param nbthreads       Maximum number of threads used to sort large
+	*                        arrays. If null, the number of processors is used.
+	*                        By default, no thread is created.
+	*/
+	RSort(const cCompare& comp=cCompare(),size_t nbthreads=1);
+
+	/**
+	* Sort an array.
+	* @param tab             Array.
+	* @param nb              Number of elements.
+	*/
+	void Sort(T* tab,size_t nb);
+
+private:
+
+	/**
+	* Look if an element must be placed before another one.
+	* @param a               First element.
+	* @param b               Second element.
+	*/
+	inline bool Less(const T& a,const T& b) const {return(Comp(a,b)<0);}
+
+	/**
+	* Exchange two elements.
+	* @param a               First element.
+	* @param b               Second element.
+	*/
+	static inline void Swap(T& a,T& b) {T tmp(a); a=b; b=tmp;}
+
+	/**
+	* Order three elements.
+	* @param a               First element.
+	* @param b               Second element.
+	* @param c               Third element.
+	*/
+	inline void Sort3(T* a,T* b,T* c) const
+	{
+		if(Less(*b,*a))
+			Swap(*a,*b);
+		if(Less(*c,*b))
+		{
+			Swap(*b,*c);
+			if(Less(*b,*a))
+				Swap(*a,*b);
+		}
+	}
+
+	/**
+	* Sort a part with an insertion sort.
+	* @param begin           First element.
+	* @param end             Element after the last one.
+	*/
+	void InsertionSort(T* begin,T* end) const;
+
+	/**
+	* Try to sort a part with an insertion sort. The sort is stopped if too
+	* many elements must be moved.
+	* @param begin           First element.
+	* @param end             Element after the last one.
+	* @return true if the part is sorted.
+	*/
+	bool PartialInsertionSort(T* begin,T* end) const;
+
+	/**
+	* Sort a part with a heap sort.
+	* @param begin           First element.
+	* @param end             Element after the last one.
+	*/
+	void HeapSort(T* begin,T* end) const;
+
+	/**
+	* Partition a part around its first element: the elements equal to the
+	* pivot are placed at its right.
+	* @param begin           First element.
+	* @param end             Element after the last one.
+	* @param partitioned     Set to true if the part was already partitioned.
+	* @return the position of the pivot.
+	*/
+	T* PartitionRight(T* begin,T* end,bool& partitioned) const;
+
+	/**
+	* Partition a part around its first element: the elements equal to the
+	* pivot are placed at its left.
+	* @param begin           First element.
+	* @param end             Element after the last one.
+	* @return the position of the pivot.
+	*/
+	T* PartitionLeft(T* begin,T* end) const;
+
+	/**
+	* Sort a part and wait for the threads created.
+	* @param begin           First element.
+	* @param end             Element after the last one.
+	* @param bad             Number of unbalanced partitions allowed.
+	* @param leftmost        Is the part the left most one? If not, the
+	*                        element before the part is not greater than its
+	*                        elements.
+	* @param depth           Number of times that the sort can be split.
+	*/
+	void Sort(T* begin,T* end,size_t bad,bool leftmost,size_t depth);
+
+	/**
+	* Function run by a thread.
+	* @param param           Task.
+	*/
+	static void* Run(void* param);
+};
+
+
+//-----------------------------------------------------------------------------
+/**
+* The RSortPtr class compares two pointers with the Compare method of the
+* elements. A null pointer is placed before the other ones.
+* @tparam C                  Class of the elements.
+* @short Pointer Comparison.
+*/
+template<class C>
+	class RSortPtr
+{
+public:
+	/**
+	* Compare two pointers.
+	* @param a               First pointer.
+	* @param b               Second pointer.
+	*/
+	inline int operator()(const C* a,const C* b) const
+	{
+		if(!a)
+			return(b?-1:0);
+		if(!b)
+			return(1);
+		return(a->Compare(*b));
+	}
+};
+
+
+//-----------------------------------------------------------------------------
+/**
+* The RSortNumber class compares two numbers in ascending order.
+* @tparam I                  Type of the numbers.
+* @short Number Comparison.
+*/
+template<class I>
+	class RSortNumber
+{
+public:
+	/**
+	* Compare two numbers.
+	* @param a               First number.
+	* @param b               Second number.
+	*/
+	inline int operator()(const I& a,const I& b) const {return((a<b)?-1:((b<a)?1:0));}
+};
+
+
+//-----------------------------------------------------------------------------
+/**
+* The RSortFunction class compares two elements with a function having the
+* signature used by the qsort function of the C library (it receives pointers
+* to the elements).
+* @tparam T                  Type of the elements.
+* @short Function Comparison.
+*/
+template<class T>
+	class RSortFunction
+{
+	/**
+	* Function.
+	*/
+	int (*Function)(const void*,const void*);
+
+public:
+
+	/**
+	* Construct the comparison.
+	* @param function        Function.
+	*/
+	RSortFunction(int (*function)(const void*,const void*)) : Function(function) {}
+
+	/**
+	* Compare two elements.
+	* @param a               First element.
+	* @param b               Second element.
+	*/
+	inline int operator()(const T& a,const T& b) const {return(Function(&a,&b));}
+};
+
+
+//-----------------------------------------------------------------------------
+/**
+* The RSortStatic class compares two elements with a given function having the
+* signature used by the qsort function of the C library. Contrary to
+* RSortFunction, the function is known at compile time and can be inlined.
+* @tparam T                  Type of the elements.
+* @tparam Function           Function.
+* @short Static Function Comparison.
+*/
+template<class T,int (*Function)(const void*,const void*)>
+	class RSortStatic
+{
+public:
+	/**
+	* Compare two elements.
+	* @param a               First element.
+	* @param b               Second element.
+	*/
+	inline int operator()(const T& a,const T& b) const {return(Function(&a,&b));}
+};
+
+
+//-----------------------------------------------------------------------------
+// Template implementation
+#include <rsort.hh>
+
+
+}  //-------- End of namespace R ----------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+#endif
@@ -0,0 +1,332 @@
+/*
+
+	R Project Library
+
+	RSort.hh
+
+	Sort Engine - Inline Implementation
+
+	Copyright 1999-2015 by Pascal Francq (pascal@francq.info).
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Library General Public
+	License as published by the Free Software Foundation; either
+	version 2.0 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Library General Public License for more details.
+
+	You should have received a copy of the GNU Library General Public
+	License along with this library, as a file COPYING.LIB; if not, write
+	to the Free Software Foundation, Inc., 59 Temple Place, Suite 330,
+	Boston, MA  02111-1307  USA
+
+*/
+
+
+
+//-----------------------------------------------------------------------------
+//
+// RSort<T,cCompare>
+//
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+template<class T,class cCompare>
+	R::RSort<T,cCompare>::RSort(const cCompare& comp,size_t nbthreads)
+		: Comp(comp), MaxDepth(0)
+{
+	if(!nbthreads)
+	{
+		long Nb(sysconf(_SC_NPROCESSORS_ONLN));
+		nbthreads=(Nb>0)?static_cast<size_t>(Nb):1;
+	}
+	while(nbthreads>>=1)
+		MaxDepth++;
+}
+
+
+//-----------------------------------------------------------------------------
+template<class T,class cCompare>
+	void R::RSort<T,cCompare>::Sort(T* tab,size_t nb)
+{
+	if((!tab)||(nb<2))
+		return;
+
+	// The number of unbalanced partitions allowed is log2(nb)
+	size_t Bad(0);
+	for(size_t i=nb;i>>=1;)
+		Bad++;
+	Sort(tab,tab+nb,Bad,true,MaxDepth);
+}
+
+
+//-----------------------------------------------------------------------------
+template<class T,class cCompare>
+	void R::RSort<T,cCompare>::InsertionSort(T* begin,T* end) const
+{
+	if(begin==end)
+		return;
+	for(T* Cur=begin+1;Cur!=end;Cur++)
+	{
+		T* Sift(Cur);
+		T* Prev(Cur-1);
+		if(Less(*Sift,*Prev))
+		{
+			T Tmp(*Sift);
+			do
+				*(Sift--)=*Prev;
+			while((Sift!=begin)&&Less(Tmp,*(--Prev)));
+			*Sift=Tmp;
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------
+template<class T,class cCompare>
+	bool R::RSort<T,cCompare>::PartialInsertionSort(T* begin,T* end) const
+{
+	if(begin==end)
+		return(true);
+	size_t Moved(0);
+	for(T* Cur=begin+1;Cur!=end;Cur++)
+	{
+		T* Sift(Cur);
+		T* Prev(Cur-1);
+		if(Less(*Sift,*Prev))
+		{
+			T Tmp(*Sift);
+			do
+				*(Sift--)=*Prev;
+			while((Sift!=begin)&&Less(Tmp,*(--Prev)));
+			*Sift=Tmp;
+			Moved+=Cur-Sift;
+			if(Moved>8)
+				return(false);
+		}
+	}
+	return(true);
+}
+
+
+//-----------------------------------------------------------------------------
+template<class T,class cCompare>
+	void R::RSort<T,cCompare>::HeapSort(T* begin,T* end) const
+{
+	size_t Nb(end-begin);
+
+	// Build the heap, then move its root at the end of the part
+	for(size_t i=Nb/2;i;)
+	{
+		i--;
+		T Tmp(begin[i]);
+		size_t Pos(i),Child;
+		while((Child=2*Pos+1)<Nb)
+		{
+			if((Child+1<Nb)&&Less(begin[Child],begin[Child+1]))
+				Child++;
+			if(!Less(Tmp,begin[Child]))
+				break;
+			begin[Pos]=begin[Child];
+			Pos=Child;
+		}
+		begin[Pos]=Tmp;
+	}
+	while(Nb>1)
+	{
+		Nb--;
+		T Tmp(begin[Nb]);
+		begin[Nb]=begin[0];
+		size_t Pos(0),Child;
+		while((Child=2*Pos+1)<Nb)
+		{
+			if((Child+1<Nb)&&Less(begin[Child],begin[Child+1]))
+				Child++;
+			if(!Less(Tmp,begin[Child]))
+				break;
+			begin[Pos]=begin[Child];
+			Pos=Child;
+		}
+		begin[Pos]=Tmp;
+	}
+}
+
+
+//-----------------------------------------------------------------------------
+template<class T,class cCompare>
+	T* R::RSort<T,cCompare>::PartitionRight(T* begin,T* end,bool& partitioned) const
+{
+	T Pivot(*begin);
+	T* First(begin);
+	T* Last(end);
+
+	// The median selection ensures that an element not lesser than the pivot
+	// ends the part
+	while(Less(*(++First),Pivot)) ;
+	if(First-1==begin)
+		while((First<Last)&&(!Less(*(--Last),Pivot))) ;
+	else
+		while(!Less(*(--Last),Pivot)) ;
+
+	// If the first pair is not inverted, the part was already partitioned
+	partitioned=(First>=Last);
+	while(First<Last)
+	{
+		Swap(*First,*Last);
+		while(Less(*(++First),Pivot)) ;
+		while(!Less(*(--Last),Pivot)) ;
+	}
+
+	T* Pos(First-1);
+	*begin=*Pos;
+	*Pos=Pivot;
+	return(Pos);
+}
+
+
+//-----------------------------------------------------------------------------
+template<class T,class cCompare>
+	T* R::RSort<T,cCompare>::PartitionLeft(T* begin,T* end) const
+{
+	T Pivot(*begin);
+	T* First(begin);
+	T* Last(end);
+
+	while(Less(Pivot,*(--Last))) ;
+	if(Last+1==end)
+		while((First<Last)&&(!Less(Pivot,*(++First)))) ;
+	else
+		while(!Less(Pivot,*(++First))) ;
+	while(First<Last)
+	{
+		Swap(*First,*Last);
+		while(Less(Pivot,*(--Last))) ;
+		while(!Less(Pivot,*(++First))) ;
+	}
+
+	*begin=*Last;
+	*Last=Pivot;
+	return(Last);
+}
+
+
+//-----------------------------------------------------------------------------
+template<class T,class cCompare>
+	void R::RSort<T,cCompare>::Sort(T* begin,T* end,size_t bad,bool leftmost,size_t depth)
+{
+	pthread_t Threads[8*sizeof(size_t)];
+	Task* Tasks[8*sizeof(size_t)];
+	size_t NbThreads(0);
+
+	while(true)
+	{
+		size_t Size(end-begin);
+		if(Size<cInsertionSort)
+		{
+			InsertionSort(begin,end);
+			break;
+		}
+
+		// Choose the pivot and put it at the beginning of the part
+		size_t Half(Size/2);
+		if(Size>cNinther)
+		{
+			Sort3(begin,begin+Half,end-1);
+			Sort3(begin+1,begin+(Half-1),end-2);
+			Sort3(begin+2,begin+(Half+1),end-3);
+			Sort3(begin+(Half-1),begin+Half,begin+(Half+1));
+			Swap(*begin,begin[Half]);
+		}
+		else
+			Sort3(begin+Half,begin,end-1);
+
+		// If the element before the part is equal to the pivot, all the
+		// elements equal to the pivot are grouped and do not need to be sorted
+		if((!leftmost)&&(!Less(*(begin-1),*begin)))
+		{
+			begin=PartitionLeft(begin,end)+1;
+			continue;
+		}
+
+		bool Partitioned;
+		T* Pivot(PartitionRight(begin,end,Partitioned));
+		size_t LeftSize(Pivot-begin);
+		size_t RightSize(end-(Pivot+1));
+
+		if((LeftSize<Size/8)||(RightSize<Size/8))
+		{
+			// Too many unbalanced partitions: the input is adversarial
+			if(!(--bad))
+			{
+				HeapSort(begin,end);
+				break;
+			}
+
+			// Break the patterns that lead to bad pivots
+			if(LeftSize>=cInsertionSort)
+			{
+				Swap(begin[0],begin[LeftSize/4]);
+				Swap(Pivot[-1],begin[LeftSize-LeftSize/4]);
+				if(LeftSize>cNinther)
+				{
+					Swap(begin[1],begin[LeftSize/4+1]);
+					Swap(begin[2],begin[LeftSize/4+2]);
+					Swap(Pivot[-2],begin[LeftSize-(LeftSize/4+1)]);
+					Swap(Pivot[-3],begin[LeftSize-(LeftSize/4+2)]);
+				}
+			}
+			if(RightSize>=cInsertionSort)
+			{
+				Swap(Pivot[1],Pivot[1+RightSize/4]);
+				Swap(end[-1],end[-static_cast<ptrdiff_t>(RightSize/4)]);
+				if(RightSize>cNinther)
+				{
+					Swap(Pivot[2],Pivot[2+RightSize/4]);
+					Swap(Pivot[3],Pivot[3+RightSize/4]);
+					Swap(end[-2],end[-static_cast<ptrdiff_t>(1+RightSize/4)]);
+					Swap(end[-3],end[-static_cast<ptrdiff_t>(2+RightSize/4)]);
+				}
+			}
+		}
+		else if(Partitioned&&PartialInsertionSort(begin,Pivot)&&PartialInsertionSort(Pivot+1,end))
+			break;
+
+		// Sort the left part (eventually in another thread) and continue with the right one
+		if(depth&&(LeftSize>=cParallelSort)&&(RightSize>=cParallelSort))
+		{
+			depth--;
+			Task* Cur(new Task(this,begin,Pivot,bad,leftmost,depth));
+			if(pthread_create(&Threads[NbThreads],0,Run,Cur))
+			{
+				delete Cur;
+				Sort(begin,Pivot,bad,leftmost,depth);
+			}
+			else
+				Tasks[NbThreads++]=Cur;
+		}
+		else
+			Sort(begin,Pivot,bad,leftmost,depth);
+		begin=Pivot+1;
+		leftmost=false;
+	}
+
+	// Wait for the threads sorting the left parts
+	for(size_t i=0;i<NbThreads;i++)
+	{
+		pthread_join(Threads[i],0);
+		delete Tasks[i];
+	}
+}
+
+
+//-----------------------------------------------------------------------------
+template<class T,class cCompare>
+	void* R::RSort<T,cCompare>::Run(void* param)
+{
+	Task* Cur(static_cast<Task*>(param));
+	Cur->Engine->Sort(Cur->Begin,Cur->End,Cur->Bad,Cur->LeftMost,Cur->Depth);
+	return(0);
+}
@@ -90,6 +90,7 @@ void RXMLFile::Open(RIO::ModeType mode)
 	switch(mode)
 	{
 		case RIO::Read:
+		case RIO::ReadMapped:
 			CurTag=0;
 			CurAttr=0;
 			if(!XMLStruct)
@@ -306,7 +306,7 @@ void RXMLParser::StopAnalysis(void)
 //------------------------------------------------------------------------------
 size_t RXMLParser::GetCurrentDepth(void) const
 {
-	if(Mode!=RIO::Read)
+	if((Mode!=RIO::Read)&&(Mode!=RIO::ReadMapped))
 		mThrowRIOException(this,"File not in read mode");
 	return(CurDepth);
 }
@@ -315,7 +315,7 @@ size_t RXMLParser::GetCurrentDepth(void) const
 //------------------------------------------------------------------------------
 size_t RXMLParser::GetLastTokenPos(void) const
 {
-	if(Mode!=RIO::Read)
+	if((Mode!=RIO::Read)&&(Mode!=RIO::ReadMapped))
 		mThrowRIOException(this,"File not in read mode");
 	return(LastTokenPos);
 }
@@ -364,6 +364,7 @@ void RXMLParser::Open(RIO::ModeType mode)
 	switch(Mode)
 	{
 		case RIO::Read:
+		case RIO::ReadMapped:
 			CurDepth=0;
 			LoadHeader();
 			if(Break)
@@ -51,20 +51,21 @@ const off_t ValRec=sizeof(double)+2*sizeof(size_t)+2*sizeof(off_t);
 
 //------------------------------------------------------------------------------
 RMatrixStorage::RMatrixStorage(void)
-	: File1(), File2(), Index(), BaseURI(), NbLines(0), NbCols(0)
+	: File1(), File2(), Index(), BaseURI(), NbLines(0), NbCols(0), ReadOnly(false)
 {
 }
 
 
 //------------------------------------------------------------------------------
-void RMatrixStorage::Open(const RString& baseuri,RGenericMatrix::tType type)
+void RMatrixStorage::Open(const RString& baseuri,RGenericMatrix::tType type,bool readonly)
 {
 	BaseURI=baseuri;
 	Type=type;
+	ReadOnly=readonly;
+	RIO::ModeType Mode(ReadOnly?RIO::ReadMapped:RIO::ReadWrite);
 
 	// Open the Index
-	Index.Open(BaseURI+".info",RIO::ReadWrite);
-	Index.Seek(0);
+	Index.Open(BaseURI+".info",Mode);
 	if(!Index.End())
 		Index>>NbLines>>NbCols;
 
@@ -72,28 +73,28 @@ void RMatrixStorage::Open(const RString& baseuri,RGenericMatrix::tType type)
 	switch(Type)
 	{
 		case RGenericMatrix::tNormal:
-			File1.Open(BaseURI+".lower",RIO::ReadWrite);
-			File2.Open(BaseURI+".upper",RIO::ReadWrite);
+			File1.Open(BaseURI+".lower",Mode);
+			File2.Open(BaseURI+".upper",Mode);
 			Upper=true;
 			Sparse=false;
 			Max=false;
 			break;
 		case RGenericMatrix::tLowerTriangular:
 		case RGenericMatrix::tSymmetric:
-			File1.Open(BaseURI+".lower",RIO::ReadWrite);
+			File1.Open(BaseURI+".lower",Mode);
 			Upper=false;
 			Sparse=false;
 			Max=false;
 			break;
 		case RGenericMatrix::tSparse:
 		case RGenericMatrix::tSparseSymmetric:
-			File1.Open(BaseURI+".rec",RIO::ReadWrite);
+			File1.Open(BaseURI+".rec",Mode);
 			Upper=false;
 			Sparse=true;
 			Max=false;
 			break;
 		case RGenericMatrix::tMax:
-			File1.Open(BaseURI+".rec",RIO::ReadWrite);
+			File1.Open(BaseURI+".rec",Mode);
 			Upper=false;
 			Sparse=false;
 			Max=true;
@@ -109,8 +110,11 @@ void RMatrixStorage::Close(void)
 {
 	File1.Close();
 	File2.Close();
-	Index.Seek(0);
-	Index<<NbLines<<NbCols;
+	if(!ReadOnly)
+	{
+		Index.Seek(0);
+		Index<<NbLines<<NbCols;
+	}
 	Index.Close();
 	BaseURI=RString::Null;
 	NbLines=0;
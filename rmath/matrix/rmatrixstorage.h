@@ -146,6 +146,11 @@ class RMatrixStorage
 	 */
 	bool Max;
 
+	/**
+	 * The storage is opened in read-only mode ?
+	 */
+	bool ReadOnly;
+
 public:
 
 	/**
@@ -154,11 +159,13 @@ public:
 	RMatrixStorage(void);
 
 	/**
-	 * Open the storage.
+	 * Open the storage. In read-only mode, the files are mapped in memory (see
+	 * RIO::ReadMapped) and the storage cannot be modified.
 	 * @param baseuri        Base URI.
 	 * @param type           Type of the matrix.
+	 * @param readonly       Open the storage in read-only mode ?
 	 */
-	void Open(const RString& baseuri,RGenericMatrix::tType type);
+	void Open(const RString& baseuri,RGenericMatrix::tType type,bool readonly=false);
 
 	/**
 	 * Close the storage.
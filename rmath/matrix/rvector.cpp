@@ -85,11 +85,7 @@ void RVector::ReSize(size_t size,double val)
 	if(size>MaxInt)
 	{
 		size_t OldSize(MaxInt);
-		MaxInt=size;
-		double* ptr(new double[MaxInt]);
-		memcpy(ptr,List,OldSize*sizeof(double));
-		delete[] List;
-		List=ptr;
+		Reserve(size);
 		RNumCursor<double> Vec1(*this);
 		Vec1.Start();
 		for(Vec1.GoTo(OldSize);!Vec1.End();Vec1.Next())
@@ -36,6 +36,7 @@
 //------------------------------------------------------------------------------
 // include files for R Project
 #include <rga.h>
+#include <rnumcontainer.h>
 
 
 //------------------------------------------------------------------------------
@@ -75,6 +76,15 @@ public:
 	*/
 	bool ToEval;
 
+protected:
+
+	/**
+	* Random number generator of the "thread-dependent" data of the chromosome.
+	*/
+	RRandom* thRandom;
+
+public:
+
 	/** Construct the chromosome.
 	* @param inst           Pointer to the instance.
 	* @param id             Identifier of the chromosome.
@@ -93,6 +103,23 @@ public:
 	*/
 	virtual void Init(cThreadData* thData);
 
+	/**
+	* Return a number in the interval [0,max[ using the random generator of
+	* the "thread-dependent" data. The genetic operators should use this method
+	* rather than the one of the instance.
+	* @param max            Variable used to calculate the number.
+	*/
+	long RRand(long max) {return(thRandom->GetValue(max));}
+
+	/**
+	* Random the position of elements of a vector using the random generator
+	* of the "thread-dependent" data.
+	* @param array          A pointer to the array representing the vector.
+	* @param size           The size of the vector.
+	*/
+	template<class T> inline void RandOrder(T* array,size_t size)
+		{thRandom->RandOrder<T>(array,size);}
+
 	/**
 	* Construct a valid solution.
 	*/
@@ -147,6 +174,39 @@ public:
 	*/
 	virtual void Copy(const cChromo &chromo);
 
+	/**
+	* Compute a hash code of the genotype of the chromosome. It is used by the
+	* fitness cache of the instance (see RInst::SetFitnessCache) to find the
+	* evaluations stored, which are then compared with SaveGenotype. By
+	* default, the method returns 0, which means that the chromosome cannot be
+	* cached.
+	*/
+	virtual size_t HashGenotype(void) {return(0);}
+
+	/**
+	* Save a canonical representation of the genotype of the chromosome: two
+	* chromosomes with the same representation must have the same
+	* evaluation. It is stored in the fitness cache to distinguish the
+	* genotypes having the same hash code, and must therefore be overloaded
+	* with HashGenotype.
+	* @param genotype       Representation to fill.
+	*/
+	virtual void SaveGenotype(RNumContainer<size_t,false>& /*genotype*/) {}
+
+	/**
+	* Save the results of the evaluation of the chromosome, except its fitness,
+	* that must be stored in the fitness cache.
+	* @param values         Values to fill.
+	*/
+	virtual void SaveEvaluation(RNumContainer<double,false>& /*values*/) const {}
+
+	/**
+	* Restore the results of the evaluation of the chromosome, except its
+	* fitness, found in the fitness cache.
+	* @param values         Values saved by SaveEvaluation.
+	*/
+	virtual void RestoreEvaluation(const RNumContainer<double,false>& /*values*/) {}
+
 	/**
 	* Destruct the chromosome.
 	*/
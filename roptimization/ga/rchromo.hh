@@ -37,7 +37,7 @@
 //------------------------------------------------------------------------------
 template<class cInst,class cChromo,class cFit,class cThreadData>
 	R::RChromo<cInst,cChromo,cFit,cThreadData>::RChromo(cInst *inst,size_t id)
-		: Instance(inst),Id(id),ToEval(true)
+		: Instance(inst),Id(id),ToEval(true),thRandom(0)
 {
 	Fitness=new cFit();
 }
@@ -45,8 +45,9 @@ template<class cInst,class cChromo,class cFit,class cThreadData>
 
 //------------------------------------------------------------------------------
 template<class cInst,class cChromo,class cFit,class cThreadData>
-	void R::RChromo<cInst,cChromo,cFit,cThreadData>::Init(cThreadData*)
+	void R::RChromo<cInst,cChromo,cFit,cThreadData>::Init(cThreadData* thData)
 {
+	thRandom=thData->Random;
 }
 
 
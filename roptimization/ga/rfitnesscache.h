@@ -0,0 +1,211 @@
+/*
+
+	R Project Library
+
+	RFitnessCache.h
+
+	Cache of Fitnesses - Header
+
+	Copyright 1998-2015 by Pascal Francq (pascal@francq.info).
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Library General Public
+	License as published by the Free Software Foundation; either
+	version 2.0 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Library General Public License for more details.
+
+	You should have received a copy of the GNU Library General Public
+	License along with this library, as a file COPYING.LIB; if not, write
+	to the Free Software Foundation, Inc., 59 Temple Place, Suite 330,
+	Boston, MA  02111-1307  USA
+
+*/
+
+
+
+//------------------------------------------------------------------------------
+#ifndef RFitnessCache_H
+#define RFitnessCache_H
+
+
+//------------------------------------------------------------------------------
+// include files for R Project
+#include <rga.h>
+#include <rnumcontainer.h>
+
+
+//------------------------------------------------------------------------------
+namespace R{
+//------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------
+/**
+* The RFitnessCache class provides a cache of the evaluations of chromosomes.
+* An evaluation is found by the hash code of the genotype of the chromosome
+* (see RChromo::HashGenotype) and identified by a canonical representation of
+* this genotype (see RChromo::SaveGenotype), so that two genotypes with the
+* same hash code never share their evaluation. It is made of the fitness and
+* of a list of values specific to the chromosome (see
+* RChromo::SaveEvaluation).
+*
+* The number of evaluations stored is bounded: when the cache is full, the
+* least recently used evaluation is replaced. The entries are allocated once
+* by the constructor.
+* @tparam cFit               Fitness.
+* @short Fitness Cache.
+*/
+template<class cFit>
+	class RFitnessCache
+{
+	/**
+	* An evaluation stored in the cache.
+	*/
+	class Entry
+	{
+	public:
+		size_t Hash;                           // Hash code of the genotype.
+		RNumContainer<size_t,false> Genotype;  // Representation of the genotype.
+		cFit Fitness;                          // Fitness.
+		RNumContainer<double,false> Values;    // Values of the chromosome.
+		Entry* Prev;                           // Entry used more recently.
+		Entry* Next;                           // Entry used less recently.
+		Entry* Collision;                      // Next entry in the same bucket.
+
+		Entry(void) : Hash(0), Genotype(10), Fitness(), Values(10), Prev(0), Next(0), Collision(0) {}
+	};
+
+	/**
+	* Entries of the cache.
+	*/
+	Entry* Entries;
+
+	/**
+	* Maximal number of entries.
+	*/
+	size_t MaxEntries;
+
+	/**
+	* Number of entries used.
+	*/
+	size_t NbEntries;
+
+	/**
+	* Buckets of the hash table (their number is a power of two).
+	*/
+	Entry** Buckets;
+
+	/**
+	* Mask to apply on a hash code to find its bucket.
+	*/
+	size_t Mask;
+
+	/**
+	* Entry most recently used.
+	*/
+	Entry* First;
+
+	/**
+	* Entry least recently used.
+	*/
+	Entry* Last;
+
+	/**
+	* Number of evaluations found.
+	*/
+	size_t NbHits;
+
+	/**
+	* Number of evaluations not found.
+	*/
+	size_t NbMisses;
+
+public:
+
+	/**
+	* Construct the cache.
+	* @param max             Maximal number of evaluations stored.
+	*/
+	RFitnessCache(size_t max);
+
+	/**
+	* Clear the cache (the counters are not reset).
+	*/
+	void Clear(void);
+
+	/**
+	* Look for an evaluation. If found, it becomes the most recently used one.
+	* @param hash            Hash code of the genotype.
+	* @param genotype        Representation of the genotype.
+	* @param fitness         Fitness to assign.
+	* @param values          Values to assign.
+	* @return true if the evaluation was found.
+	*/
+	bool Find(size_t hash,const RNumContainer<size_t,false>& genotype,cFit& fitness,RNumContainer<double,false>& values);
+
+	/**
+	* Store an evaluation. If necessary, the least recently used one is
+	* replaced.
+	* @param hash            Hash code of the genotype.
+	* @param genotype        Representation of the genotype.
+	* @param fitness         Fitness.
+	* @param values          Values.
+	*/
+	void Insert(size_t hash,const RNumContainer<size_t,false>& genotype,const cFit& fitness,const RNumContainer<double,false>& values);
+
+	/**
+	* Get the maximal number of evaluations stored.
+	*/
+	size_t GetMaxNb(void) const {return(MaxEntries);}
+
+	/**
+	* Get the number of evaluations stored.
+	*/
+	size_t GetNb(void) const {return(NbEntries);}
+
+	/**
+	* Get the number of evaluations found.
+	*/
+	size_t GetNbHits(void) const {return(NbHits);}
+
+	/**
+	* Get the number of evaluations not found.
+	*/
+	size_t GetNbMisses(void) const {return(NbMisses);}
+
+	/**
+	* Reset the counters of the evaluations found and not found.
+	*/
+	void ResetCounters(void) {NbHits=NbMisses=0;}
+
+private:
+
+	/**
+	* Make an entry the most recently used one.
+	* @param entry           Entry.
+	*/
+	void MoveFirst(Entry* entry);
+
+public:
+
+	/**
+	* Destruct the cache.
+	*/
+	~RFitnessCache(void);
+};
+
+
+//------------------------------------------------------------------------------
+// inline implementation
+#include <rfitnesscache.hh>
+
+
+}  //------- End of namespace R ------------------------------------------------
+
+
+//------------------------------------------------------------------------------
+#endif
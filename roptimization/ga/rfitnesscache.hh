@@ -0,0 +1,154 @@
+/*
+
+	R Project Library
+
+	RFitnessCache.hh
+
+	Cache of Fitnesses - Inline Implementation
+
+	Copyright 1998-2015 by Pascal Francq (pascal@francq.info).
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Library General Public
+	License as published by the Free Software Foundation; either
+	version 2.0 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Library General Public License for more details.
+
+	You should have received a copy of the GNU Library General Public
+	License along with this library, as a file COPYING.LIB; if not, write
+	to the Free Software Foundation, Inc., 59 Temple Place, Suite 330,
+	Boston, MA  02111-1307  USA
+
+*/
+
+
+
+//------------------------------------------------------------------------------
+//
+// RFitnessCache<cFit>
+//
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+template<class cFit>
+	R::RFitnessCache<cFit>::RFitnessCache(size_t max)
+		: Entries(0), MaxEntries(max), NbEntries(0), Buckets(0), Mask(0),
+		  First(0), Last(0), NbHits(0), NbMisses(0)
+{
+	if(!MaxEntries)
+		mThrowRGAException("Parameters","The fitness cache must store at least one evaluation");
+	size_t NbBuckets(1);
+	while(NbBuckets<2*MaxEntries)
+		NbBuckets<<=1;
+	Mask=NbBuckets-1;
+	Buckets=new Entry*[NbBuckets];
+	memset(Buckets,0,NbBuckets*sizeof(Entry*));
+	Entries=new Entry[MaxEntries];
+}
+
+
+//------------------------------------------------------------------------------
+template<class cFit>
+	void R::RFitnessCache<cFit>::Clear(void)
+{
+	memset(Buckets,0,(Mask+1)*sizeof(Entry*));
+	NbEntries=0;
+	First=Last=0;
+}
+
+
+//------------------------------------------------------------------------------
+template<class cFit>
+	void R::RFitnessCache<cFit>::MoveFirst(Entry* entry)
+{
+	if(entry==First)
+		return;
+
+	// Remove the entry from the list
+	if(entry->Prev)
+		entry->Prev->Next=entry->Next;
+	if(entry->Next)
+		entry->Next->Prev=entry->Prev;
+	else if(entry==Last)
+		Last=entry->Prev;
+
+	// Insert it at the beginning
+	entry->Prev=0;
+	entry->Next=First;
+	if(First)
+		First->Prev=entry;
+	First=entry;
+	if(!Last)
+		Last=entry;
+}
+
+
+//------------------------------------------------------------------------------
+template<class cFit>
+	bool R::RFitnessCache<cFit>::Find(size_t hash,const RNumContainer<size_t,false>& genotype,cFit& fitness,RNumContainer<double,false>& values)
+{
+	for(Entry* Cur=Buckets[hash&Mask];Cur;Cur=Cur->Collision)
+	{
+		if((Cur->Hash!=hash)||(!Cur->Genotype.IsSame(genotype)))
+			continue;
+		fitness=Cur->Fitness;
+		values=Cur->Values;
+		MoveFirst(Cur);
+		NbHits++;
+		return(true);
+	}
+	NbMisses++;
+	return(false);
+}
+
+
+//------------------------------------------------------------------------------
+template<class cFit>
+	void R::RFitnessCache<cFit>::Insert(size_t hash,const RNumContainer<size_t,false>& genotype,const cFit& fitness,const RNumContainer<double,false>& values)
+{
+	Entry* Cur;
+
+	// Look if the evaluation is already stored
+	for(Cur=Buckets[hash&Mask];Cur;Cur=Cur->Collision)
+		if((Cur->Hash==hash)&&Cur->Genotype.IsSame(genotype))
+			break;
+
+	if(!Cur)
+	{
+		if(NbEntries<MaxEntries)
+		{
+			// Take a free entry
+			Cur=&Entries[NbEntries++];
+			Cur->Prev=Cur->Next=0;
+		}
+		else
+		{
+			// Replace the least recently used entry: remove it from its bucket
+			Cur=Last;
+			Entry** Ptr(&Buckets[Cur->Hash&Mask]);
+			while((*Ptr)!=Cur)
+				Ptr=&((*Ptr)->Collision);
+			(*Ptr)=Cur->Collision;
+		}
+		Cur->Hash=hash;
+		Cur->Genotype=genotype;
+		Cur->Collision=Buckets[hash&Mask];
+		Buckets[hash&Mask]=Cur;
+	}
+	Cur->Fitness=fitness;
+	Cur->Values=values;
+	MoveFirst(Cur);
+}
+
+
+//------------------------------------------------------------------------------
+template<class cFit>
+	R::RFitnessCache<cFit>::~RFitnessCache(void)
+{
+	delete[] Buckets;
+	delete[] Entries;
+}
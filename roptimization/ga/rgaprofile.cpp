@@ -0,0 +1,344 @@
+/*
+
+	R Project Library
+
+	RGAProfile.cpp
+
+	Profile of the Generations of a GA - Implementation
+
+	Copyright 1998-2015 by Pascal Francq (pascal@francq.info).
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Library General Public
+	License as published by the Free Software Foundation; either
+	version 2.0 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Library General Public License for more details.
+
+	You should have received a copy of the GNU Library General Public
+	License along with this library, as a file COPYING.LIB; if not, write
+	to the Free Software Foundation, Inc., 59 Temple Place, Suite 330,
+	Boston, MA  02111-1307  USA
+
+*/
+
+
+
+//------------------------------------------------------------------------------
+// include files for ANSI C/C++
+#include <time.h>
+
+
+//------------------------------------------------------------------------------
+// include files for R Project
+#include <rgaprofile.h>
+#include <rtextfile.h>
+using namespace R;
+using namespace std;
+
+
+
+//------------------------------------------------------------------------------
+//
+// Class RGAGenProfile
+//
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+RGAGenProfile::RGAGenProfile(size_t gen)
+{
+	Clear(gen);
+}
+
+
+//------------------------------------------------------------------------------
+void RGAGenProfile::Clear(size_t gen)
+{
+	Gen=gen;
+	memset(Wall,0,gaNbPhases*sizeof(double));
+	memset(CPU,0,gaNbPhases*sizeof(double));
+	NbEvaluations=0;
+}
+
+
+//------------------------------------------------------------------------------
+void RGAGenProfile::Add(const RGAGenProfile& gen)
+{
+	for(size_t i=0;i<gaNbPhases;i++)
+	{
+		Wall[i]+=gen.Wall[i];
+		CPU[i]+=gen.CPU[i];
+	}
+	NbEvaluations+=gen.NbEvaluations;
+}
+
+
+//------------------------------------------------------------------------------
+double RGAGenProfile::GetWall(void) const
+{
+	double Sum(0.0);
+	for(size_t i=0;i<gaNbPhases;i++)
+		Sum+=Wall[i];
+	return(Sum);
+}
+
+
+//------------------------------------------------------------------------------
+double RGAGenProfile::GetCPU(void) const
+{
+	double Sum(0.0);
+	for(size_t i=0;i<gaNbPhases;i++)
+		Sum+=CPU[i];
+	return(Sum);
+}
+
+
+
+//------------------------------------------------------------------------------
+//
+// Class RGAProfile
+//
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+RGAProfile::RGAProfile(size_t max)
+	: Enabled(true), Current(), Total(), Gens(0), MaxGens(0), FirstGen(0), NbGens(0), NbThreads(0), ThreadTimes(0)
+{
+	SetMaxGens(max);
+	memset(StartWall,0,gaNbPhases*sizeof(double));
+	memset(StartCPU,0,gaNbPhases*sizeof(double));
+}
+
+
+//------------------------------------------------------------------------------
+void RGAProfile::SetNbThreads(size_t nb)
+{
+	if(nb!=NbThreads)
+	{
+		delete[] ThreadTimes;
+		NbThreads=nb;
+		ThreadTimes=(NbThreads?new double[NbThreads]:0);
+	}
+	if(NbThreads)
+		memset(ThreadTimes,0,NbThreads*sizeof(double));
+}
+
+
+//------------------------------------------------------------------------------
+void RGAProfile::SetMaxGens(size_t max)
+{
+	if(!max)
+		mThrowRGAException("Profile","At least one generation must be kept");
+	if(max!=MaxGens)
+	{
+		delete[] Gens;
+		MaxGens=max;
+		Gens=new RGAGenProfile[MaxGens];
+	}
+	FirstGen=NbGens=0;
+}
+
+
+//------------------------------------------------------------------------------
+void RGAProfile::Clear(void)
+{
+	Current.Clear(0);
+	Total.Clear(0);
+	FirstGen=NbGens=0;
+	if(NbThreads)
+		memset(ThreadTimes,0,NbThreads*sizeof(double));
+}
+
+
+//------------------------------------------------------------------------------
+void RGAProfile::EndGen(size_t gen)
+{
+	if(!Enabled)
+		return;
+	Current.Gen=gen;
+	Total.Gen=gen;
+	Total.Add(Current);
+
+	// If the array is full, the oldest generation is replaced
+	Gens[(FirstGen+NbGens)%MaxGens]=Current;
+	if(NbGens<MaxGens)
+		NbGens++;
+	else
+		FirstGen=(FirstGen+1)%MaxGens;
+	Current.Clear(0);
+}
+
+
+//------------------------------------------------------------------------------
+const RGAGenProfile& RGAProfile::GetLastGen(void) const
+{
+	if(!NbGens)
+		return(Current);
+	return(Gens[(FirstGen+NbGens-1)%MaxGens]);
+}
+
+
+//------------------------------------------------------------------------------
+const RGAGenProfile& RGAProfile::GetGen(size_t idx) const
+{
+	if(idx>=NbGens)
+		mThrowRGAException("Profile","Generation "+RString::Number(idx)+" is not kept");
+	return(Gens[(FirstGen+idx)%MaxGens]);
+}
+
+
+//------------------------------------------------------------------------------
+double RGAProfile::GetThreadTime(size_t th) const
+{
+	if(th>=NbThreads)
+		mThrowRGAException("Profile","Thread "+RString::Number(th)+" is not followed");
+	return(ThreadTimes[th]);
+}
+
+
+//------------------------------------------------------------------------------
+void RGAProfile::ExportCSV(const RURI& uri) const
+{
+	RTextFile File(uri,"utf-8");
+	File.SetSeparator("");
+	File.Open(RIO::Create);
+
+	// Header
+	RString Line("Gen");
+	for(size_t i=0;i<gaNbPhases;i++)
+	{
+		RString Name(GetPhaseName(static_cast<tGAPhase>(i)));
+		Line+=","+Name+" Wall,"+Name+" CPU";
+	}
+	Line+=",Evaluations";
+	File.WriteStr(Line,false);
+	File.WriteLine();
+
+	// One line per generation
+	for(size_t j=0;j<NbGens;j++)
+	{
+		const RGAGenProfile& Gen(GetGen(j));
+		Line=RString::Number(Gen.Gen);
+		for(size_t i=0;i<gaNbPhases;i++)
+			Line+=","+RString::Number(Gen.Wall[i],"%f")+","+RString::Number(Gen.CPU[i],"%f");
+		Line+=","+RString::Number(Gen.NbEvaluations);
+		File.WriteStr(Line,false);
+		File.WriteLine();
+	}
+}
+
+
+//------------------------------------------------------------------------------
+void RGAProfile::ExportJSON(const RURI& uri) const
+{
+	RTextFile File(uri,"utf-8");
+	File.SetSeparator("");
+	File.Open(RIO::Create);
+	size_t i;
+	RString Line;
+
+	// Total times
+	File.WriteStr("{",false);
+	File.WriteLine();
+	File.WriteStr("\t\"Total\": {",false);
+	File.WriteLine();
+	for(i=0;i<gaNbPhases;i++)
+	{
+		Line="\t\t\""+GetPhaseName(static_cast<tGAPhase>(i))+"\": {\"Wall\": "+RString::Number(Total.Wall[i],"%f")+", \"CPU\": "+RString::Number(Total.CPU[i],"%f")+"},";
+		File.WriteStr(Line,false);
+		File.WriteLine();
+	}
+	File.WriteStr("\t\t\"Evaluations\": "+RString::Number(Total.NbEvaluations),false);
+	File.WriteLine();
+	File.WriteStr("\t},",false);
+	File.WriteLine();
+
+	// Times of the threads
+	Line="\t\"Threads\": [";
+	for(i=0;i<NbThreads;i++)
+	{
+		if(i)
+			Line+=", ";
+		Line+=RString::Number(ThreadTimes[i],"%f");
+	}
+	Line+="],";
+	File.WriteStr(Line,false);
+	File.WriteLine();
+
+	// Generations
+	File.WriteStr("\t\"Generations\": [",false);
+	for(size_t j=0;j<NbGens;j++)
+	{
+		const RGAGenProfile& Gen(GetGen(j));
+		if(j)
+			File.WriteStr(",",false);
+		File.WriteLine();
+		Line="\t\t{\"Gen\": "+RString::Number(Gen.Gen);
+		for(i=0;i<gaNbPhases;i++)
+			Line+=", \""+GetPhaseName(static_cast<tGAPhase>(i))+"\": ["+RString::Number(Gen.Wall[i],"%f")+", "+RString::Number(Gen.CPU[i],"%f")+"]";
+		Line+=", \"Evaluations\": "+RString::Number(Gen.NbEvaluations)+"}";
+		File.WriteStr(Line,false);
+	}
+	File.WriteLine();
+	File.WriteStr("\t]",false);
+	File.WriteLine();
+	File.WriteStr("}",false);
+	File.WriteLine();
+}
+
+
+//------------------------------------------------------------------------------
+RString RGAProfile::GetPhaseName(tGAPhase phase)
+{
+	switch(phase)
+	{
+		case gaRandomConstruct:
+			return("RandomConstruct");
+		case gaCrossover:
+			return("Crossover");
+		case gaMutation:
+			return("Mutation");
+		case gaStrongMutation:
+			return("StrongMutation");
+		case gaInversion:
+			return("Inversion");
+		case gaEvaluation:
+			return("Evaluation");
+		case gaPostEvaluation:
+			return("PostEvaluation");
+		case gaRanking:
+			return("Ranking");
+		default:
+			break;
+	}
+	return(RString::Null);
+}
+
+
+//------------------------------------------------------------------------------
+double RGAProfile::GetWallTime(void)
+{
+	struct timespec Now;
+	clock_gettime(CLOCK_MONOTONIC,&Now);
+	return(static_cast<double>(Now.tv_sec)+static_cast<double>(Now.tv_nsec)/1000000000.0);
+}
+
+
+//------------------------------------------------------------------------------
+double RGAProfile::GetCPUTime(void)
+{
+	struct timespec Now;
+	clock_gettime(CLOCK_PROCESS_CPUTIME_ID,&Now);
+	return(static_cast<double>(Now.tv_sec)+static_cast<double>(Now.tv_nsec)/1000000000.0);
+}
+
+
+//------------------------------------------------------------------------------
+RGAProfile::~RGAProfile(void)
+{
+	delete[] Gens;
+	delete[] ThreadTimes;
+}
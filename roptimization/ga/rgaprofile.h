@@ -0,0 +1,386 @@
+/*
+
+	R Project Library
+
+	RGAProfile.h
+
+	Profile of the Generations of a GA - Header
+
+	Copyright 1998-2015 by Pascal Francq (pascal@francq.info).
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Library General Public
+	License as published by the Free Software Foundation; either
+	version 2.0 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Library General Public License for more details.
+
+	You should have received a copy of the GNU Library General Public
+	License along with this library, as a file COPYING.LIB; if not, write
+	to the Free Software Foundation, Inc., 59 Temple Place, Suite 330,
+	Boston, MA  02111-1307  USA
+
+*/
+
+
+
+//------------------------------------------------------------------------------
+#ifndef RGAProfile_H
+#define RGAProfile_H
+
+
+//------------------------------------------------------------------------------
+// include files for R Project
+#include <rga.h>
+#include <rcursor.h>
+#include <ruri.h>
+
+
+//------------------------------------------------------------------------------
+namespace R{
+//------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------
+/**
+* Phases of a generation of a GA that are profiled.
+*/
+enum tGAPhase
+{
+	gaRandomConstruct       /** Random construction of the chromosomes.*/,
+	gaCrossover             /** Crossovers.*/,
+	gaMutation              /** Mutations.*/,
+	gaStrongMutation        /** Mutations of the best chromosome.*/,
+	gaInversion             /** Inversions.*/,
+	gaEvaluation            /** Evaluation of the chromosomes.*/,
+	gaPostEvaluation        /** Post evaluation.*/,
+	gaRanking               /** Ranking of the chromosomes.*/,
+	gaNbPhases              /** Number of phases.*/
+};
+
+
+//------------------------------------------------------------------------------
+/**
+* The RGAGenProfile class provides the times spent in each phase of a given
+* generation. The times are in seconds.
+* @short Profile of a GA Generation.
+*/
+class RGAGenProfile
+{
+public:
+
+	/**
+	* Generation.
+	*/
+	size_t Gen;
+
+	/**
+	* Wall time of each phase.
+	*/
+	double Wall[gaNbPhases];
+
+	/**
+	* Processor time of each phase (the time of all the threads of the process
+	* is added).
+	*/
+	double CPU[gaNbPhases];
+
+	/**
+	* Number of chromosomes evaluated.
+	*/
+	size_t NbEvaluations;
+
+	/**
+	* Construct an empty profile.
+	* @param gen            Generation.
+	*/
+	RGAGenProfile(size_t gen=0);
+
+	/**
+	* Compare two profiles.
+	* @param gen             Profile to compare with.
+	* @return a value compatible with R::RContainer.
+	*/
+	int Compare(const RGAGenProfile& gen) const {return(CompareIds(Gen,gen.Gen));}
+
+	/**
+	* Clear the profile.
+	* @param gen            Generation.
+	*/
+	void Clear(size_t gen);
+
+	/**
+	* Add the times and the evaluations of another profile.
+	* @param gen            Profile.
+	*/
+	void Add(const RGAGenProfile& gen);
+
+	/**
+	* Get the total wall time of the generation.
+	*/
+	double GetWall(void) const;
+
+	/**
+	* Get the total processor time of the generation.
+	*/
+	double GetCPU(void) const;
+};
+
+
+//------------------------------------------------------------------------------
+/**
+* The RGAProfile class measures the time spent by a GA in the different phases
+* of each generation (see RInst::GetProfile). Only two clock readings are done
+* for a phase and the memory used is bounded, so the profile stays enabled
+* during a normal run (see SetEnabled).
+*
+* The times of a phase are accumulated between two calls to EndGen, which
+* stores them as the profile of a generation. Only the profiles of the last
+* generations are kept (see SetMaxGens), but the totals cover all the
+* generations. The time spent by each worker thread in the tasks run in
+* parallel (evaluations and crossovers) is also accumulated. The profile can
+* be exported at the end of a run:
+* @code
+* Inst.Run();
+* Inst.GetProfile().ExportCSV(RURI("/tmp/profile.csv"));
+* @endcode
+* @short Profile of a GA.
+*/
+class RGAProfile
+{
+	/**
+	* Is the profile enabled?
+	*/
+	bool Enabled;
+
+	/**
+	* Profile of the current generation.
+	*/
+	RGAGenProfile Current;
+
+	/**
+	* Profile of all the generations.
+	*/
+	RGAGenProfile Total;
+
+	/**
+	* Circular array of the profiles of the last generations done.
+	*/
+	RGAGenProfile* Gens;
+
+	/**
+	* Maximal number of generations kept.
+	*/
+	size_t MaxGens;
+
+	/**
+	* Position of the oldest generation kept.
+	*/
+	size_t FirstGen;
+
+	/**
+	* Number of generations kept.
+	*/
+	size_t NbGens;
+
+	/**
+	* Wall time at which the phases started.
+	*/
+	double StartWall[gaNbPhases];
+
+	/**
+	* Processor time at which the phases started.
+	*/
+	double StartCPU[gaNbPhases];
+
+	/**
+	* Number of threads.
+	*/
+	size_t NbThreads;
+
+	/**
+	* Wall time spent by each thread in the parallel tasks.
+	*/
+	double* ThreadTimes;
+
+public:
+
+	/**
+	* Construct the profile.
+	* @param max            Maximal number of generations kept.
+	*/
+	RGAProfile(size_t max=1000);
+
+private:
+
+	/**
+	* Copy constructor (not allowed).
+	*/
+	RGAProfile(const RGAProfile&);
+
+	/**
+	* Assignment operator (not allowed).
+	*/
+	RGAProfile& operator=(const RGAProfile&);
+
+public:
+
+	/**
+	* Enable or disable the profile. By default, it is enabled.
+	* @param enable         Enable?
+	*/
+	void SetEnabled(bool enable) {Enabled=enable;}
+
+	/**
+	* Look if the profile is enabled.
+	*/
+	bool IsEnabled(void) const {return(Enabled);}
+
+	/**
+	* Set the number of threads followed. The times of the threads are reset.
+	* @param nb             Number of threads.
+	*/
+	void SetNbThreads(size_t nb);
+
+	/**
+	* Set the maximal number of generations kept. The generations kept are
+	* cleared (but not the totals).
+	* @param max            Maximal number of generations (at least one).
+	*/
+	void SetMaxGens(size_t max);
+
+	/**
+	* Get the maximal number of generations kept.
+	*/
+	size_t GetMaxGens(void) const {return(MaxGens);}
+
+	/**
+	* Clear the profile.
+	*/
+	void Clear(void);
+
+	/**
+	* Start a phase.
+	* @param phase          Phase.
+	*/
+	inline void Start(tGAPhase phase)
+	{
+		if(!Enabled)
+			return;
+		StartWall[phase]=GetWallTime();
+		StartCPU[phase]=GetCPUTime();
+	}
+
+	/**
+	* Stop a phase and add its times to the current generation.
+	* @param phase          Phase.
+	*/
+	inline void Stop(tGAPhase phase)
+	{
+		if(!Enabled)
+			return;
+		Current.Wall[phase]+=GetWallTime()-StartWall[phase];
+		Current.CPU[phase]+=GetCPUTime()-StartCPU[phase];
+	}
+
+	/**
+	* Add some evaluations to the current generation.
+	* @param nb             Number of evaluations.
+	*/
+	inline void AddEvaluations(size_t nb) {if(Enabled) Current.NbEvaluations+=nb;}
+
+	/**
+	* Add the time spent by a thread in a parallel task. Each thread only
+	* modifies its own time.
+	* @param th             Thread.
+	* @param wall           Wall time.
+	*/
+	inline void AddThreadTime(size_t th,double wall) {if(Enabled&&(th<NbThreads)) ThreadTimes[th]+=wall;}
+
+	/**
+	* Store the times of the phases done since the last call as the profile of
+	* a generation. If the maximal number of generations is reached, it
+	* replaces the oldest one.
+	* @param gen            Generation.
+	*/
+	void EndGen(size_t gen);
+
+	/**
+	* Get the profile of the last generation done. If no generation was done,
+	* an empty profile is returned.
+	*/
+	const RGAGenProfile& GetLastGen(void) const;
+
+	/**
+	* Get the number of generations kept.
+	*/
+	size_t GetNbGens(void) const {return(NbGens);}
+
+	/**
+	* Get the profile of a generation kept.
+	* @param idx            Index of the generation (0 is the oldest one kept).
+	*/
+	const RGAGenProfile& GetGen(size_t idx) const;
+
+	/**
+	* Get the profile of all the generations done.
+	*/
+	const RGAGenProfile& GetTotal(void) const {return(Total);}
+
+	/**
+	* Get the number of threads followed.
+	*/
+	size_t GetNbThreads(void) const {return(NbThreads);}
+
+	/**
+	* Get the wall time spent by a thread in the parallel tasks.
+	* @param th             Thread.
+	*/
+	double GetThreadTime(size_t th) const;
+
+	/**
+	* Export the profile in a CSV file. Each line corresponds to a generation
+	* kept and gives the wall and processor times of each phase, and the number of
+	* evaluations.
+	* @param uri            URI of the file.
+	*/
+	void ExportCSV(const RURI& uri) const;
+
+	/**
+	* Export the profile in a JSON file. It contains the total times, the
+	* times of the threads and the profiles of the generations kept.
+	* @param uri            URI of the file.
+	*/
+	void ExportJSON(const RURI& uri) const;
+
+	/**
+	* Get the name of a phase.
+	* @param phase          Phase.
+	*/
+	static RString GetPhaseName(tGAPhase phase);
+
+	/**
+	* Get the current wall time (in seconds).
+	*/
+	static double GetWallTime(void);
+
+	/**
+	* Get the current processor time of the process (in seconds).
+	*/
+	static double GetCPUTime(void);
+
+	/**
+	* Destruct the profile.
+	*/
+	~RGAProfile(void);
+};
+
+
+}  //------- End of namespace R ------------------------------------------------
+
+
+//------------------------------------------------------------------------------
+#endif
@@ -40,9 +40,17 @@
 #include <rcursor.h>
 #include <robject.h>
 #include <rnotification.h>
+#include <rthreadpool.h>
+#include <rfitnesscache.h>
+#include <rgaprofile.h>
 #include <irinst.h>
 
 
+//------------------------------------------------------------------------------
+// include files for ANSI C/C++
+#include <sys/time.h>
+
+
 //------------------------------------------------------------------------------
 namespace R{
 //------------------------------------------------------------------------------
@@ -63,6 +71,13 @@ public:
 	*/
 	cInst* Owner;
 
+	/**
+	* Random number generator used by the genetic operators of the chromosomes
+	* associated with the data. The first data uses the generator of the
+	* instance, the other ones have their own generator.
+	*/
+	RRandom* Random;
+
 	/**
 	* Construct the data.
 	* @param owner          The instance of the problem.
@@ -77,7 +92,55 @@ public:
 	/**
 	* Destruct the data.
 	*/
-	virtual ~RThreadData() {}
+	virtual ~RThreadData(void);
+};
+
+
+//------------------------------------------------------------------------------
+/**
+* The RInstTask class provides the function object executed by the thread pool
+* of the GA to evaluate or to cross, in parallel, the chromosomes associated
+* with the "thread-dependent" data. It is called once for each data.
+* @short GA Parallel Task.
+*/
+template<class cInst,class cChromo,class cFit,class cThreadData>
+	class RInstTask
+{
+	/**
+	* Instance of the GA.
+	*/
+	RInst<cInst,cChromo,cFit,cThreadData>* Owner;
+
+	/**
+	* Was at least one chromosome treated for a given data?
+	*/
+	bool* Treated;
+
+public:
+
+	/**
+	* Construct the task.
+	* @param owner          Instance of the GA.
+	*/
+	RInstTask(RInst<cInst,cChromo,cFit,cThreadData>* owner);
+
+	/**
+	* Run the current task of the instance on the chromosomes associated with
+	* a given "thread-dependent" data.
+	* @param th              Index of the "thread-dependent" data.
+	* @param worker          Identifier of the worker (not used).
+	*/
+	void operator()(size_t th,size_t worker);
+
+	/**
+	* Look if at least one chromosome was treated.
+	*/
+	bool IsTreated(void) const;
+
+	/**
+	* Destruct the task.
+	*/
+	~RInstTask(void);
 };
 
 
@@ -85,13 +148,33 @@ public:
 /**
 * Instance for the generic GA.
 *
+* The chromosomes can be evaluated and crossed by several threads (see
+* SetNbThreads). Each thread has its own "thread-dependent" data, and the
+* chromosome i is associated with the data i modulo the number of threads: a
+* given chromosome is therefore always evaluated or constructed by the same
+* thread. In this case, the Evaluate and Crossover methods of the chromosomes
+* must be thread-safe: they should not modify the parents, and they should
+* use the random number generator of the chromosome (RChromo::RRand) rather
+* than the one of the instance. Since the results depend on the random
+* generator of each "thread-dependent" data, a run is reproducible for a given
+* seed and a given number of threads. The crossovers are only done in
+* parallel if no debugger is used.
+*
 * The instance emit several signals:
 * - PostNotification("RInst::Interact") : Possible interactions from the
-*   outside.
+*   outside. It is only posted if it has observers, and at most once during
+*   a given delay (see SetInteractDelay).
 * - PostNotification("RInst::Best",size_t) : The best chromosome has
 *   changed and the generation number is given as parameter.
 * - PostNotification("RInst::Generation",size_t) : A new generation has be done
 *   which number is passed as parameter.
+* - PostNotification("RInst::Profile",const RGAProfile*) : The profile of a
+*   new generation is available (see GetProfile). It is only posted if it has
+*   observers.
+*
+* When the instance runs in another thread than its observers (for example
+* in a R::RIslands), the notifications can be deferred (see
+* SetDeferNotifications) and posted later by the thread of the observers.
 * @short Generic GA instance.
 */
 template<class cInst,class cChromo,class cFit,class cThreadData>
@@ -121,6 +204,35 @@ private:
 	*/
 	cChromo** tmpChrom2;
 
+	/**
+	* Chromosomes (identified by their identifiers) evaluated since the last
+	* ranking.
+	*/
+	bool* Dirty;
+
+	/**
+	* Is the array of ranked chromosomes initialized?
+	*/
+	bool bRanked;
+
+	/**
+	* Hash codes of the chromosomes (identified by their identifiers) not found
+	* in the fitness cache and that must be stored once evaluated.
+	*/
+	size_t* CacheHashes;
+
+	/**
+	* Values of the evaluation of a chromosome exchanged with the fitness
+	* cache.
+	*/
+	RNumContainer<double,false> CacheValues;
+
+	/**
+	* Representation of the genotype of a chromosome exchanged with the
+	* fitness cache.
+	*/
+	RNumContainer<size_t,false> CacheGenotype;
+
 protected:
 
 	/**
@@ -128,6 +240,32 @@ protected:
 	*/
 	cThreadData** thDatas;
 
+	/**
+	* Number of threads used to evaluate the chromosomes (and of
+	* "thread-dependent" data).
+	*/
+	size_t NbThreads;
+
+	/**
+	* Pool of threads treating the chromosomes in parallel. Its workers are
+	* created once by Init and live until the instance is destructed.
+	*/
+	RThreadPool* Pool;
+
+	/**
+	* Task to run by the threads.
+	*/
+	enum tTask
+	{
+		tEvaluate          /** Evaluate the chromosomes.*/,
+		tCrossover         /** Do the crossovers.*/
+	};
+
+	/**
+	* Current task run by the threads.
+	*/
+	tTask Task;
+
 	/**
 	* This variable is true if the random construction where done.
 	*/
@@ -149,6 +287,76 @@ protected:
 	 */
 	bool DoOptimisation;
 
+	/**
+	* Does PostEvaluate recompute the fitness of all the chromosomes (for
+	* example with PROMETHEE)? In this case, the ranking of the previous
+	* generation is never reused and all the chromosomes are sorted. By
+	* default, it is false.
+	*/
+	bool PostEvaluateFitness;
+
+	/**
+	* Handle of the "RInst::Interact" notification.
+	*/
+	hNotification hInteract;
+
+	/**
+	* Handle of the "RInst::Best" notification.
+	*/
+	hNotification hBest;
+
+	/**
+	* Handle of the "RInst::Generation" notification.
+	*/
+	hNotification hGeneration;
+
+	/**
+	* Handle of the "RInst::Profile" notification.
+	*/
+	hNotification hProfile;
+
+	/**
+	* Minimal delay (in milliseconds) between two "RInst::Interact"
+	* notifications.
+	*/
+	size_t InteractDelay;
+
+	/**
+	* Time (in milliseconds) of the next "RInst::Interact" notification that
+	* can be posted.
+	*/
+	unsigned long long NextInteract;
+
+	/**
+	* Are the notifications deferred?
+	*/
+	bool DeferNotifications;
+
+	/**
+	* Generations of the deferred "RInst::Best" notifications.
+	*/
+	RNumContainer<size_t,false> DeferredBest;
+
+	/**
+	* Generations of the deferred "RInst::Generation" notifications.
+	*/
+	RNumContainer<size_t,false> DeferredGeneration;
+
+	/**
+	* Is a "RInst::Profile" notification deferred?
+	*/
+	bool DeferredProfile;
+
+	/**
+	* Cache of the evaluations (null if no cache is used).
+	*/
+	RFitnessCache<cFit>* FitnessCache;
+
+	/**
+	* Profile of the generations.
+	*/
+	RGAProfile Profile;
+
 public:
 
 	/**
@@ -157,7 +365,9 @@ public:
 	cChromo** Chromosomes;
 
 	/**
-	 * The chromosomes ranked by fitness.
+	 * The chromosomes ranked by fitness (the best one is the first one). The
+	 * ranking is updated by AnalyzePop: only the chromosomes evaluated since
+	 * the previous call are sorted and merged with the other ones.
 	 */
 	cChromo** Ranked;
 
@@ -248,6 +458,75 @@ public:
 	*/
 	inline bool GetVerify(void) const {return(VerifyGA);}
 
+	/**
+	* Set the number of threads used to evaluate the chromosomes. This method
+	* must be called before the initialization of the instance.
+	* @param nb              Number of threads (at least one).
+	*/
+	void SetNbThreads(size_t nb);
+
+	/**
+	* @return the number of threads used to evaluate the chromosomes.
+	*/
+	inline size_t GetNbThreads(void) const {return(NbThreads);}
+
+	/**
+	* Set the minimal delay between two "RInst::Interact" notifications. By
+	* default, the delay is null and the notification is posted each time the
+	* GA allows an interaction.
+	* @param delay           Delay in milliseconds.
+	*/
+	inline void SetInteractDelay(size_t delay) {InteractDelay=delay; NextInteract=0;}
+
+	/**
+	* Defer the notifications of the instance. The "RInst::Best",
+	* "RInst::Generation" and "RInst::Profile" notifications are stored and
+	* only posted by PostDeferredNotifications (the profile notification is
+	* posted once with the profile of the last generation). The
+	* "RInst::Interact" notifications are not posted.
+	* @param defer           Must the notifications be deferred?
+	*/
+	inline void SetDeferNotifications(bool defer) {DeferNotifications=defer;}
+
+	/**
+	* Post the deferred notifications in the order of the generations. It
+	* must be called by the thread of the observers.
+	*/
+	void PostDeferredNotifications(void);
+
+	/**
+	* @return the minimal delay (in milliseconds) between two "RInst::Interact"
+	* notifications.
+	*/
+	inline size_t GetInteractDelay(void) const {return(InteractDelay);}
+
+	/**
+	* Set the size of the fitness cache. When a cache is used, AnalyzePop looks
+	* for each chromosome to evaluate if the hash code of its genotype (see
+	* RChromo::HashGenotype) and its genotype (see RChromo::SaveGenotype)
+	* correspond to an evaluation stored. In this case, the fitness and the
+	* values saved by RChromo::SaveEvaluation are restored rather than calling
+	* RChromo::Evaluate. By default, no cache is used.
+	* @param max             Maximal number of evaluations stored (0 means
+	*                        that no cache is used).
+	*/
+	void SetFitnessCache(size_t max);
+
+	/**
+	* @return the fitness cache (null if no cache is used).
+	*/
+	inline const RFitnessCache<cFit>* GetFitnessCache(void) const {return(FitnessCache);}
+
+	/**
+	* Get the profile of the generations. It is enabled by default.
+	*/
+	inline RGAProfile& GetProfile(void) {return(Profile);}
+
+	/**
+	* Get the profile of the generations.
+	*/
+	inline const RGAProfile& GetProfile(void) const {return(Profile);}
+
 	/**
 	 * Look if a optimization is performed.
 	 * @return true or false.
@@ -275,7 +554,7 @@ public:
 	 * is wanted most of the time (in particular for debugging purposes).
 	 * @param seed           The seeded value.
 	 */
-	void SetSeed(int seed) {Random.Reset(seed);}
+	void SetSeed(int seed);
 
 	/**
 	 * Return the seed value of the internal random number generator.
@@ -289,13 +568,115 @@ public:
 
 	/**
 	* This function is used to make a sort of the chromosomes based on their
-	* fitness where the best chromosomes are at the top.
+	* fitness where the best chromosomes are at the top. Chromosomes with the
+	* same fitness are sorted by identifier.
 	* @param a              The first chromosome.
 	* @param b              The second chromosome.
 	* @return a-b
 	*/
 	static int sort_function_cChromosome(const void *a,const void *b);
 
+private:
+
+	/**
+	* Seed the random number generators of the "thread-dependent" data (except
+	* the first one) from the seed of the instance.
+	*/
+	void SeedThreads(void);
+
+	/**
+	* Evaluate the chromosomes associated with a given "thread-dependent" data
+	* that must be evaluated.
+	* @param th              Index of the "thread-dependent" data.
+	* @return true if at least one chromosome was evaluated.
+	*/
+	bool EvaluateChromosomes(size_t th);
+
+	/**
+	* Construct, by a crossover, the children associated with a given
+	* "thread-dependent" data. The parents and the children are those
+	* computed by the tournament.
+	* @param th              Index of the "thread-dependent" data.
+	* @return true if at least one child was constructed.
+	*/
+	bool CrossoverChromosomes(size_t th);
+
+	/**
+	* Run the current task on the chromosomes associated with a given
+	* "thread-dependent" data.
+	* @param th              Index of the "thread-dependent" data.
+	* @return true if at least one chromosome was treated.
+	*/
+	bool RunTask(size_t th);
+
+	/**
+	* Run a task in the thread pool for each "thread-dependent" data. The
+	* method returns once all the data are treated. If an exception occurs in a
+	* thread, a RGAException is generated.
+	* @param task            Task to run.
+	* @return true if at least one chromosome was treated.
+	*/
+	bool RunThreads(tTask task);
+
+	/**
+	* Look if the evaluation of a chromosome is in the fitness cache. If not,
+	* its hash code is remembered to store its evaluation later.
+	* @param chromo          Chromosome.
+	* @return true if the evaluation was found.
+	*/
+	bool FindInCache(cChromo* chromo);
+
+	/**
+	* Store the evaluations of the chromosomes not found in the fitness cache.
+	*/
+	void StoreInCache(void);
+
+	/**
+	* Update the ranking of the chromosomes. If the chromosomes not evaluated
+	* since the last ranking are still ordered, only the evaluated ones are
+	* sorted and merged with them. Otherwise, or if PostEvaluate changes the
+	* fitness of all the chromosomes (see PostEvaluateFitness), all the
+	* chromosomes are sorted.
+	*/
+	void RankChromosomes(void);
+
+protected:
+
+	/**
+	* Post a "RInst::Interact" notification if it is observed and if the
+	* interact delay is elapsed since the last one.
+	*/
+	inline void Interact(void)
+	{
+		if(DeferNotifications||(!NotificationCenter.IsObserved(hInteract,this)))
+			return;
+		if(InteractDelay)
+		{
+			struct timeval Now;
+			gettimeofday(&Now,0);
+			unsigned long long Time(static_cast<unsigned long long>(Now.tv_sec)*1000+Now.tv_usec/1000);
+			if(Time<NextInteract)
+				return;
+			NextInteract=Time+InteractDelay;
+		}
+		PostNotification(hInteract);
+	}
+
+public:
+
+	/**
+	* Store the profile of the current generation and, if it is observed, post
+	* a "RInst::Profile" notification. It is called at the end of each
+	* generation.
+	*/
+	void EndGenProfile(void);
+
+	/**
+	* Post (or defer) a "RInst::Generation" notification for the current
+	* generation.
+	*/
+	void PostGeneration(void);
+
 	/**
 	* Analyze the population to find the best chromosome of the population and
 	* to verify if the best chromosome ever calculated has to replaced. When
@@ -420,6 +801,8 @@ public:
 	* The echo of the slaves is received by the master.
 	*/
 	static const char instMultiEchos=8;
+
+	friend class RInstTask<cInst,cChromo,cFit,cThreadData>;
 };
 
 
@@ -37,11 +37,67 @@
 //------------------------------------------------------------------------------
 template<class cInst,class cChromo>
 	R::RThreadData<cInst,cChromo>::RThreadData(cInst *owner)
-		: Owner(owner)
+		: Owner(owner), Random(&owner->Random)
 {
 }
 
 
+//------------------------------------------------------------------------------
+template<class cInst,class cChromo>
+	R::RThreadData<cInst,cChromo>::~RThreadData(void)
+{
+	if(Random!=&Owner->Random)
+		delete Random;
+}
+
+
+
+//------------------------------------------------------------------------------
+//
+// RInstTask<cInst,cChromo,cFit,cThreadData>
+//
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+template<class cInst,class cChromo,class cFit,class cThreadData>
+	R::RInstTask<cInst,cChromo,cFit,cThreadData>::RInstTask(R::RInst<cInst,cChromo,cFit,cThreadData>* owner)
+		: Owner(owner), Treated(new bool[owner->NbThreads])
+{
+	memset(Treated,0,Owner->NbThreads*sizeof(bool));
+}
+
+
+//------------------------------------------------------------------------------
+template<class cInst,class cChromo,class cFit,class cThreadData>
+	void R::RInstTask<cInst,cChromo,cFit,cThreadData>::operator()(size_t th,size_t)
+{
+	bool Profile(Owner->Profile.IsEnabled());
+	double Start(Profile?RGAProfile::GetWallTime():0.0);
+	Treated[th]=Owner->RunTask(th);
+	if(Profile)
+		Owner->Profile.AddThreadTime(th,RGAProfile::GetWallTime()-Start);
+}
+
+
+//------------------------------------------------------------------------------
+template<class cInst,class cChromo,class cFit,class cThreadData>
+	bool R::RInstTask<cInst,cChromo,cFit,cThreadData>::IsTreated(void) const
+{
+	for(size_t i=0;i<Owner->NbThreads;i++)
+		if(Treated[i])
+			return(true);
+	return(false);
+}
+
+
+//------------------------------------------------------------------------------
+template<class cInst,class cChromo,class cFit,class cThreadData>
+	R::RInstTask<cInst,cChromo,cFit,cThreadData>::~RInstTask(void)
+{
+	delete[] Treated;
+}
+
+
 
 //------------------------------------------------------------------------------
 //
@@ -52,9 +108,16 @@ template<class cInst,class cChromo>
 //------------------------------------------------------------------------------
 template<class cInst,class cChromo,class cFit,class cThreadData>
 	R::RInst<cInst,cChromo,cFit,cThreadData>::RInst(size_t popsize,const R::RString& name,R::RDebug* debug)
-		: RObject(name), iRInst(popsize), Debug(debug), Random(RRandom::Good,12345), tmpChrom1(0), tmpChrom2(0),bRandomConstruct(false),
-		  VerifyGA(false), DoPostEvaluation(false), DoOptimisation(true),
-		  Chromosomes(0), Ranked(0)
+		: RObject(name), iRInst(popsize), Debug(debug), Random(RRandom::Good,12345), tmpChrom1(0), tmpChrom2(0),
+		  Dirty(0), bRanked(false), CacheHashes(0), CacheValues(10), CacheGenotype(10),
+		  thDatas(0), NbThreads(1), Pool(0), Task(tEvaluate), bRandomConstruct(false),
+		  VerifyGA(false), DoPostEvaluation(false), DoOptimisation(true), PostEvaluateFitness(false),
+		  hInteract(NotificationCenter.GetNotificationHandle("RInst::Interact")),
+		  hBest(NotificationCenter.GetNotificationHandle("RInst::Best")),
+		  hGeneration(NotificationCenter.GetNotificationHandle("RInst::Generation")),
+		  hProfile(NotificationCenter.GetNotificationHandle("RInst::Profile")),
+		  InteractDelay(0), NextInteract(0), DeferNotifications(false), DeferredBest(20), DeferredGeneration(20),
+		  DeferredProfile(false), FitnessCache(0), Profile(), Chromosomes(0), Ranked(0)
 {
 	if(Debug)
 		Debug->BeginApp(GetName());
@@ -82,6 +145,53 @@ template<class cInst,class cChromo,class cFit,class cThreadData>
 }
 
 
+//------------------------------------------------------------------------------
+template<class cInst,class cChromo,class cFit,class cThreadData>
+	void R::RInst<cInst,cChromo,cFit,cThreadData>::SetNbThreads(size_t nb)
+{
+	if(thDatas)
+		mThrowRGAException("Parameters","Number of threads cannot be changed once the instance is initialized");
+	if(!nb)
+		mThrowRGAException("Parameters","At least one thread must be used");
+	NbThreads=nb;
+}
+
+
+//------------------------------------------------------------------------------
+template<class cInst,class cChromo,class cFit,class cThreadData>
+	void R::RInst<cInst,cChromo,cFit,cThreadData>::SetSeed(int seed)
+{
+	Random.Reset(seed);
+	if(thDatas)
+		SeedThreads();
+}
+
+
+//------------------------------------------------------------------------------
+template<class cInst,class cChromo,class cFit,class cThreadData>
+	void R::RInst<cInst,cChromo,cFit,cThreadData>::SeedThreads(void)
+{
+	// The seeds are drawn from a generator seeded with the seed of the instance
+	RRandom Seeds(RRandom::Good,Random.GetSeed());
+	for(size_t i=1;i<NbThreads;i++)
+		thDatas[i]->Random->Reset(static_cast<int>(Seeds.GetValue(INT_MAX-1))+1);
+}
+
+
+//------------------------------------------------------------------------------
+template<class cInst,class cChromo,class cFit,class cThreadData>
+	void R::RInst<cInst,cChromo,cFit,cThreadData>::SetFitnessCache(size_t max)
+{
+	if(FitnessCache)
+	{
+		delete FitnessCache;
+		FitnessCache=0;
+	}
+	if(max)
+		FitnessCache=new RFitnessCache<cFit>(max);
+}
+
+
 //------------------------------------------------------------------------------
 template<class cInst,class cChromo,class cFit,class cThreadData>
 	void R::RInst<cInst,cChromo,cFit,cThreadData>::SetOptimisation(bool opti)
@@ -106,16 +216,30 @@ template<class cInst,class cChromo,class cFit,class cThreadData>
 		NbCross=PopSize/4;
 		tmpChrom1=new cChromo*[PopSize];
 		tmpChrom2=new cChromo*[PopSize];
+		Dirty=new bool[PopSize];
+		memset(Dirty,0,PopSize*sizeof(bool));
+		CacheHashes=new size_t[PopSize];
+		memset(CacheHashes,0,PopSize*sizeof(size_t));
 		for(i=0,C=Chromosomes;i<PopSize;C++,i++)
 			(*C)=new cChromo(static_cast<cInst*>(this),i);
 		BestInPop=Chromosomes[0];
 	}
 	BestChromosome=new cChromo(static_cast<cInst*>(this),PopSize);
-	thDatas=new cThreadData*[1];
-	thDatas[0]=new cThreadData(static_cast<cInst*>(this));
-	thDatas[0]->Init();
+	thDatas=new cThreadData*[NbThreads];
+	for(i=0;i<NbThreads;i++)
+	{
+		thDatas[i]=new cThreadData(static_cast<cInst*>(this));
+		if(i)
+			thDatas[i]->Random=new RRandom(RRandom::Good);
+	}
+	SeedThreads();
+	Profile.SetNbThreads(NbThreads);
+	for(i=0;i<NbThreads;i++)
+		thDatas[i]->Init();
+	if(NbThreads>1)
+		Pool=new RThreadPool(NbThreads);
 	for(i=0,C=Chromosomes;i<PopSize;C++,i++)
-		(*C)->Init(thDatas[0]);
+		(*C)->Init(thDatas[i%NbThreads]);
 	BestChromosome->Init(thDatas[0]);
 }
 
@@ -127,7 +251,8 @@ template<class cInst,class cChromo,class cFit,class cThreadData>
 	cFit* af=(*((cChromo**)a))->Fitness;
 	cFit* bf=(*((cChromo**)b))->Fitness;
 
-	if((*af)==(*bf)) return(0);
+	if((*af)==(*bf))
+		return(CompareIds((*((cChromo**)a))->Id,(*((cChromo**)b))->Id));
 	if((*af)>(*bf))
 		return(-1);
 	else
@@ -135,41 +260,268 @@ template<class cInst,class cChromo,class cFit,class cThreadData>
 }
 
 
+//------------------------------------------------------------------------------
+template<class cInst,class cChromo,class cFit,class cThreadData>
+	bool R::RInst<cInst,cChromo,cFit,cThreadData>::EvaluateChromosomes(size_t th)
+{
+	bool Evaluated(false);
+
+	for(size_t i=th;i<PopSize;i+=NbThreads)
+	{
+		cChromo* C(Chromosomes[i]);
+		if(C->ToEval)
+		{
+			C->Evaluate();
+			C->ToEval=false;
+			Evaluated=true;
+		}
+	}
+	return(Evaluated);
+}
+
+
+//------------------------------------------------------------------------------
+template<class cInst,class cChromo,class cFit,class cThreadData>
+	bool R::RInst<cInst,cChromo,cFit,cThreadData>::CrossoverChromosomes(size_t th)
+{
+	bool Treated(false);
+	cChromo **Child,**Parents;
+	size_t i;
+
+	// The children are at the end of tmpChrom2 and the parents at the beginning
+	for(i=NbCross+1,Child=&tmpChrom2[PopSize-1],Parents=tmpChrom2;--i;Child-=2,Parents+=2)
+	{
+		if(Child[0]->GetId()%NbThreads==th)
+		{
+			Child[0]->Crossover(Parents[1],Parents[0]);
+			Child[0]->ToEval=true;
+			if(VerifyGA)
+				Child[0]->Verify();
+			Treated=true;
+		}
+		if(Child[-1]->GetId()%NbThreads==th)
+		{
+			Child[-1]->Crossover(Parents[0],Parents[1]);
+			Child[-1]->ToEval=true;
+			if(VerifyGA)
+				Child[-1]->Verify();
+			Treated=true;
+		}
+	}
+	return(Treated);
+}
+
+
+//------------------------------------------------------------------------------
+template<class cInst,class cChromo,class cFit,class cThreadData>
+	bool R::RInst<cInst,cChromo,cFit,cThreadData>::RunTask(size_t th)
+{
+	switch(Task)
+	{
+		case tEvaluate:
+			return(EvaluateChromosomes(th));
+		case tCrossover:
+			return(CrossoverChromosomes(th));
+	}
+	return(false);
+}
+
+
+//------------------------------------------------------------------------------
+template<class cInst,class cChromo,class cFit,class cThreadData>
+	bool R::RInst<cInst,cChromo,cFit,cThreadData>::RunThreads(tTask task)
+{
+	// Each "thread-dependent" data is treated by one task of the pool
+	Task=task;
+	RInstTask<cInst,cChromo,cFit,cThreadData> Func(this);
+	try
+	{
+		Pool->ParallelFor(0,NbThreads,Func);
+	}
+	catch(RException& e)
+	{
+		mThrowRGAException(Task==tEvaluate?"Evaluation":"Crossover",e.GetMsg());
+	}
+	return(Func.IsTreated());
+}
+
+
+//------------------------------------------------------------------------------
+template<class cInst,class cChromo,class cFit,class cThreadData>
+	bool R::RInst<cInst,cChromo,cFit,cThreadData>::FindInCache(cChromo* chromo)
+{
+	size_t Hash(chromo->HashGenotype());
+	CacheHashes[chromo->Id]=0;
+	if(!Hash)
+		return(false);
+	chromo->SaveGenotype(CacheGenotype);
+	if(FitnessCache->Find(Hash,CacheGenotype,*chromo->Fitness,CacheValues))
+	{
+		chromo->RestoreEvaluation(CacheValues);
+		if(Debug)
+			Debug->PrintInfo("Chromosome "+RString::Number(chromo->GetId())+" found in the fitness cache");
+		return(true);
+	}
+	CacheHashes[chromo->Id]=Hash;
+	return(false);
+}
+
+
+//------------------------------------------------------------------------------
+template<class cInst,class cChromo,class cFit,class cThreadData>
+	void R::RInst<cInst,cChromo,cFit,cThreadData>::StoreInCache(void)
+{
+	size_t i,*Hash;
+	cChromo** C;
+
+	for(i=PopSize+1,C=Chromosomes;--i;C++)
+	{
+		Hash=&CacheHashes[(*C)->Id];
+		if(!(*Hash))
+			continue;
+		CacheValues.Clear();
+		(*C)->SaveEvaluation(CacheValues);
+		(*C)->SaveGenotype(CacheGenotype);
+		FitnessCache->Insert(*Hash,CacheGenotype,*(*C)->Fitness,CacheValues);
+		(*Hash)=0;
+	}
+}
+
+
+//------------------------------------------------------------------------------
+template<class cInst,class cChromo,class cFit,class cThreadData>
+	void R::RInst<cInst,cChromo,cFit,cThreadData>::RankChromosomes(void)
+{
+	size_t i,NbClean(0),NbDirty(0);
+	cChromo **C,**Clean,**Eval,**Merged;
+	RSort<cChromo*,RSortStatic<cChromo*,sort_function_cChromosome> > Sort;
+
+	// Separate the chromosomes evaluated from the other ones (useless if all
+	// the fitnesses were recomputed)
+	if(PostEvaluateFitness)
+		bRanked=false;
+	if(bRanked)
+	{
+		for(i=PopSize+1,C=Ranked;--i;C++)
+		{
+			if(Dirty[(*C)->Id])
+				tmpChrom1[NbDirty++]=(*C);
+			else
+				Ranked[NbClean++]=(*C);
+		}
+
+		// Verify that the other chromosomes are still ordered
+		for(i=1,C=Ranked;i<NbClean;i++,C++)
+			if(sort_function_cChromosome(C,C+1)>0)
+			{
+				bRanked=false;
+				break;
+			}
+	}
+
+	memset(Dirty,0,PopSize*sizeof(bool));
+	if(!bRanked)
+	{
+		// Sort all the chromosomes
+		memcpy(Ranked,Chromosomes,sizeof(cChromo*)*PopSize);
+		Sort.Sort(Ranked,PopSize);
+		bRanked=true;
+		return;
+	}
+	if(!NbDirty)
+		return;
+
+	// Sort the chromosomes evaluated and merge them with the other ones
+	Sort.Sort(tmpChrom1,NbDirty);
+	for(Clean=Ranked,Eval=tmpChrom1,Merged=tmpChrom2;NbClean&&NbDirty;Merged++)
+	{
+		if(sort_function_cChromosome(Eval,Clean)<0)
+		{
+			(*Merged)=(*(Eval++));
+			NbDirty--;
+		}
+		else
+		{
+			(*Merged)=(*(Clean++));
+			NbClean--;
+		}
+	}
+	if(NbClean)
+		memcpy(Merged,Clean,sizeof(cChromo*)*NbClean);
+	else
+		memcpy(Merged,Eval,sizeof(cChromo*)*NbDirty);
+	C=Ranked;
+	Ranked=tmpChrom2;
+	tmpChrom2=C;
+}
+
+
 //------------------------------------------------------------------------------
 template<class cInst,class cChromo,class cFit,class cThreaData>
 	void R::RInst<cInst,cChromo,cFit,cThreaData>::AnalyzePop(void)
 {
-	size_t i;
+	size_t i,NbEvaluations(0);
 	cChromo **C;
 
 	if(Debug)
 		Debug->BeginFunc("AnalyzePop","RInst");
 
-	// Evaluate all the chromosomes if necessary
-	PostNotification("RInst::Interact");
+	// Remember the chromosomes to evaluate and look if some are in the cache
+	Profile.Start(gaEvaluation);
 	for(i=PopSize+1,C=Chromosomes;--i;C++)
 	{
-		if((*C)->ToEval)
+		if(!(*C)->ToEval)
+			continue;
+		Dirty[(*C)->Id]=true;
+		if(FitnessCache&&FindInCache(*C))
 		{
-			(*C)->Evaluate();
 			(*C)->ToEval=false;
 			DoPostEvaluation=true;
-			PostNotification("RInst::Interact");
 		}
+		else
+			NbEvaluations++;
 	}
-	PostNotification("RInst::Interact");
+
+	// Evaluate all the chromosomes if necessary
+	Interact();
+	if(NbThreads>1)
+	{
+		if(RunThreads(tEvaluate))
+			DoPostEvaluation=true;
+	}
+	else
+	{
+		for(i=PopSize+1,C=Chromosomes;--i;C++)
+		{
+			if((*C)->ToEval)
+			{
+				(*C)->Evaluate();
+				(*C)->ToEval=false;
+				DoPostEvaluation=true;
+				Interact();
+			}
+		}
+	}
+	if(FitnessCache)
+		StoreInCache();
+	Profile.Stop(gaEvaluation);
+	Profile.AddEvaluations(NbEvaluations);
+	Interact();
 
 	// If necessary, do a post evaluation
 	if(DoPostEvaluation)
 	{
+		Profile.Start(gaPostEvaluation);
 		PostEvaluate();
+		Profile.Stop(gaPostEvaluation);
 		DoPostEvaluation=true;
 	};
-	PostNotification("RInst::Interact");
+	Interact();
 
 	// Ranked the chromosomes and verify that the best of the population or the best ever have not changed.
-	memcpy(Ranked,Chromosomes,sizeof(cChromo*)*PopSize);
-	qsort(static_cast<void*>(Ranked),PopSize,sizeof(cChromo*),sort_function_cChromosome);
+	Profile.Start(gaRanking);
+	RankChromosomes();
+	Profile.Stop(gaRanking);
 	cChromo* best=Ranked[0];
 	if((*best->Fitness)>(*BestInPop->Fitness))
 	{
@@ -186,7 +538,10 @@ template<class cInst,class cChromo,class cFit,class cThreaData>
 		BestChromosome->Copy(*BestInPop);
 		AgeBest=0;
 		AgeNextBestMutation=FreqBestMutation;
-		PostNotification("RInst::Best",(size_t)Gen);
+		if(DeferNotifications)
+			DeferredBest.Insert(Gen);
+		else
+			PostNotification(hBest,(size_t)Gen);
 	}
 	if(Debug)
 		Debug->EndFunc("AnalyzePop","RInst");
@@ -206,11 +561,11 @@ template<class cInst,class cChromo,class cFit,class cThreadData>
 	for(i=PopSize+1,C=Chromosomes;--i;C++)
 	{
 		(*C)->RandomConstruct();
-		PostNotification("RInst::Interact");
+		Interact();
 		(*C)->ToEval=true;
 	}
 	bRandomConstruct=true;
-	PostNotification("RInst::Interact");
+	Interact();
 	if(VerifyGA)
 		Verify();
 
@@ -272,9 +627,15 @@ template<class cInst,class cChromo,class cFit,class cThreadData>
 		}
 	}
 	tmpChrom2[0]=tmpChrom1[0];
-	PostNotification("RInst::Interact");
+	Interact();
 
-	// Make the crossovers
+	// Make the crossovers in parallel if possible
+	if((NbThreads>1)&&(!Debug))
+	{
+		RunThreads(tCrossover);
+		Interact();
+		return;
+	}
 	for(C1=&tmpChrom2[PopSize-1],C2=tmpChrom2,i=NbCross+1;--i;C1--,C2++) // To change if crossover not possible
 	{
 		// First Crossover
@@ -285,7 +646,7 @@ template<class cInst,class cChromo,class cFit,class cThreadData>
 		(*C1)->ToEval=true;
 		if(VerifyGA)
 			(*C1)->Verify();
-		PostNotification("RInst::Interact");
+		Interact();
 
 		// Second Crossover
 		C1--;
@@ -295,7 +656,7 @@ template<class cInst,class cChromo,class cFit,class cThreadData>
 		(*C1)->ToEval=true;
 		if(VerifyGA)
 			(*C1)->Verify();
-		PostNotification("RInst::Interact");
+		Interact();
 	}
 	if(Debug)
 		Debug->EndFunc("Crossover","RInst");
@@ -323,12 +684,12 @@ template<class cInst,class cChromo,class cFit,class cThreadData>
 
 		if(Debug)
 			Debug->PrintInfo("Normal Mutation (BestInPop) -> Chromosome "+RString::Number(p->GetId()));
-		PostNotification("RInst::Interact");
+		Interact();
 		p->Mutation();
 		p->ToEval=true;
 		if(VerifyGA)
 			p->Verify();
-		PostNotification("RInst::Interact");
+		Interact();
 	}
 
 	if(Debug)
@@ -352,12 +713,12 @@ template<class cInst,class cChromo,class cFit,class cThreadData>
 		p->Id=id;
 		if(Debug)
 			Debug->PrintInfo("Strong Mutation (BestInPop) -> Chromosome "+RString::Number(p->GetId()));
-		PostNotification("RInst::Interact");
+		Interact();
 		p->StrongMutation();
 		p->ToEval=true;
 		if(VerifyGA)
 			p->Verify();
-		PostNotification("RInst::Interact");
+		Interact();
 	}
 
 	if(Debug)
@@ -386,6 +747,54 @@ template<class cInst,class cChromo,class cFit,class cThreadData>
 }
 
 
+//------------------------------------------------------------------------------
+template<class cInst,class cChromo,class cFit,class cThreadData>
+	void R::RInst<cInst,cChromo,cFit,cThreadData>::EndGenProfile(void)
+{
+	if(!Profile.IsEnabled())
+		return;
+	Profile.EndGen(Gen);
+	if(DeferNotifications)
+		DeferredProfile=true;
+	else if(NotificationCenter.IsObserved(hProfile,this))
+		PostNotification<const RGAProfile*>(hProfile,&Profile);
+}
+
+
+//------------------------------------------------------------------------------
+template<class cInst,class cChromo,class cFit,class cThreadData>
+	void R::RInst<cInst,cChromo,cFit,cThreadData>::PostGeneration(void)
+{
+	if(DeferNotifications)
+		DeferredGeneration.Insert(Gen);
+	else
+		PostNotification(hGeneration,(size_t)Gen);
+}
+
+
+//------------------------------------------------------------------------------
+template<class cInst,class cChromo,class cFit,class cThreadData>
+	void R::RInst<cInst,cChromo,cFit,cThreadData>::PostDeferredNotifications(void)
+{
+	// A "RInst::Best" notification precedes the "RInst::Generation" one of its generation
+	size_t Best(0);
+	RNumCursor<size_t> Cur(DeferredGeneration);
+	for(Cur.Start();!Cur.End();Cur.Next())
+	{
+		for(;(Best<DeferredBest.GetNb())&&(DeferredBest[Best]<=Cur());Best++)
+			PostNotification(hBest,DeferredBest[Best]);
+		PostNotification(hGeneration,Cur());
+	}
+	for(;Best<DeferredBest.GetNb();Best++)
+		PostNotification(hBest,DeferredBest[Best]);
+	if(DeferredProfile&&NotificationCenter.IsObserved(hProfile,this))
+		PostNotification<const RGAProfile*>(hProfile,&Profile);
+	DeferredBest.Clear();
+	DeferredGeneration.Clear();
+	DeferredProfile=false;
+}
+
+
 //------------------------------------------------------------------------------
 template<class cInst,class cChromo,class cFit,class cThreadData>
 	void R::RInst<cInst,cChromo,cFit,cThreadData>::Generation(void)
@@ -397,38 +806,47 @@ template<class cInst,class cChromo,class cFit,class cThreadData>
 	AgeBestPop++;
 	if(Debug)
 		Debug->PrintComment("Gen="+RString::Number(Gen)+"  ;  AgeBest="+RString::Number(AgeBest)+"  -  AgeBestPop="+RString::Number(AgeBestPop));
+	Profile.Start(gaCrossover);
 	Crossover();
-	PostNotification("RInst::Interact");
+	Profile.Stop(gaCrossover);
+	Interact();
 	if(!(--AgeNextMutation))  // Decrease the number of generations between mutations and verify if a mutation must be done
 	{
 		// Evaluation is necessary since the crossover has been done
 		AnalyzePop();
-		PostNotification("RInst::Interact");
+		Interact();
+		Profile.Start(gaMutation);
 		Mutation();
+		Profile.Stop(gaMutation);
 		AgeNextMutation=FreqMutation;
 	}
-	PostNotification("RInst::Interact");
+	Interact();
 	if(!(--AgeNextBestMutation))  // Decrease the number of generations between mutations and verify if a mutation must be done
 	{
 		// Evaluation is necessary since the crossover has been done
 		AnalyzePop();
-		PostNotification("RInst::Interact");
+		Interact();
+		Profile.Start(gaStrongMutation);
 		StrongMutation();
+		Profile.Stop(gaStrongMutation);
 		AgeNextBestMutation=FreqBestMutation;
 	}
-	PostNotification("RInst::Interact");
+	Interact();
 	if(!(--AgeNextInversion)) // Decrease the number of generations between inversions and verify if a mutation must be done
 	{
 		// Evaluation is necessary since the crossover has been done (and perhaps Mutation)
 		AnalyzePop();
-		PostNotification("RInst::Interact");
+		Interact();
+		Profile.Start(gaInversion);
 		Inversion();
+		Profile.Stop(gaInversion);
 		AgeNextInversion=FreqInversion;
 	}
-	PostNotification("RInst::Interact");
+	Interact();
 	AnalyzePop();
-	PostNotification("RInst::Generation",(size_t)Gen);
-	PostNotification("RInst::Interact");
+	EndGenProfile();
+	PostGeneration();
+	Interact();
 	if(Debug)
 		Debug->EndFunc("Generation","RInst");
 }
@@ -442,10 +860,13 @@ template<class cInst,class cChromo,class cFit,class cThreadData>
 		Debug->BeginFunc("Run","RInst");
 	if(!bRandomConstruct)
 	{
+		Profile.Start(gaRandomConstruct);
 		RandomConstruct();
-		PostNotification("RInst::Interact");
+		Profile.Stop(gaRandomConstruct);
+		Interact();
 		AnalyzePop();
-		PostNotification("RInst::Generation",(size_t)Gen);
+		EndGenProfile();
+		PostGeneration();
 		DisplayInfos();
 	}
 	ExternBreak = false;
@@ -472,7 +893,7 @@ template<class cInst,class cChromo,class cFit,class cThreadData>
 	for(i=PopSize+1,C=Chromosomes;--i;C++)
 	{
 		(*C)->Verify();
-		PostNotification("RInst::Interact");
+		Interact();
 	}
 	if(Debug)
 	{
@@ -511,11 +932,16 @@ template<class cInst,class cChromo,class cFit,class cThreadData>
 	if(BestChromosome) delete BestChromosome;
 	if(tmpChrom1) delete[] tmpChrom1;
 	if(tmpChrom2) delete[] tmpChrom2;
+	if(Dirty) delete[] Dirty;
+	if(CacheHashes) delete[] CacheHashes;
+	if(FitnessCache) delete FitnessCache;
+	if(Pool) delete Pool;
 	if(Debug)
 		Debug->EndApp(GetName());
 	if(thDatas)
 	{
-		delete thDatas[0];
+		for(i=0;i<NbThreads;i++)
+			delete thDatas[i];
 		delete[] thDatas;
 	}
 }
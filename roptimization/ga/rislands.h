@@ -0,0 +1,363 @@
+/*
+
+	R Project Library
+
+	RIslands.h
+
+	Island Model of Genetic Algorithms - Header
+
+	Copyright 1998-2015 by Pascal Francq (pascal@francq.info).
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Library General Public
+	License as published by the Free Software Foundation; either
+	version 2.0 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Library General Public License for more details.
+
+	You should have received a copy of the GNU Library General Public
+	License along with this library, as a file COPYING.LIB; if not, write
+	to the Free Software Foundation, Inc., 59 Temple Place, Suite 330,
+	Boston, MA  02111-1307  USA
+
+*/
+
+
+
+//------------------------------------------------------------------------------
+#ifndef RIslands_H
+#define RIslands_H
+
+
+//------------------------------------------------------------------------------
+// include files for R Project
+#include <rinst.h>
+
+
+//------------------------------------------------------------------------------
+namespace R{
+//------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------
+// Forward declaration
+template<class cInst,class cChromo,class cFit,class cThreadData> class RIslands;
+
+
+//------------------------------------------------------------------------------
+/**
+* The RIsland class provides a sub-population of an island model. It owns the
+* instance of the GA and the thread that runs it during an epoch. The
+* identifier of the thread is the index of the island.
+* @short GA Island.
+*/
+template<class cInst,class cChromo,class cFit,class cThreadData>
+	class RIsland : public RThread
+{
+	/**
+	* Island model.
+	*/
+	RIslands<cInst,cChromo,cFit,cThreadData>* Owner;
+
+	/**
+	* Instance of the GA running on the island.
+	*/
+	cInst* Instance;
+
+	/**
+	* Have chromosomes immigrated since the last epoch?
+	*/
+	bool Immigrants;
+
+	/**
+	* Message of the exception that occurs in the thread. It is only allocated
+	* if an exception occurs, so that the null string is not shared between
+	* the threads.
+	*/
+	RString* Error;
+
+public:
+
+	/**
+	* Construct the island.
+	* @param owner          Island model.
+	* @param inst           Instance of the GA (the island is responsible for
+	*                       its deallocation).
+	* @param id             Identifier of the island.
+	*/
+	RIsland(RIslands<cInst,cChromo,cFit,cThreadData>* owner,cInst* inst,size_t id);
+
+	/**
+	* Compare two islands.
+	* @param island          Island to compare with.
+	* @return a value compatible with R::RContainer.
+	*/
+	int Compare(const RIsland& island) const {return(CompareIds(GetId(),island.GetId()));}
+
+	/**
+	* Get the instance of the GA running on the island.
+	*/
+	cInst* GetInstance(void) const {return(Instance);}
+
+	/**
+	* Run an epoch on the island.
+	*/
+	virtual void Run(void);
+
+	/**
+	* Destruct the island.
+	*/
+	virtual ~RIsland(void);
+
+	friend class RIslands<cInst,cChromo,cFit,cThreadData>;
+};
+
+
+//------------------------------------------------------------------------------
+/**
+* The RIslands class provides an island model for the generic GA. Several
+* instances (the islands) evolve their own population in parallel, each one in
+* its own thread, and exchange periodically their best chromosomes.
+*
+* The islands run by epochs. During an epoch, each island does a given number
+* of generations (or less if its stop condition is reached). At the end of an
+* epoch, the best chromosomes of each island replace the worst chromosomes of
+* another island (the identifiers of the replaced chromosomes are kept). The
+* islands are connected in a ring (island i sends its emigrants to island
+* i+1), or in a ring randomly rebuilt at each migration. The immigrants are
+* re-evaluated by their new island at the beginning of the next epoch.
+*
+* Each island keeps its own best chromosome and its own ages (RInst::AgeBest
+* and RInst::AgeBestPop). The island model follows the best chromosome of all
+* the islands.
+* @code
+* RIslands<MyInst,MyChromo,MyFit,MyThreadData> Islands("Islands",10,2);
+* for(size_t i=0;i<4;i++)
+* {
+*    MyInst* Inst=new MyInst(Objs,PopSize);
+*    Inst->Init();
+*    Islands.InsertIsland(Inst);
+* }
+* Islands.SetSeed(12345);
+* Islands.Run();
+* MyChromo* Best=Islands.GetBestChromosome();
+* @endcode
+* Since the islands run in parallel, they should not share a debugger. The
+* notifications emitted by the instances are deferred (see
+* RInst::SetDeferNotifications): they are posted by the thread running the
+* island model at the end of each epoch, and the "RInst::Interact"
+* notifications are not posted. By default, the island model stops when all
+* the islands have reached their stop condition.
+*
+* The island model emit several signals:
+* - PostNotification("RIslands::Best",size_t) : The best chromosome of all
+*   the islands has changed and the number of the epoch is given as parameter.
+* - PostNotification("RIslands::Epoch",size_t) : A new epoch (including the
+*   migration) has be done and its number is given as parameter.
+* @short Island Model of GA.
+*/
+template<class cInst,class cChromo,class cFit,class cThreadData>
+	class RIslands : public RObject
+{
+public:
+
+	/**
+	* Topology of the migrations.
+	*/
+	enum tTopology
+	{
+		Ring                 /** Island i sends its emigrants to island i+1.*/,
+		RandomRing           /** The order of the ring is randomly chosen at
+		                        each migration.*/
+	};
+
+protected:
+
+	/**
+	* The islands.
+	*/
+	RContainer<RIsland<cInst,cChromo,cFit,cThreadData>,true,false> Islands;
+
+	/**
+	* Random number generator used for the migrations.
+	*/
+	RRandom Random;
+
+	/**
+	* Number of generations done by each island between two migrations.
+	*/
+	size_t FreqMigration;
+
+	/**
+	* Number of chromosomes sent by each island during a migration.
+	*/
+	size_t NbMigrants;
+
+	/**
+	* Topology of the migrations.
+	*/
+	tTopology Topology;
+
+	/**
+	* Number of epochs done.
+	*/
+	size_t Epoch;
+
+	/**
+	* Number of epochs since the best chromosome has changed.
+	*/
+	size_t AgeBest;
+
+	/**
+	* Island containing the best chromosome.
+	*/
+	cInst* BestIsland;
+
+	/**
+	* Fitness of the best chromosome.
+	*/
+	cFit* BestFitness;
+
+	/**
+	* Have the populations of the islands been constructed?
+	*/
+	bool bRandomConstruct;
+
+	/**
+	* Temporary array used to build the topology.
+	*/
+	RIsland<cInst,cChromo,cFit,cThreadData>** tmpIslands;
+
+public:
+
+	/**
+	* Construct the island model.
+	* @param name           Name of the island model.
+	* @param freq           Number of generations between two migrations.
+	* @param nbmigrants     Number of chromosomes sent by each island.
+	* @param topology       Topology of the migrations.
+	*/
+	RIslands(const RString& name,size_t freq,size_t nbmigrants,tTopology topology=Ring);
+
+	/**
+	 * Return the name of the class.
+	 */
+	virtual RCString GetClassName(void) const {return("RIslands");}
+
+	/**
+	* Add an island. The instance must be initialized and the island model is
+	* responsible for its deallocation.
+	* @param inst           Instance of the GA.
+	*/
+	void InsertIsland(cInst* inst);
+
+	/**
+	* Get the number of islands.
+	*/
+	size_t GetNbIslands(void) const {return(Islands.GetNb());}
+
+	/**
+	* Get a given island.
+	* @param idx            Index of the island.
+	*/
+	cInst* GetIsland(size_t idx) const {return(Islands[idx]->Instance);}
+
+	/**
+	* Set the seed of the random number generator of the island model. The
+	* seeds of the islands inserted are drawn from it.
+	* @param seed           Seed.
+	*/
+	void SetSeed(int seed);
+
+	/**
+	* Set the parameters of the migrations.
+	* @param freq           Number of generations between two migrations.
+	* @param nbmigrants     Number of chromosomes sent by each island.
+	* @param topology       Topology of the migrations.
+	*/
+	void SetMigrationParams(size_t freq,size_t nbmigrants,tTopology topology);
+
+	/**
+	* Get the number of epochs done.
+	*/
+	size_t GetEpoch(void) const {return(Epoch);}
+
+	/**
+	* Get the number of epochs since the best chromosome has changed.
+	*/
+	size_t GetAgeBest(void) const {return(AgeBest);}
+
+	/**
+	* Get the island containing the best chromosome.
+	*/
+	cInst* GetBestIsland(void) const {return(BestIsland);}
+
+	/**
+	* Get the best chromosome of all the islands.
+	*/
+	cChromo* GetBestChromosome(void) const {return(BestIsland?BestIsland->GetBestChromosome():0);}
+
+	/**
+	* Condition to stop the island model. By default, it is reached when all
+	* the islands have reached their own stop condition.
+	*/
+	virtual bool StopCondition(void);
+
+	/**
+	* Migrate the best chromosomes between the islands.
+	*/
+	virtual void Migration(void);
+
+	/**
+	* Run an epoch on all the islands, followed by a migration.
+	*/
+	void RunEpoch(void);
+
+	/**
+	* Run the island model.
+	*/
+	virtual void Run(void);
+
+private:
+
+	/**
+	* Run the current epoch on a given island.
+	* @param island         Island.
+	*/
+	void RunIsland(RIsland<cInst,cChromo,cFit,cThreadData>* island);
+
+	/**
+	* Run the current epoch on all the islands in parallel.
+	*/
+	void RunIslands(void);
+
+	/**
+	* Look if the best chromosome of an island is better than the best one
+	* found.
+	*/
+	void AnalyzeIslands(void);
+
+public:
+
+	/**
+	* Destruct the island model.
+	*/
+	virtual ~RIslands(void);
+
+	friend class RIsland<cInst,cChromo,cFit,cThreadData>;
+};
+
+
+//------------------------------------------------------------------------------
+// inline implementation
+#include <rislands.hh>
+
+
+}  //------- End of namespace R ------------------------------------------------
+
+
+//------------------------------------------------------------------------------
+#endif
@@ -0,0 +1,321 @@
+/*
+
+	R Project Library
+
+	RIslands.hh
+
+	Island Model of Genetic Algorithms - Inline Implementation
+
+	Copyright 1998-2015 by Pascal Francq (pascal@francq.info).
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Library General Public
+	License as published by the Free Software Foundation; either
+	version 2.0 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Library General Public License for more details.
+
+	You should have received a copy of the GNU Library General Public
+	License along with this library, as a file COPYING.LIB; if not, write
+	to the Free Software Foundation, Inc., 59 Temple Place, Suite 330,
+	Boston, MA  02111-1307  USA
+
+*/
+
+
+
+//------------------------------------------------------------------------------
+//
+// RIsland<cInst,cChromo,cFit,cThreadData>
+//
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+template<class cInst,class cChromo,class cFit,class cThreadData>
+	R::RIsland<cInst,cChromo,cFit,cThreadData>::RIsland(R::RIslands<cInst,cChromo,cFit,cThreadData>* owner,cInst* inst,size_t id)
+		: RThread(id), Owner(owner), Instance(inst), Immigrants(false), Error(0)
+{
+}
+
+
+//------------------------------------------------------------------------------
+template<class cInst,class cChromo,class cFit,class cThreadData>
+	void R::RIsland<cInst,cChromo,cFit,cThreadData>::Run(void)
+{
+	try
+	{
+		Owner->RunIsland(this);
+	}
+	catch(RException& e)
+	{
+		Error=new RString(e.GetMsg());
+	}
+	catch(std::exception& e)
+	{
+		Error=new RString(e.what());
+	}
+	catch(...)
+	{
+		Error=new RString("Unknown exception");
+	}
+}
+
+
+//------------------------------------------------------------------------------
+template<class cInst,class cChromo,class cFit,class cThreadData>
+	R::RIsland<cInst,cChromo,cFit,cThreadData>::~RIsland(void)
+{
+	delete Error;
+	delete Instance;
+}
+
+
+
+//------------------------------------------------------------------------------
+//
+// RIslands<cInst,cChromo,cFit,cThreadData>
+//
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+template<class cInst,class cChromo,class cFit,class cThreadData>
+	R::RIslands<cInst,cChromo,cFit,cThreadData>::RIslands(const R::RString& name,size_t freq,size_t nbmigrants,tTopology topology)
+		: RObject(name), Islands(10), Random(RRandom::Good,12345), FreqMigration(freq), NbMigrants(nbmigrants),
+		  Topology(topology), Epoch(0), AgeBest(0), BestIsland(0), BestFitness(new cFit()),
+		  bRandomConstruct(false), tmpIslands(0)
+{
+	if(!FreqMigration)
+		mThrowRGAException("Parameters","At least one generation must be done between two migrations");
+}
+
+
+//------------------------------------------------------------------------------
+template<class cInst,class cChromo,class cFit,class cThreadData>
+	void R::RIslands<cInst,cChromo,cFit,cThreadData>::InsertIsland(cInst* inst)
+{
+	if(!inst)
+		mThrowRGAException("Parameters","Null instance");
+	if(bRandomConstruct)
+		mThrowRGAException("Parameters","Islands cannot be added once the island model has run");
+	if(2*NbMigrants>=inst->GetPopSize())
+		mThrowRGAException("Parameters","The number of migrants must be lesser than the half of the population size");
+
+	// Each island has its own seed drawn from the generator of the model, and
+	// its notifications are posted by the current thread
+	inst->SetSeed(static_cast<int>(Random.GetValue(INT_MAX-1))+1);
+	inst->SetDeferNotifications(true);
+	Islands.InsertPtr(new RIsland<cInst,cChromo,cFit,cThreadData>(this,inst,Islands.GetNb()));
+	delete[] tmpIslands;
+	tmpIslands=new RIsland<cInst,cChromo,cFit,cThreadData>*[Islands.GetNb()];
+}
+
+
+//------------------------------------------------------------------------------
+template<class cInst,class cChromo,class cFit,class cThreadData>
+	void R::RIslands<cInst,cChromo,cFit,cThreadData>::SetSeed(int seed)
+{
+	Random.Reset(seed);
+	RCursor<RIsland<cInst,cChromo,cFit,cThreadData> > Cur(Islands);
+	for(Cur.Start();!Cur.End();Cur.Next())
+		Cur()->Instance->SetSeed(static_cast<int>(Random.GetValue(INT_MAX-1))+1);
+}
+
+
+//------------------------------------------------------------------------------
+template<class cInst,class cChromo,class cFit,class cThreadData>
+	void R::RIslands<cInst,cChromo,cFit,cThreadData>::SetMigrationParams(size_t freq,size_t nbmigrants,tTopology topology)
+{
+	if(!freq)
+		mThrowRGAException("Parameters","At least one generation must be done between two migrations");
+	RCursor<RIsland<cInst,cChromo,cFit,cThreadData> > Cur(Islands);
+	for(Cur.Start();!Cur.End();Cur.Next())
+		if(2*nbmigrants>=Cur()->Instance->GetPopSize())
+			mThrowRGAException("Parameters","The number of migrants must be lesser than the half of the population size");
+	FreqMigration=freq;
+	NbMigrants=nbmigrants;
+	Topology=topology;
+}
+
+
+//------------------------------------------------------------------------------
+template<class cInst,class cChromo,class cFit,class cThreadData>
+	bool R::RIslands<cInst,cChromo,cFit,cThreadData>::StopCondition(void)
+{
+	RCursor<RIsland<cInst,cChromo,cFit,cThreadData> > Cur(Islands);
+	for(Cur.Start();!Cur.End();Cur.Next())
+		if(!Cur()->Instance->StopCondition())
+			return(false);
+	return(true);
+}
+
+
+//------------------------------------------------------------------------------
+template<class cInst,class cChromo,class cFit,class cThreadData>
+	void R::RIslands<cInst,cChromo,cFit,cThreadData>::Migration(void)
+{
+	size_t Nb(Islands.GetNb());
+	if((Nb<2)||(!NbMigrants))
+		return;
+
+	// Build the ring
+	Islands.GetTab(tmpIslands);
+	if(Topology==RandomRing)
+		Random.RandOrder(tmpIslands,Nb);
+
+	// Each island sends its best chromosomes to the next one, where they replace
+	// the worst chromosomes (except the best of the population). Since less
+	// than the half of a population migrates, the emigrants of an island are
+	// never replaced by its immigrants.
+	for(size_t i=0;i<Nb;i++)
+	{
+		cInst* From(tmpIslands[i]->Instance);
+		RIsland<cInst,cChromo,cFit,cThreadData>* To(tmpIslands[(i+1)%Nb]);
+		cChromo** Emigrant=From->Ranked;
+		cChromo** Replaced=&To->Instance->Ranked[To->Instance->GetPopSize()-1];
+		for(size_t j=NbMigrants+1;--j;Emigrant++,Replaced--)
+		{
+			if((*Replaced)==To->Instance->BestInPop)
+				Replaced--;
+			size_t id=(*Replaced)->GetId();
+			(*Replaced)->Copy(**Emigrant);
+			(*Replaced)->Id=id;
+			(*Replaced)->ToEval=true;
+		}
+		To->Immigrants=true;
+	}
+}
+
+
+//------------------------------------------------------------------------------
+template<class cInst,class cChromo,class cFit,class cThreadData>
+	void R::RIslands<cInst,cChromo,cFit,cThreadData>::RunIsland(RIsland<cInst,cChromo,cFit,cThreadData>* island)
+{
+	cInst* Inst(island->Instance);
+
+	// The first epoch constructs and evaluates the population
+	if(!bRandomConstruct)
+	{
+		Inst->GetProfile().Start(gaRandomConstruct);
+		Inst->RandomConstruct();
+		Inst->GetProfile().Stop(gaRandomConstruct);
+		Inst->AnalyzePop();
+		Inst->EndGenProfile();
+		Inst->PostGeneration();
+		Inst->DisplayInfos();
+		return;
+	}
+
+	// Evaluate the immigrants
+	if(island->Immigrants)
+	{
+		Inst->AnalyzePop();
+		island->Immigrants=false;
+	}
+
+	for(size_t i=FreqMigration+1;(--i)&&(!Inst->StopCondition())&&(!ExternBreak);)
+	{
+		Inst->Generation();
+		Inst->DisplayInfos();
+	}
+}
+
+
+//------------------------------------------------------------------------------
+template<class cInst,class cChromo,class cFit,class cThreadData>
+	void R::RIslands<cInst,cChromo,cFit,cThreadData>::RunIslands(void)
+{
+	if(!Islands.GetNb())
+		return;
+
+	// Launch the islands and run the first one in the current thread
+	RCursor<RIsland<cInst,cChromo,cFit,cThreadData> > Cur(Islands);
+	for(Cur.Start();!Cur.End();Cur.Next())
+	{
+		delete Cur()->Error;
+		Cur()->Error=0;
+		if(Cur()->GetId())
+			Cur()->Start();
+	}
+	Islands[0]->Run();
+
+	// Wait that all islands are finished and post their notifications
+	RIsland<cInst,cChromo,cFit,cThreadData>* Failed(0);
+	for(Cur.Start();!Cur.End();Cur.Next())
+	{
+		if(Cur()->GetId())
+			Cur()->Wait();
+		if(Cur()->Error&&(!Failed))
+			Failed=Cur();
+		Cur()->Instance->PostDeferredNotifications();
+	}
+	if(Failed)
+		mThrowRGAException("Island","Island "+RString::Number(Failed->GetId())+": "+(*Failed->Error));
+}
+
+
+//------------------------------------------------------------------------------
+template<class cInst,class cChromo,class cFit,class cThreadData>
+	void R::RIslands<cInst,cChromo,cFit,cThreadData>::AnalyzeIslands(void)
+{
+	bool Best(false);
+	RCursor<RIsland<cInst,cChromo,cFit,cThreadData> > Cur(Islands);
+	for(Cur.Start();!Cur.End();Cur.Next())
+	{
+		cChromo* Chromo(Cur()->Instance->GetBestChromosome());
+		if((!BestIsland)||((*Chromo->Fitness)>(*BestFitness)))
+		{
+			BestIsland=Cur()->Instance;
+			(*BestFitness)=(*Chromo->Fitness);
+			Best=true;
+		}
+	}
+	if(Best)
+	{
+		AgeBest=0;
+		PostNotification("RIslands::Best",Epoch);
+	}
+}
+
+
+//------------------------------------------------------------------------------
+template<class cInst,class cChromo,class cFit,class cThreadData>
+	void R::RIslands<cInst,cChromo,cFit,cThreadData>::RunEpoch(void)
+{
+	Epoch++;
+	AgeBest++;
+	RunIslands();
+	AnalyzeIslands();
+	Migration();
+	PostNotification("RIslands::Epoch",Epoch);
+}
+
+
+//------------------------------------------------------------------------------
+template<class cInst,class cChromo,class cFit,class cThreadData>
+	void R::RIslands<cInst,cChromo,cFit,cThreadData>::Run(void)
+{
+	ExternBreak=false;
+	if(!bRandomConstruct)
+	{
+		RunIslands();
+		bRandomConstruct=true;
+		AnalyzeIslands();
+	}
+	while((!StopCondition())&&(!ExternBreak))
+		RunEpoch();
+	RCursor<RIsland<cInst,cChromo,cFit,cThreadData> > Cur(Islands);
+	for(Cur.Start();!Cur.End();Cur.Next())
+		Cur()->Instance->PostRun();
+}
+
+
+//------------------------------------------------------------------------------
+template<class cInst,class cChromo,class cFit,class cThreadData>
+	R::RIslands<cInst,cChromo,cFit,cThreadData>::~RIslands(void)
+{
+	delete BestFitness;
+	delete[] tmpIslands;
+}
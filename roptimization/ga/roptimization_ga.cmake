@@ -8,6 +8,11 @@ SET(roptimization_ga_INST_INCLUDES
 	 rinst.h
 	 rinst.hh
 	 irinst.h
+	 rislands.h
+	 rislands.hh
+	 rfitnesscache.h
+	 rfitnesscache.hh
+	 rgaprofile.h
 )
 
 
@@ -15,4 +20,5 @@ SET(roptimization_ga_TARGET_SOURCES
 	rdebug.cpp
    rga.cpp
 	irinst.cpp
+	rgaprofile.cpp
 )
\ No newline at end of file
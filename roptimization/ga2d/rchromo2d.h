@@ -57,6 +57,7 @@ template<class cInst,class cChromo,class cFit,class cThreadData,class cInfo>
 protected:
 	using RChromo<cInst,cChromo,cFit,cThreadData>::Id;
 	using RChromo<cInst,cChromo,cFit,cThreadData>::Instance;
+	using RChromo<cInst,cChromo,cFit,cThreadData>::thRandom;
 
 	/**
 	* The actual limits of the solution represented by the chromosome.
@@ -61,6 +61,8 @@ template<class cInst,class cChromo>
 
 public:
 
+	using RThreadData<cInst,cChromo>::Random;
+
 	/**
 	* Heuristic Used.
 	*/
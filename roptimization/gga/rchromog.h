@@ -58,6 +58,8 @@ template<class cInst,class cChromo,class cFit,class cThreadData,class cGroup,cla
 public:
 
 	using RChromo<cInst,cChromo,cFit,cThreadData>::Instance;
+	using RChromo<cInst,cChromo,cFit,cThreadData>::RRand;
+	using RChromo<cInst,cChromo,cFit,cThreadData>::RandOrder;
 	using RGroups<cGroup,cObj,cChromo>::ComputeOrd;
 	using RGroups<cGroup,cObj,cChromo>::ReserveGroup;
 	using RGroups<cGroup,cObj,cChromo>::ReleaseGroup;
@@ -175,6 +177,19 @@ public:
 	*/
 	virtual void Copy(const cChromo& chromo);
 
+	/**
+	* Compute a hash code of the genotype of the chromosome, i.e. of the
+	* clustering it represents (see RGroups::HashGroupment).
+	*/
+	virtual size_t HashGenotype(void);
+
+	/**
+	* Save the assignment of the objects where the groups are numbered in the
+	* order of their first object (see RGroups::ComputeOrd).
+	* @param genotype       Representation to fill.
+	*/
+	virtual void SaveGenotype(RNumContainer<size_t,false>& genotype);
+
 	/**
 	* Destruct the chromosome.
 	*/
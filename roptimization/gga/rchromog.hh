@@ -166,9 +166,9 @@ template<class cInst,class cChromo,class cFit,class cThreadData,class cGroup,cla
 	Clear();
 
 	// Select two crossing sites
-	pos1=Instance->RRand(parent1->Used.GetNb());
-	//len1=Instance->RRand(parent1->Used.GetNb()-pos1-1)+1;
-	end=Instance->RRand(parent1->Used.GetNb()-1)+1;
+	pos1=RRand(parent1->Used.GetNb());
+	//len1=RRand(parent1->Used.GetNb()-pos1-1)+1;
+	end=RRand(parent1->Used.GetNb()-1)+1;
 	if(end>parent1->Used.GetNb()-pos1)
 	{
 		i=parent1->Used.GetNb()-pos1;
@@ -177,7 +177,7 @@ template<class cInst,class cChromo,class cFit,class cThreadData,class cGroup,cla
 	}
 	else
 		begin=0;
-	pos2=Instance->RRand(parent2->Used.GetNb());
+	pos2=RRand(parent2->Used.GetNb());
 
 	// Insert groups from parent2<pos2 and verify that they dont contains "new"
 	// objects insert from parent1.
@@ -250,7 +250,7 @@ template<class cInst,class cChromo,class cFit,class cThreadData,class cGroup,cla
 	else
 		nb=1;
 	while(--nb)
-		ReleaseGroup(Used[Instance->RRand(Used.GetNb())]);
+		ReleaseGroup(Used[RRand(Used.GetNb())]);
 
 	// Insert missing objects after a local optimization
 	if(Instance->DoLocalOptimisation)
@@ -277,8 +277,8 @@ template<class cInst,class cChromo,class cFit,class cThreadData,class cGroup,cla
 	if(Instance->Debug)
 		Instance->Debug->BeginFunc("Inversion","RChromoG");
 
-	g1=Instance->RRand(Used.GetNb());
-	g2=g1+Instance->RRand(Used.GetNb()-2)+1;
+	g1=RRand(Used.GetNb());
+	g2=g1+RRand(Used.GetNb()-2)+1;
 	if(g2>Used.GetNb()-1)
 		g2-=Used.GetNb()-1;
 	mReturnIfFail(g2!=g1);
@@ -324,6 +324,27 @@ template<class cInst,class cChromo,class cFit,class cThreadData,class cGroup,cla
 }
 
 
+//------------------------------------------------------------------------------
+template<class cInst,class cChromo,class cFit,class cThreadData,class cGroup,class cObj>
+	size_t R::RChromoG<cInst,cChromo,cFit,cThreadData,cGroup,cObj>::HashGenotype(void)
+{
+	return(R::RGroups<cGroup,cObj,cChromo>::HashGroupment());
+}
+
+
+//------------------------------------------------------------------------------
+template<class cInst,class cChromo,class cFit,class cThreadData,class cGroup,class cObj>
+	void R::RChromoG<cInst,cChromo,cFit,cThreadData,cGroup,cObj>::SaveGenotype(R::RNumContainer<size_t,false>& genotype)
+{
+	size_t i,*ass;
+
+	R::RGroups<cGroup,cObj,cChromo>::ComputeOrd();
+	genotype.Clear();
+	for(i=R::RGroups<cGroup,cObj,cChromo>::Objs.GetMaxPos()+2,ass=R::RGroups<cGroup,cObj,cChromo>::OrdObjectsAss;--i;ass++)
+		genotype.Insert(*ass);
+}
+
+
 //------------------------------------------------------------------------------
 template<class cInst,class cChromo,class cFit,class cThreadData,class cGroup,class cObj>
 	R::RChromoG<cInst,cChromo,cFit,cThreadData,cGroup,cObj>::~RChromoG(void)
@@ -86,6 +86,13 @@ protected:
 	*/
 	bool Reserved;
 
+	/**
+	* Have the objects of the group changed since it was evaluated? The flag
+	* is set each time an object is inserted or deleted, and it should be
+	* reset by the inheriting classes that evaluate the group.
+	*/
+	bool Dirty;
+
 public:
 
 	/**
@@ -190,6 +197,11 @@ public:
 	*/
 	size_t GetObjsPos(void) const {return(SubObjects);}
 
+	/**
+	* Look if the objects of the group have changed since it was evaluated.
+	*/
+	bool IsDirty(void) const {return(Dirty);}
+
 	/**
 	* Return a cursor over the objects of a group.
 	*/
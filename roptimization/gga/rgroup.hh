@@ -42,6 +42,7 @@ template<class cGroup,class cObj,class cGroups>
 	NbSubObjects= grp->NbSubObjects;
 	SubObjects = grp->SubObjects;
 	Reserved=grp->Reserved;
+	Dirty=grp->Dirty;
 }
 
 
@@ -53,6 +54,7 @@ template<class cGroup,class cObj,class cGroups>
 	NbSubObjects= 0;
 	SubObjects = cNoRef;
 	Reserved=false;
+	Dirty=true;
 }
 
 
@@ -107,6 +109,7 @@ template<class cGroup,class cObj,class cGroups>
 	Reserved=false;
 	SubObjects=cNoRef;
 	NbSubObjects=0;
+	Dirty=true;
 }
 
 
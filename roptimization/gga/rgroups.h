@@ -49,6 +49,10 @@ namespace R{
 /**
 * The RGroups class provides a representation for a set of groups that have to
 * contain objects.
+*
+* Each time objects are inserted in or deleted from a group, it is marked as
+* dirty (see RGroup::IsDirty). The evaluation of a grouping can therefore
+* only recompute the values of the dirty groups.
 * @short Groups.
 */
 template<class cGroup,class cObj,class cGroups>
@@ -246,6 +250,14 @@ public:
 	*/
 	bool SameGroupment(const RGroups* grps) const;
 
+	/**
+	* Compute a hash code of the clustering. Two configurations representing
+	* the same clustering have the same hash code (OrdObjectsAss is
+	* computed).
+	* @return a non-null hash code.
+	*/
+	size_t HashGroupment(void);
+
 	/**
 	* Get a cursor over the objects already assigned.
 	*/
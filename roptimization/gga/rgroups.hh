@@ -170,6 +170,7 @@ template<class cGroup,class cObj,class cGroups>
 		ObjsAss.InsertPtrAt(obj,to->SubObjects,false);
 	}
 	to->NbSubObjects++;
+	to->Dirty=true;
 	ObjectsAss[obj->GetId()]=to->Id;
 	ObjsNoAss.DeletePtr(*obj);
 	to->PostInsert(obj);
@@ -183,6 +184,7 @@ template<class cGroup,class cObj,class cGroups>
 	mReturnIfFail(from->Owner!=to->Owner);
 	mReturnIfFail(!to->NbSubObjects);
 	if(!(from->NbSubObjects)) return;
+	to->Dirty=true;
 	bool CallPostInsert(to->PreInsertAll(from));
 	to->SubObjects=ObjsAss.GetNb();
 	to->NbSubObjects=from->NbSubObjects;
@@ -206,6 +208,7 @@ template<class cGroup,class cObj,class cGroups>
 	size_t j;
 
 	j=from->SubObjects;
+	from->Dirty=true;
 	ObjectsAss[obj->GetId()]=cNoRef;
 	ObjsNoAss.InsertPtr(obj);
 	ObjsAss.DeletePtr(*obj);
@@ -227,6 +230,7 @@ template<class cGroup,class cObj,class cGroups>
 	cObj* tmpObj;
 
 	if(!(from->NbSubObjects)) return;
+	from->Dirty=true;
 	bool CallPostDelete(from->PreDeleteAll());
 	tmp=from->NbSubObjects;
 	j=from->SubObjects;
@@ -342,6 +346,20 @@ template<class cGroup,class cObj,class cGroups>
 }
 
 
+//------------------------------------------------------------------------------
+template<class cGroup,class cObj,class cGroups>
+	size_t R::RGroups<cGroup,cObj,cGroups>::HashGroupment(void)
+{
+	size_t i,*ass,Hash(static_cast<size_t>(14695981039346656037ULL));
+
+	// FNV-1a hash of the normalized assignment
+	ComputeOrd();
+	for(i=Objs.GetMaxPos()+2,ass=OrdObjectsAss;--i;ass++)
+		Hash=(Hash^(*ass))*static_cast<size_t>(1099511628211ULL);
+	return(Hash?Hash:1);
+}
+
+
 //------------------------------------------------------------------------------
 template<class cGroup,class cObj,class cGroups>
 	R::RCursor<cObj> R::RGroups<cGroup,cObj,cGroups>::GetObjsCursor(void) const
@@ -37,6 +37,7 @@
 // include files for R Project
 #include <rcontainer.h>
 #include <rcursor.h>
+#include <rboolvector.h>
 #include <rinst.h>
 #include <robjg.h>
 #include <rfirstfitheuristic.h>
@@ -58,6 +59,7 @@ template<class cInst,class cChromo,class cFit,class cThreadData,class cGroup,cla
 public:
 
 	using RThreadData<cInst,cChromo>::Owner;
+	using RThreadData<cInst,cChromo>::Random;
 
 protected:
 
@@ -109,6 +111,8 @@ public:
 
 protected:
 
+	using RInst<cInst,cChromo,cFit,cThreadData>::Interact;
+
 	/**
 	* Name of the heuristic used.
 	*/
@@ -192,8 +196,10 @@ public:
 
 	/**
 	* Create a heuristic object. By default, a first-fit heuristic is created.
+	* @param random         Random number generator of the "thread-dependent"
+	*                       data that will hold the heuristic.
 	*/
-	virtual RGroupingHeuristic<cGroup,cObj,cChromo>* CreateHeuristic(void);
+	virtual RGroupingHeuristic<cGroup,cObj,cChromo>* CreateHeuristic(RRandom& random);
 
 	/**
 	* Analyze the population to find the best chromosome of the population and
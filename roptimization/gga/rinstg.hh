@@ -47,7 +47,7 @@ template<class cInst,class cChromo,class cFit,class cThreadData,class cGroup,cla
 	void R::RThreadDataG<cInst,cChromo,cFit,cThreadData,cGroup,cObj>::Init(void)
 {
 	R::RThreadData<cInst,cChromo>::Init();
-	Heuristic=Owner->CreateHeuristic();
+	Heuristic=Owner->CreateHeuristic(*Random);
 }
 
 
@@ -106,14 +106,14 @@ template<class cInst,class cChromo,class cFit,class cThreadData,class cGroup,cla
 
 //------------------------------------------------------------------------------
 template<class cInst,class cChromo,class cFit,class cThreadData,class cGroup,class cObj>
-	R::RGroupingHeuristic<cGroup,cObj,cChromo>* R::RInstG<cInst,cChromo,cFit,cThreadData,cGroup,cObj>::CreateHeuristic(void)
+	R::RGroupingHeuristic<cGroup,cObj,cChromo>* R::RInstG<cInst,cChromo,cFit,cThreadData,cGroup,cObj>::CreateHeuristic(R::RRandom& random)
 {
 	R::RGroupingHeuristic<cGroup,cObj,cChromo>* h(0);
 
 	if(Heuristic=="FirstFit")
-		h = new R::RFirstFitHeuristic<cGroup,cObj,cChromo>(Random,Objs,Debug);
+		h = new R::RFirstFitHeuristic<cGroup,cObj,cChromo>(random,Objs,Debug);
 	else
-		h = new R::RFirstFitHeuristic<cGroup,cObj,cChromo>(Random,Objs,Debug);
+		h = new R::RFirstFitHeuristic<cGroup,cObj,cChromo>(random,Objs,Debug);
 	return(h);
 }
 
@@ -156,9 +156,9 @@ template<class cInst,class cChromo,class cFit,class cThreadData,class cGroup,cla
 		{
 			p=Chromosomes[i];
 			p->Modify();
-			PostNotification("RInst::Interact");
+			Interact();
 			p->Evaluate();
-			PostNotification("RInst::Interact");
+			Interact();
 			p->ToEval=false;
 		}
 	}
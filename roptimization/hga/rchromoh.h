@@ -56,6 +56,8 @@ template<class cInst,class cChromo,class cFit,class cThreadData,class cNode,clas
 public:
 
 	using RChromo<cInst,cChromo,cFit,cThreadData>::Instance;
+	using RChromo<cInst,cChromo,cFit,cThreadData>::RRand;
+	using RChromo<cInst,cChromo,cFit,cThreadData>::RandOrder;
 	using RChromo<cInst,cChromo,cFit,cThreadData>::Id;
 	using RNodesGA<cNode,cObj,cChromo>::Nodes;
 	using RNodesGA<cNode,cObj,cChromo>::ReserveNode;
@@ -109,8 +109,8 @@ template<class cInst,class cChromo,class cFit,class cThreadData,class cNode,clas
 	// 1. Two nodes having the same attributes are chosen in each parent:
 	size_t Nb1=parent1->Nodes.GetTab(thNodes1);
 	size_t Nb2=parent2->Nodes.GetTab(thNodes2);
-	Instance->RandOrder(thNodes1,Nb1);
-	Instance->RandOrder(thNodes2,Nb2);
+	RandOrder(thNodes1,Nb1);
+	RandOrder(thNodes2,Nb2);
 	for(i=Nb1+1,Ref1=thNodes1;(--i)&&(!Node1);Ref1++)
 	{
 		for(j=Nb2+1,Ref2=thNodes2;(--j)&&(!Node1);Ref2++)
@@ -180,7 +180,7 @@ template<class cInst,class cChromo,class cFit,class cThreadData,class cNode,clas
 		Instance->Debug->BeginFunc("Mutation","RChromoH");
 
 	// Choose Randomly a node and delete it.
-	cNode* Node(Nodes[Instance->RRand(GetNbNodes())]);
+	cNode* Node(Nodes[RRand(GetNbNodes())]);
 	if(Instance->Debug)
 		Instance->Debug->PrintInfo("Node "+RString::Number(Node->GetId())+" use for Mutation");
 	DeleteNode(Node);
@@ -56,6 +56,7 @@ template<class cInst,class cChromo,class cFit,class cThreadData,class cNode,clas
 public:
 
 	using RThreadData<cInst,cChromo>::Owner;
+	using RThreadData<cInst,cChromo>::Random;
 
 protected:
 
@@ -187,8 +188,10 @@ public:
 
 	/**
 	* Create a heuristic object.
+	* @param random         Random number generator of the "thread-dependent"
+	*                       data that will hold the heuristic.
 	*/
-	virtual RTreeHeuristic<cNode,cObj,cChromo>* CreateHeuristic(void);
+	virtual RTreeHeuristic<cNode,cObj,cChromo>* CreateHeuristic(RRandom& random);
 
 	/**
 	* This function do a traitement after the GA stops.
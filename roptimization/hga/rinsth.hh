@@ -50,7 +50,7 @@ template<class cInst,class cChromo,class cFit,class cThreadData,class cNode,clas
 	void RThreadDataH<cInst,cChromo,cFit,cThreadData,cNode,cObj>::Init(void)
 {
 	RThreadData<cInst,cChromo>::Init();
-	Heuristic=Owner->CreateHeuristic();
+	Heuristic=Owner->CreateHeuristic(*Random);
 }
 
 
@@ -114,12 +114,12 @@ template<class cInst,class cChromo,class cFit,class cThreadData,class cNode,clas
 
 //------------------------------------------------------------------------------
 template<class cInst,class cChromo,class cFit,class cThreadData,class cNode,class cObj>
-	RTreeHeuristic<cNode,cObj,cChromo>* RInstH<cInst,cChromo,cFit,cThreadData,cNode,cObj>::CreateHeuristic(void)
+	RTreeHeuristic<cNode,cObj,cChromo>* RInstH<cInst,cChromo,cFit,cThreadData,cNode,cObj>::CreateHeuristic(RRandom& random)
 {
 	RTreeHeuristic<cNode,cObj,cChromo>* h(0);
 
 	if(Heuristic=="FirstFit")
-		h=new RFirstNodeHeuristic<cNode,cObj,cChromo>(Random,Objs,Debug);
+		h=new RFirstNodeHeuristic<cNode,cObj,cChromo>(random,Objs,Debug);
 	return(h);
 }
 
@@ -39,6 +39,7 @@
 #include <rpromcritvalue.h>
 #include <rpromkernel.h>
 #include <rcursor.h>
+#include <rsort.h>
 using namespace std;
 using namespace R;
 
@@ -53,7 +54,7 @@ using namespace R;
 //------------------------------------------------------------------------------
 RPromCriterion::RPromCriterion(tCriteriaType type,double w,const RString& name,size_t nb)
 	: RContainer<RPromCritValue,false,false>(nb,nb/2), Id(cNoRef), Name(name),
-	  Type(type), Active(true)
+	  Type(type), Active(true), Sorted(0), Values(0), Sums(0), MaxSorted(0)
 {
 	Weight=w;
 }
@@ -93,24 +94,73 @@ void RPromCriterion::Normalize(void)
 }
 
 
+//------------------------------------------------------------------------------
+int RPromCriterion::SortOrder(const void* a,const void* b)
+{
+	double d((*static_cast<RPromCritValue* const*>(a))->Normalized-(*static_cast<RPromCritValue* const*>(b))->Normalized);
+	if(d<0.0)
+		return(-1);
+	if(d>0.0)
+		return(1);
+	return(0);
+}
+
+
+//------------------------------------------------------------------------------
+void RPromCriterion::SortValues(void)
+{
+	size_t nb(GetNb());
+	if(nb>MaxSorted)
+	{
+		delete[] Sorted;
+		delete[] Values;
+		delete[] Sums;
+		MaxSorted=nb+nb/2;
+		Sorted=new RPromCritValue*[MaxSorted];
+		Values=new double[MaxSorted];
+		Sums=new double[MaxSorted+1];
+	}
+	GetTab(Sorted);
+	RSort<RPromCritValue*,RSortStatic<RPromCritValue*,SortOrder> > Sort;
+	Sort.Sort(Sorted,nb);
+	Sums[0]=0.0;
+	for(size_t i=0;i<nb;i++)
+	{
+		Values[i]=Sorted[i]->Normalized;
+		Sums[i+1]=Sums[i]+Values[i];
+	}
+}
+
+
+//------------------------------------------------------------------------------
+bool RPromCriterion::ComputeFlows(void)
+{
+	return(false);
+}
+
+
 //------------------------------------------------------------------------------
 void RPromCriterion::ComputeFiCrit(RPromKernel* kern)
 {
-	// Calculation of Fi Crit + & -
-	RCursor<RPromCritValue> ptr2(*this);
 	RCursor<RPromCritValue> ptr(*this);
-	RCursor<RPromSol> sol(kern->Solutions);
-	RCursor<RPromSol> sol2(kern->Solutions);
-	for(ptr.Start(),sol.Start();!ptr.End();ptr.Next(),sol.Next())
+
+	// Calculation of Fi Crit + & -
+	if(!ComputeFlows())
 	{
-		// Fi are zero
-		ptr()->FiCritPlus=ptr()->FiCritMinus=0.0;
-		for(ptr2.Start(),sol2.Start();!ptr2.End();ptr2.Next(),sol2.Next())
+		RCursor<RPromCritValue> ptr2(*this);
+		RCursor<RPromSol> sol(kern->Solutions);
+		RCursor<RPromSol> sol2(kern->Solutions);
+		for(ptr.Start(),sol.Start();!ptr.End();ptr.Next(),sol.Next())
 		{
-			// Only if secondary solution is not the same than the primary one.
-			if(sol()==sol2()) continue;
-			ptr()->FiCritPlus+=ComputePref(ptr()->Normalized,ptr2()->Normalized);
-			ptr()->FiCritMinus+=ComputePref(ptr2()->Normalized,ptr()->Normalized);
+			// Fi are zero
+			ptr()->FiCritPlus=ptr()->FiCritMinus=0.0;
+			for(ptr2.Start(),sol2.Start();!ptr2.End();ptr2.Next(),sol2.Next())
+			{
+				// Only if secondary solution is not the same than the primary one.
+				if(sol()==sol2()) continue;
+				ptr()->FiCritPlus+=ComputePref(ptr()->Normalized,ptr2()->Normalized);
+				ptr()->FiCritMinus+=ComputePref(ptr2()->Normalized,ptr()->Normalized);
+			}
 		}
 	}
 
@@ -123,6 +173,9 @@ void RPromCriterion::ComputeFiCrit(RPromKernel* kern)
 //------------------------------------------------------------------------------
 RPromCriterion::~RPromCriterion(void)
 {
+	delete[] Sorted;
+	delete[] Values;
+	delete[] Sums;
 }
 
 
@@ -237,6 +290,43 @@ double RPromLinearCriterion::ComputePref(double u,double v)
 }
 
 
+//------------------------------------------------------------------------------
+bool RPromLinearCriterion::ComputeFlows(void)
+{
+	size_t nb(GetNb());
+	if(!nb)
+		return(true);
+	SortValues();
+
+	// For each value x (in increasing order), the values of [0,a[ are lower or
+	// equal to x-P, those of [a,b[ are in ]x-P,x-Q[, those of [c,d[ are in
+	// ]x+Q,x+P[, and those of [d,nb[ are greater or equal to x+P.
+	size_t a(0),b(0),c(0),d(0);
+	double Range(P-Q);
+	for(size_t i=0;i<nb;i++)
+	{
+		double x(Values[i]);
+		while((a<nb)&&(Values[a]<=x-P))
+			a++;
+		while((b<nb)&&(Values[b]<x-Q))
+			b++;
+		while((c<nb)&&(Values[c]<=x+Q))
+			c++;
+		while((d<nb)&&(Values[d]<x+P))
+			d++;
+		double Lower(static_cast<double>(a)+((x-Q)*static_cast<double>(b-a)-(Sums[b]-Sums[a]))/Range);
+		double Upper(static_cast<double>(nb-d)+((Sums[d]-Sums[c])-(x+Q)*static_cast<double>(d-c))/Range);
+
+		// When the criterion is maximized, x is preferred to the lower values
+		if(Type==Maximize)
+			SetFlows(Sorted[i],Lower,Upper);
+		else
+			SetFlows(Sorted[i],Upper,Lower);
+	}
+	return(true);
+}
+
+
 //-----------------------------------------------------------------------------
 RParamStruct* RPromLinearCriterion::CreateParam(const R::RString& name,const RString& desc)
 {
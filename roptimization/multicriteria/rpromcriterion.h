@@ -97,6 +97,28 @@ protected:
     */
 	bool Active;
 
+	/**
+	* Values of the solutions ordered by increasing normalized values (see
+	* SortValues).
+	*/
+	RPromCritValue** Sorted;
+
+	/**
+	* Normalized values of Sorted.
+	*/
+	double* Values;
+
+	/**
+	* Prefix sums of the sorted normalized values: Sums[i] is the sum of the
+	* first i values of Sorted.
+	*/
+	double* Sums;
+
+	/**
+	* Size of the arrays Sorted and Sums.
+	*/
+	size_t MaxSorted;
+
 public:
 
 	/**
@@ -196,10 +218,49 @@ public:
 	virtual double ComputePref(double u,double v)=0;
 
 	/**
-	* Calculate the Fi Crit for the different solutions.
+	* Calculate the Fi Crit for the different solutions. If the criterion
+	* provides a specific computation (see ComputeFlows), it is used. Else, the
+	* preferences of all the pairs of solutions are computed.
 	*/
 	void ComputeFiCrit(RPromKernel *kern);
 
+private:
+
+	/**
+	* Function used to order the values by increasing normalized values.
+	*/
+	static int SortOrder(const void* a,const void* b);
+
+protected:
+
+	/**
+	* Order the values of the solutions by increasing normalized values in
+	* Sorted (and Values), and compute their prefix sums in Sums.
+	*/
+	void SortValues(void);
+
+	/**
+	* Compute the positive and negative flows (FiCritPlus and FiCritMinus) of
+	* the solutions without computing the preferences of all the pairs of
+	* solutions. By default, the method does nothing.
+	* @return true if the flows were computed.
+	*/
+	virtual bool ComputeFlows(void);
+
+	/**
+	* Set the flows of a value.
+	* @param value          Value.
+	* @param plus           Positive flow.
+	* @param minus          Negative flow.
+	*/
+	static inline void SetFlows(RPromCritValue* value,double plus,double minus)
+	{
+		value->FiCritPlus=plus;
+		value->FiCritMinus=minus;
+	}
+
+public:
+
 	/**
 	* Destruct the Criterion.
 	*/
@@ -292,6 +353,22 @@ public:
 	*/
 	virtual double ComputePref(double u,double v);
 
+protected:
+
+	/**
+	* Compute the flows from the sorted normalized values. For a solution with
+	* the value x, the solutions with a value lower than x-P count for 1 in its
+	* positive flow, and those with a value in ]x-P,x-Q[ count for their
+	* preference: their sum is computed with the prefix sums. The same is done
+	* for the negative flow with the values greater than x+Q. Since the values
+	* are visited in increasing order, the bounds of these intervals only move
+	* forward, and the computation is in O(n log n) instead of O(n²).
+	* @return true.
+	*/
+	virtual bool ComputeFlows(void);
+
+public:
+
 	/**
 	* Create a parameter corresponding to a PROMETHEE criteria.
 	* @param name            Name of the criteria.
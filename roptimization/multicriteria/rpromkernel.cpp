@@ -192,7 +192,7 @@ void RPromKernel::OrderSolutions(void)
 	RCursor<RPromSol> Sol(Solutions);
 	for(Sol.Start();!Sol.End();Sol.Next())
 		OrderedSolutions.InsertPtr(Sol());
-	OrderedSolutions.ReOrder(sort_function_solutions);
+	OrderedSolutions.ReOrder(RSortStatic<RPromSol*,sort_function_solutions>(),0,0);
 	MustReOrder=false;
 }
 
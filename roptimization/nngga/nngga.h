@@ -218,6 +218,68 @@ public:
 };
 
 
+//------------------------------------------------------------------------------
+/**
+* The RCritNN class provides the sums needed to compute the criteria of the
+* Nearest Neighbors Grouping Genetic Algorithm. For each measure (similarity,
+* agreement and disagreement ratios), the values between an object and its
+* nearest neighbors are added separately whether the neighbors are in the same
+* group or not.
+* @short NNGGA Criteria Sums.
+*/
+class RCritNN
+{
+public:
+
+	double IntraSim;           // Sum of the similarities inside the groups.
+	double InterSim;           // Sum of the similarities between the groups.
+	double IntraAgree;         // Sum of the agreement ratios inside the groups.
+	double InterAgree;         // Sum of the agreement ratios between the groups.
+	double IntraDisagree;      // Sum of the disagreement ratios inside the groups.
+	double InterDisagree;      // Sum of the disagreement ratios between the groups.
+	size_t NbIntraSim;         // Number of similarities inside the groups.
+	size_t NbInterSim;         // Number of similarities between the groups.
+	size_t NbIntraAgree;       // Number of agreement ratios inside the groups.
+	size_t NbInterAgree;       // Number of agreement ratios between the groups.
+	size_t NbIntraDisagree;    // Number of disagreement ratios inside the groups.
+	size_t NbInterDisagree;    // Number of disagreement ratios between the groups.
+
+	/**
+	* Construct the sums.
+	*/
+	RCritNN(void) {Clear();}
+
+	/**
+	* Clear the sums.
+	*/
+	void Clear(void)
+	{
+		IntraSim=InterSim=IntraAgree=InterAgree=IntraDisagree=InterDisagree=0.0;
+		NbIntraSim=NbInterSim=NbIntraAgree=NbInterAgree=NbIntraDisagree=NbInterDisagree=0;
+	}
+
+	/**
+	* Add other sums.
+	* @param crit           Sums to add.
+	*/
+	void Add(const RCritNN& crit)
+	{
+		IntraSim+=crit.IntraSim;
+		InterSim+=crit.InterSim;
+		IntraAgree+=crit.IntraAgree;
+		InterAgree+=crit.InterAgree;
+		IntraDisagree+=crit.IntraDisagree;
+		InterDisagree+=crit.InterDisagree;
+		NbIntraSim+=crit.NbIntraSim;
+		NbInterSim+=crit.NbInterSim;
+		NbIntraAgree+=crit.NbIntraAgree;
+		NbInterAgree+=crit.NbInterAgree;
+		NbIntraDisagree+=crit.NbIntraDisagree;
+		NbInterDisagree+=crit.NbInterDisagree;
+	}
+};
+
+
 }//------- End of namespace R --------------------------------------------------
 
 
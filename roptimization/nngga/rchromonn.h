@@ -144,10 +144,24 @@ public:
 	virtual void Init(cThreadData* thData);
 
 	/**
-	* Evaluation of the chromosome.
+	* Evaluation of the chromosome. Only the sums of the dirty groups are
+	* recomputed (see RGroupNN::Evaluate).
 	*/
 	virtual void Evaluate(void);
 
+protected:
+
+	/**
+	* Add the similarities and the ratios between an object and its nearest
+	* neighbors.
+	* @param obj            Object.
+	* @param groupid        Identifier of the group of the object.
+	* @param crit           Sums to update.
+	*/
+	void EvaluateObj(const cObj* obj,size_t groupid,RCritNN& crit);
+
+public:
+
 	/**
 	* Look if two objects are in the same group or not.
 	* @param obj1            Identifier of the first object.
@@ -162,6 +176,18 @@ public:
 	*/
 	virtual void Copy(const cChromo& chromo);
 
+	/**
+	* Save the criteria computed by the evaluation.
+	* @param values         Values to fill.
+	*/
+	virtual void SaveEvaluation(RNumContainer<double,false>& values) const;
+
+	/**
+	* Restore the criteria computed by the evaluation.
+	* @param values         Values saved by SaveEvaluation.
+	*/
+	virtual void RestoreEvaluation(const RNumContainer<double,false>& values);
+
 	/**
 	* Get the value of the 'J' measure.
 	* @returns double.
@@ -59,68 +59,76 @@ template<class cInst,class cChromo,class cThreadData,class cGroup,class cObj>
 
 //-----------------------------------------------------------------------------
 template<class cInst,class cChromo,class cThreadData,class cGroup,class cObj>
-	void RChromoNN<cInst,cChromo,cThreadData,cGroup,cObj>::Evaluate(void)
+	void RChromoNN<cInst,cChromo,cThreadData,cGroup,cObj>::EvaluateObj(const cObj* obj,size_t groupid,RCritNN& crit)
 {
-	CritAgreement=CritDisagreement=CritSimJ=0.0;
-	if(!Used.GetNb())
-		return;
-
-	double AvgIntraSim(0.0), AvgInterSim(0.0), AvgIntraAgree(0.0), AvgInterAgree(0.0), AvgIntraDisagree(0.0), AvgInterDisagree(0.0);
-	size_t NbIntraSim(0), NbInterSim(0), NbIntraAgree(0), NbInterAgree(0), NbIntraDisagree(0), NbInterDisagree(0);
-
-	// Go trough each object
-	for(Objs.Start();!Objs.End();Objs.Next())
+	// Treat the similarities
+	RCursor<RMaxValue> Sim(*Instance->GetSims(obj));
+	for(Sim.Start();!Sim.End();Sim.Next())
 	{
-		size_t GroupId(ObjectsAss[Objs()->GetId()]);
-
-		// Treat the similarities
-		RCursor<RMaxValue> Sim(*Instance->GetSims(Objs()));
-		for(Sim.Start();!Sim.End();Sim.Next())
+		if(ObjectsAss[Sim()->Id]==groupid)
 		{
-			if(ObjectsAss[Sim()->Id]==GroupId)
-			{
-				AvgIntraSim+=Sim()->Value;
-				NbIntraSim++;
-			}
-			else
-			{
-				AvgInterSim+=Sim()->Value;
-				NbInterSim++;
-			}
+			crit.IntraSim+=Sim()->Value;
+			crit.NbIntraSim++;
 		}
+		else
+		{
+			crit.InterSim+=Sim()->Value;
+			crit.NbInterSim++;
+		}
+	}
 
-		// Treat the agreement ratios
-		RCursor<RMaxValue> Agree(*Instance->GetAgreementRatios(Objs()));
-		for(Agree.Start();!Agree.End();Agree.Next())
+	// Treat the agreement ratios
+	RCursor<RMaxValue> Agree(*Instance->GetAgreementRatios(obj));
+	for(Agree.Start();!Agree.End();Agree.Next())
+	{
+		if(ObjectsAss[Agree()->Id]==groupid)
+		{
+			crit.IntraAgree+=Agree()->Value;
+			crit.NbIntraAgree++;
+		}
+		else
 		{
-			if(ObjectsAss[Agree()->Id]==GroupId)
-			{
-				AvgIntraAgree+=Agree()->Value;
-				NbIntraAgree++;
-			}
-			else
-			{
-				AvgInterAgree+=Agree()->Value;
-				NbInterAgree++;
-			}
+			crit.InterAgree+=Agree()->Value;
+			crit.NbInterAgree++;
 		}
+	}
 
-		// Treat the disagreement ratios
-		RCursor<RMaxValue> Disagree(*Instance->GetDisagreementRatios(Objs()));
-		for(Disagree.Start();!Disagree.End();Disagree.Next())
+	// Treat the disagreement ratios
+	RCursor<RMaxValue> Disagree(*Instance->GetDisagreementRatios(obj));
+	for(Disagree.Start();!Disagree.End();Disagree.Next())
+	{
+		if(ObjectsAss[Disagree()->Id]==groupid)
 		{
-			if(ObjectsAss[Disagree()->Id]==GroupId)
-			{
-				AvgIntraDisagree+=Disagree()->Value;
-				NbIntraDisagree++;
-			}
-			else
-			{
-				AvgInterDisagree+=Disagree()->Value;
-				NbInterDisagree++;
-			}
+			crit.IntraDisagree+=Disagree()->Value;
+			crit.NbIntraDisagree++;
+		}
+		else
+		{
+			crit.InterDisagree+=Disagree()->Value;
+			crit.NbInterDisagree++;
 		}
 	}
+}
+
+
+//-----------------------------------------------------------------------------
+template<class cInst,class cChromo,class cThreadData,class cGroup,class cObj>
+	void RChromoNN<cInst,cChromo,cThreadData,cGroup,cObj>::Evaluate(void)
+{
+	CritAgreement=CritDisagreement=CritSimJ=0.0;
+	if(!Used.GetNb())
+		return;
+
+	// Add the sums of the groups and of the objects not assigned
+	RCritNN Crit;
+	RCursor<cGroup> Group(Used);
+	for(Group.Start();!Group.End();Group.Next())
+		Group()->Evaluate(Crit);
+	RCursor<cObj> Obj(ObjsNoAss);
+	for(Obj.Start();!Obj.End();Obj.Next())
+		EvaluateObj(Obj(),cNoRef,Crit);
+	double AvgIntraSim(Crit.IntraSim), AvgInterSim(Crit.InterSim), AvgIntraAgree(Crit.IntraAgree), AvgInterAgree(Crit.InterAgree), AvgIntraDisagree(Crit.IntraDisagree), AvgInterDisagree(Crit.InterDisagree);
+	size_t NbIntraSim(Crit.NbIntraSim), NbInterSim(Crit.NbInterSim), NbIntraAgree(Crit.NbIntraAgree), NbInterAgree(Crit.NbInterAgree), NbIntraDisagree(Crit.NbIntraDisagree), NbInterDisagree(Crit.NbInterDisagree);
 
 	// Compute the similarity criterion
 	if(NbIntraSim)
@@ -206,6 +214,26 @@ template<class cInst,class cChromo,class cThreadData,class cGroup,class cObj>
 }
 
 
+//-----------------------------------------------------------------------------
+template<class cInst,class cChromo,class cThreadData,class cGroup,class cObj>
+	void RChromoNN<cInst,cChromo,cThreadData,cGroup,cObj>::SaveEvaluation(RNumContainer<double,false>& values) const
+{
+	values.Insert(CritSimJ);
+	values.Insert(CritAgreement);
+	values.Insert(CritDisagreement);
+}
+
+
+//-----------------------------------------------------------------------------
+template<class cInst,class cChromo,class cThreadData,class cGroup,class cObj>
+	void RChromoNN<cInst,cChromo,cThreadData,cGroup,cObj>::RestoreEvaluation(const RNumContainer<double,false>& values)
+{
+	CritSimJ=values[0];
+	CritAgreement=values[1];
+	CritDisagreement=values[2];
+}
+
+
 //-----------------------------------------------------------------------------
 template<class cInst,class cChromo,class cThreadData,class cGroup,class cObj>
 	RChromoNN<cInst,cChromo,cThreadData,cGroup,cObj>::~RChromoNN(void)
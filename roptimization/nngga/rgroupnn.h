@@ -62,6 +62,7 @@ template<class cGroup,class cObj,class cGroups>
 	using RGroup<cGroup,cObj,cGroups>::Id;
 	using RGroup<cGroup,cObj,cGroups>::Owner;
 	using RGroup<cGroup,cObj,cGroups>::NbSubObjects;
+	using RGroup<cGroup,cObj,cGroups>::Dirty;
 
 public:
 
@@ -70,9 +71,10 @@ public:
 protected:
 
 	/**
-	 * Must the group be re-evaluated?
+	 * Sums computed for the objects of the group (valid if the group is not
+	 * dirty).
 	 */
-	bool ToEval;
+	RCritNN Crit;
 
 public:
 
@@ -137,6 +139,13 @@ public:
 	 */
 	virtual bool PreDeleteAll(void);
 
+	/**
+	* Add the sums of the objects of the group. They are only recomputed if
+	* the group is dirty.
+	* @param crit           Sums of the chromosome.
+	*/
+	void Evaluate(RCritNN& crit);
+
 	/**
 	* Destruct the group.
 	*/
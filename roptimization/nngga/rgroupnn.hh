@@ -37,7 +37,7 @@
 //-----------------------------------------------------------------------------
 template<class cGroup,class cObj,class cGroups>
 	RGroupNN<cGroup,cObj,cGroups>::RGroupNN(RGroupNN* grp)
-	: RGroup<cGroup,cObj,cGroups>(grp), ToEval(true)
+	: RGroup<cGroup,cObj,cGroups>(grp), Crit(grp->Crit)
 {
 }
 
@@ -45,7 +45,7 @@ template<class cGroup,class cObj,class cGroups>
 //-----------------------------------------------------------------------------
 template<class cGroup,class cObj,class cGroups>
 	RGroupNN<cGroup,cObj,cGroups>::RGroupNN(cGroups* owner,const size_t id)
-	: RGroup<cGroup,cObj,cGroups>(owner,id), ToEval(true)
+	: RGroup<cGroup,cObj,cGroups>(owner,id), Crit()
 {
 }
 
@@ -55,7 +55,6 @@ template<class cGroup,class cObj,class cGroups>
 	void RGroupNN<cGroup,cObj,cGroups>::Clear(void)
 {
 	RGroup<cGroup,cObj,cGroups>::Clear();
-	ToEval=true;
 }
 
 
@@ -116,8 +115,11 @@ template<class cGroup,class cObj,class cGroups>
 
 //---------------------------------------------------------------------------
 template<class cGroup,class cObj,class cGroups>
-	bool RGroupNN<cGroup,cObj,cGroups>::PreInsertAll(const cGroup* /*from*/)
+	bool RGroupNN<cGroup,cObj,cGroups>::PreInsertAll(const cGroup* from)
 {
+	// The sums only depend on the objects of the group
+	Crit=from->Crit;
+	Dirty=from->Dirty;
 	return(false);
 }
 
@@ -133,11 +135,26 @@ template<class cGroup,class cObj,class cGroups>
 template<class cGroup,class cObj,class cGroups>
 	bool RGroupNN<cGroup,cObj,cGroups>::PreDeleteAll(void)
 {
-	ToEval=true;
 	return(false);
 }
 
 
+//---------------------------------------------------------------------------
+template<class cGroup,class cObj,class cGroups>
+	void RGroupNN<cGroup,cObj,cGroups>::Evaluate(RCritNN& crit)
+{
+	if(Dirty)
+	{
+		Crit.Clear();
+		RCursor<cObj> Cur(Owner->GetObjs(*this));
+		for(Cur.Start();!Cur.End();Cur.Next())
+			Owner->EvaluateObj(Cur(),Id,Crit);
+		Dirty=false;
+	}
+	crit.Add(Crit);
+}
+
+
 //---------------------------------------------------------------------------
 template<class cGroup,class cObj,class cGroups>
 	RGroupNN<cGroup,cObj,cGroups>::~RGroupNN(void)
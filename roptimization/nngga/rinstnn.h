@@ -157,8 +157,10 @@ public:
 
 	/**
 	* Create a specific heuristic for the algorithm.
+	* @param random         Random number generator of the "thread-dependent"
+	*                       data that will hold the heuristic.
 	*/
-	virtual R::RGroupingHeuristic<cGroup,cObj,cChromo>* CreateHeuristic(void);
+	virtual R::RGroupingHeuristic<cGroup,cObj,cChromo>* CreateHeuristic(RRandom& random);
 
 	/**
 	* This function determines if the GA must be stopped. Actually, it is the case
@@ -81,6 +81,9 @@ template<class cInst,class cChromo,class cThreadData,class cGroup,class cObj>
 	RPromSol** ptr;
 	size_t i;
 
+	// PROMETHEE recomputes the fitness of all the chromosomes
+	this->PostEvaluateFitness=true;
+
 	// Change Freq
 	SetMutationParams(5,8,1);
 
@@ -98,9 +101,9 @@ template<class cInst,class cChromo,class cThreadData,class cGroup,class cObj>
 
 //-----------------------------------------------------------------------------
 template<class cInst,class cChromo,class cThreadData,class cGroup,class cObj>
-	RGroupingHeuristic<cGroup,cObj,cChromo>* RInstNN<cInst,cChromo,cThreadData,cGroup,cObj>::CreateHeuristic(void)
+	RGroupingHeuristic<cGroup,cObj,cChromo>* RInstNN<cInst,cChromo,cThreadData,cGroup,cObj>::CreateHeuristic(RRandom& random)
 {
-	return(new RHeuristicNN<cGroup,cObj,cChromo>(Random,Objs,Params,Debug));
+	return(new RHeuristicNN<cGroup,cObj,cChromo>(random,Objs,Params,Debug));
 }
 
 
@@ -168,9 +171,7 @@ template<class cInst,class cChromo,class cThreadData,class cGroup,class cObj>
 		// -> If not, exchange the first two solutions
 		if(!BestChromosome->Used.GetNb())
 		{
-			RPromSol* old=Res[0];
-			Res.InsertPtrAt(Res[1],0,false);
-			Res.InsertPtrAt(old,1,false);
+			Res.Exchange(0,1);
 			s=Chromosomes[ptr()->GetId()-1];
 		}
 
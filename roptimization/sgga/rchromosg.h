@@ -67,6 +67,7 @@ public:
 	using RChromoG<cInst,cChromo,RFitnessSG,cThreadData,cGroup,cObj>::Id;
 	using RChromoG<cInst,cChromo,RFitnessSG,cThreadData,cGroup,cObj>::ObjsNoAss;
 	using RChromoG<cInst,cChromo,RFitnessSG,cThreadData,cGroup,cObj>::GetGroup;
+	using RChromoG<cInst,cChromo,RFitnessSG,cThreadData,cGroup,cObj>::RandOrder;
 
 protected:
 
@@ -141,6 +142,11 @@ protected:
 	*/
 	cChromo** thTests;
 
+	/**
+	* Temporary array of identifiers of objects (Thread dependent data).
+	*/
+	size_t* thIds;
+
 	/**
 	* PROMETHE  Kernel used by the chromosome.
 	*/
@@ -253,6 +259,19 @@ public:
 	*/
 	virtual void Copy(const cChromo& chromo);
 
+	/**
+	* Save the criteria computed by the evaluation. The two most similar
+	* groups are identified by one of their objects.
+	* @param values         Values to fill.
+	*/
+	virtual void SaveEvaluation(RNumContainer<double,false>& values) const;
+
+	/**
+	* Restore the criteria computed by the evaluation.
+	* @param values         Values saved by SaveEvaluation.
+	*/
+	virtual void RestoreEvaluation(const RNumContainer<double,false>& values);
+
 	/**
 	* Get the value of the 'J' measure.
 	* @returns double.
@@ -40,7 +40,7 @@ template<class cInst,class cChromo,class cThreadData,class cGroup,class cObj>
 		: RChromoG<cInst,cChromo,RFitnessSG,cThreadData,cGroup,cObj>(inst,id),
 	  ToDel(0), CritSimJ(0.0), CritAgreement(0.0), CritDisagreement(1.0), Protos(Used.GetMaxNb()),
 	  OldProtos(Used.GetMaxNb()),
-	  thProm(0), thSols(0), MostSimilarGroup1(cNoRef), MostSimilarGroup2(cNoRef), VerifyCentroids(true)
+	  thIds(0), thProm(0), thSols(0), MostSimilarGroup1(cNoRef), MostSimilarGroup2(cNoRef), VerifyCentroids(true)
 {
 }
 
@@ -55,6 +55,7 @@ template<class cInst,class cChromo,class cThreadData,class cGroup,class cObj>
 	// Current
 	thObjs1=thData->tmpObjs1;
 	thObjs2=thData->tmpObjs2;
+	thIds=thData->tmpIds;
 	thTests=thData->Tests;
 	thProm=&thData->Prom;
 	thSols=thData->Sols;
@@ -84,7 +85,7 @@ template<class cInst,class cChromo,class cThreadData,class cGroup,class cObj>
 		for(Cur2.Start();!Cur2.End();Cur2.Next())
 		{
 			if(Cur()==Cur2()) continue;
-			tmp=Instance->GetSim(Cur()->GetCentroid(),Cur2()->GetCentroid());
+			tmp=Instance->Sim(Cur()->GetCentroid(),Cur2()->GetCentroid());
 			avg+=tmp;
 			if(tmp>super)
 			{
@@ -222,7 +223,7 @@ template<class cInst,class cChromo,class cThreadData,class cGroup,class cObj>
 	// Copy and mix the objects into thObjs1
 	for(Objs.Start(),obj=thObjs1;!Objs.End();Objs.Next(),obj++)
 		(*obj)=Objs();
-	Instance->RandOrder(thObjs1,Objs.GetNb());
+	RandOrder(thObjs1,Objs.GetNb());
 
 	// Max Iterations
 	minerror=Instance->Params->Convergence/100.0;
@@ -270,7 +271,7 @@ template<class cInst,class cChromo,class cThreadData,class cGroup,class cObj>
 		{
 			for(CurObj2.GoTo(i+1);!CurObj2.End();CurObj2.Next())
 			{
-				sim=Instance->GetSim(CurObj(),CurObj2());
+				sim=Instance->Sim(CurObj(),CurObj2());
 				if(sim<minsim)
 				{
 					minsim=sim;
@@ -296,8 +297,8 @@ template<class cInst,class cChromo,class cThreadData,class cGroup,class cObj>
 	for(CurObj.Start();!CurObj.End();CurObj.Next())
 	{
 		if((CurObj()==worst1)||(CurObj()==worst2)) continue;
-		sim=Instance->GetSim(worst1,CurObj());
-		minsim=Instance->GetSim(worst2,CurObj());
+		sim=Instance->Sim(worst1,CurObj());
+		minsim=Instance->Sim(worst2,CurObj());
 		if(sim>minsim)
 		{
 			NbObjs1++;
@@ -390,7 +391,7 @@ template<class cInst,class cChromo,class cThreadData,class cGroup,class cObj>
 				continue;
 			if(Cur2()->HasSameUser(obj))
 				continue;
-			tmp=Instance->GetSim(obj,Cur2()->GetCentroid());
+			tmp=Instance->Sim(obj,Cur2()->GetCentroid());
 			if(tmp>max)
 			{
 				max=tmp;
@@ -508,7 +509,7 @@ template<class cInst,class cChromo,class cThreadData,class cGroup,class cObj>
 
 	// Determine all non assigned objects
 	size_t nbobjs(ObjsNoAss.GetTab(thObjs1));
-	Instance->RandOrder(thObjs1,nbobjs);
+	RandOrder(thObjs1,nbobjs);
 
 	//std::cout<<"Test "<<Id<<std::endl;
 	bool bOpti;
@@ -572,6 +573,43 @@ template<class cInst,class cChromo,class cThreadData,class cGroup,class cObj>
 }
 
 
+//-----------------------------------------------------------------------------
+template<class cInst,class cChromo,class cThreadData,class cGroup,class cObj>
+	void RChromoSG<cInst,cChromo,cThreadData,cGroup,cObj>::SaveEvaluation(RNumContainer<double,false>& values) const
+{
+	values.Insert(CritSimJ);
+	values.Insert(CritAgreement);
+	values.Insert(CritDisagreement);
+	if((MostSimilarGroup1==cNoRef)||(MostSimilarGroup2==cNoRef))
+		return;
+
+	// The identifiers of the groups may differ for the same clustering
+	RCursor<cObj> Obj1(GetObjs(*(*this)[MostSimilarGroup1]));
+	RCursor<cObj> Obj2(GetObjs(*(*this)[MostSimilarGroup2]));
+	Obj1.Start();
+	Obj2.Start();
+	values.Insert(static_cast<double>(Obj1()->GetId()));
+	values.Insert(static_cast<double>(Obj2()->GetId()));
+}
+
+
+//-----------------------------------------------------------------------------
+template<class cInst,class cChromo,class cThreadData,class cGroup,class cObj>
+	void RChromoSG<cInst,cChromo,cThreadData,cGroup,cObj>::RestoreEvaluation(const RNumContainer<double,false>& values)
+{
+	CritSimJ=values[0];
+	CritAgreement=values[1];
+	CritDisagreement=values[2];
+	if(values.GetNb()<5)
+	{
+		MostSimilarGroup1=MostSimilarGroup2=cNoRef;
+		return;
+	}
+	MostSimilarGroup1=GetGroup(static_cast<size_t>(values[3]))->GetId();
+	MostSimilarGroup2=GetGroup(static_cast<size_t>(values[4]))->GetId();
+}
+
+
 //-----------------------------------------------------------------------------
 template<class cInst,class cChromo,class cThreadData,class cGroup,class cObj>
 	RChromoSG<cInst,cChromo,cThreadData,cGroup,cObj>::~RChromoSG(void)
@@ -241,7 +241,7 @@ public:
 	* Compute the similarity of a given object to the centroid of the group.
 	* @param obj             Object.
 	*/
-	inline double ComputeRelSim(const cObj* obj) {return(Owner->Instance->GetSim(GetCentroid(),obj));}
+	inline double ComputeRelSim(const cObj* obj) {return(Owner->Instance->Sim(GetCentroid(),obj));}
 
 	/**
 	* Copy internal information from a given group, in particular information
@@ -252,6 +252,14 @@ public:
 
 private:
 
+	/**
+	* Fill the temporary array of the chromosome with the identifiers of the
+	* objects of the group.
+	* @param except          Object to skip (if not null).
+	* @return the number of identifiers.
+	*/
+	size_t GetIds(const cObj* except=0);
+
 	bool Test(cObj** del,size_t& nbdel,cObj* obj1,cObj* obj2);
 
 public:
@@ -102,11 +102,11 @@ template<class cGroup,class cObj,class cGroups>
 			return(false);
 
 		// Maximum disagreement must be respected
-		if(Owner->Instance->GetDisagreementRatio(prof1,ptr())>=Owner->Instance->Params->MinDisagreement)
+		if(Owner->Instance->Disagreement(prof1,ptr())>=Owner->Instance->Params->MinDisagreement)
 		  	return(false);
 
 		// Verify the minimum similarity and remember the best similarity
-		tmp=Owner->Instance->GetSim(prof1,ptr());
+		tmp=Owner->Instance->Sim(prof1,ptr());
 		if(tmp<Owner->Instance->Params->MinSimLevel)
 		{
 			if(Owner->Instance->Params->AllMinSim)
@@ -147,18 +147,33 @@ template<class cGroup,class cObj,class cGroups>
 }
 
 
+//---------------------------------------------------------------------------
+template<class cGroup,class cObj,class cGroups>
+	size_t RGroupSG<cGroup,cObj,cGroups>::GetIds(const cObj* except)
+{
+	size_t* Ids(Owner->thIds);
+	RCursor<cObj> ptr(Owner->GetObjs(*this));
+	for(ptr.Start();!ptr.End();ptr.Next())
+		if(ptr()!=except)
+			(*(Ids++))=ptr()->GetId();
+	return(Ids-Owner->thIds);
+}
+
+
 //---------------------------------------------------------------------------
 template<class cGroup,class cObj,class cGroups>
 	double RGroupSG<cGroup,cObj,cGroups>::ComputeSumSim(cObj* obj)
 {
 	if(!NbSubObjects)
 		return(0.0);
+	if(Owner->Instance->UseBlocks())
+		return(Owner->Instance->SumRow(Owner->Instance->GetSimRow(obj),Owner->thIds,GetIds(obj)));
 	double Sum(0.0);
 	RCursor<cObj> ptr(Owner->GetObjs(*this));
 	for(ptr.Start();!ptr.End();ptr.Next())
 	{
 		if(ptr()==obj) continue;
-		Sum+=Owner->Instance->GetSim(obj,ptr());
+		Sum+=Owner->Instance->Sim(obj,ptr());
 	}
 	return(Sum);
 }
@@ -185,6 +200,30 @@ template<class cGroup,class cObj,class cGroups>
 		AvgIntraSim=1.0;
 		return;
 	}
+	if(Owner->Instance->UseBlocks())
+	{
+		// Sum the similarities of each object with the other ones, which are
+		// the first identifiers once it is swapped with the last one.
+		size_t* Ids(Owner->thIds);
+		size_t Nb(GetIds()-1),i;
+		AvgIntraSim=Owner->Instance->SumRow(Owner->Instance->GetSimRow(ptr()),Ids+1,Nb);
+		for(ptr.Next(),i=1;!ptr.End();ptr.Next(),i++)
+		{
+			size_t Tmp(Ids[i]);
+			Ids[i]=Ids[Nb];
+			Ids[Nb]=Tmp;
+			double SumSim(Owner->Instance->SumRow(Owner->Instance->GetSimRow(ptr()),Ids,Nb));
+			Ids[Nb]=Ids[i];
+			Ids[i]=Tmp;
+			if(SumSim<AvgIntraSim)
+			{
+				Centroid=(ptr());
+				AvgIntraSim=SumSim;
+			}
+		}
+		AvgIntraSim/=static_cast<double>(NbSubObjects-1);
+		return;
+	}
 	AvgIntraSim=ComputeSumSim(ptr());
 
 	// Look if in the other objects, there is a better one
@@ -212,12 +251,26 @@ template<class cGroup,class cObj,class cGroups>
 		RCursor<cObj> CurObj(Owner->GetObjs(*this));
 		RCursor<cObj> CurObj2(Owner->GetObjs(*this));
 		size_t i;
-		for(CurObj.Start(),i=0,AvgAgreement=AvgDisagreement=0.0;i<NbSubObjects-1;CurObj.Next(),i++)
+		if(Owner->Instance->UseBlocks())
 		{
-			for(CurObj2.GoTo(i+1);!CurObj2.End();CurObj2.Next())
+			// Each object is compared with the objects following it
+			const size_t* Ids(Owner->thIds);
+			GetIds();
+			for(CurObj.Start(),i=0,AvgAgreement=AvgDisagreement=0.0;i<NbSubObjects-1;CurObj.Next(),i++)
 			{
-				AvgAgreement+=Owner->Instance->GetAgreementRatio(CurObj(),CurObj2());
-				AvgDisagreement+=Owner->Instance->GetDisagreementRatio(CurObj(),CurObj2());
+				AvgAgreement+=Owner->Instance->SumRow(Owner->Instance->GetAgreementRow(CurObj()),Ids+i+1,NbSubObjects-i-1);
+				AvgDisagreement+=Owner->Instance->SumRow(Owner->Instance->GetDisagreementRow(CurObj()),Ids+i+1,NbSubObjects-i-1);
+			}
+		}
+		else
+		{
+			for(CurObj.Start(),i=0,AvgAgreement=AvgDisagreement=0.0;i<NbSubObjects-1;CurObj.Next(),i++)
+			{
+				for(CurObj2.GoTo(i+1);!CurObj2.End();CurObj2.Next())
+				{
+					AvgAgreement+=Owner->Instance->GetAgreementRatio(CurObj(),CurObj2());
+					AvgDisagreement+=Owner->Instance->GetDisagreementRatio(CurObj(),CurObj2());
+				}
 			}
 		}
 		AvgAgreement/=static_cast<double>(NbSubObjects);
@@ -262,8 +315,8 @@ RGroupSG<cGroup,cObj,cGroups>::OrderBySim::OrderBySim(cGroup* group,cObj** objs,
 template<class cGroup,class cObj,class cGroups>
 	int RGroupSG<cGroup,cObj,cGroups>::OrderBySim::Compare(cObj* obj1,cObj* obj2)
 	{
-		double af(Group->Owner->Instance->GetSim(obj1,Group->GetCentroid()));
-		double bf(Group->Owner->Instance->GetSim(obj2,Group->GetCentroid()));
+		double af(Group->Owner->Instance->Sim(obj1,Group->GetCentroid()));
+		double bf(Group->Owner->Instance->Sim(obj2,Group->GetCentroid()));
 
 		if(fabs(af-bf)<0.000000001) return(0);
 		if(af>bf)
@@ -296,17 +349,17 @@ template<class cGroup,class cObj,class cGroups>
 
 /*	size_t i;
 	for(cur1=thObjs2,i=0;i<NbSubObjects;i++,cur1++)
-		std::cout<<Owner->Instance->GetSim(*cur1,GetCentroid())<<std::endl;
+		std::cout<<Owner->Instance->Sim(*cur1,GetCentroid())<<std::endl;
 	std::cout<<std::endl<<std::endl;
 	return(false);*/
 
 	// Compute the new average similarity with objects
 	double NewAvgIntraSim(AvgIntraSim*(NbSubObjects-1));
 	size_t NewNbObjs(NbSubObjects);
-	NewAvgIntraSim+=Owner->Instance->GetSim(obj1,GetCentroid());
+	NewAvgIntraSim+=Owner->Instance->Sim(obj1,GetCentroid());
 	if(obj2)
 	{
-		NewAvgIntraSim+=Owner->Instance->GetSim(obj2,GetCentroid());
+		NewAvgIntraSim+=Owner->Instance->Sim(obj2,GetCentroid());
 		NewNbObjs++;
 	}
 	double NewBase(NewAvgIntraSim);
@@ -322,7 +375,7 @@ template<class cGroup,class cObj,class cGroups>
 	for(size1=NbSubObjects,cur1=thObjs2;--size1;cur1++)
 	{
 		// Remove cur1?
-		NewAvgIntraSim=(NewBase-Owner->Instance->GetSim(*cur1,GetCentroid()))/static_cast<double>(NewNbObjs-1);
+		NewAvgIntraSim=(NewBase-Owner->Instance->Sim(*cur1,GetCentroid()))/static_cast<double>(NewNbObjs-1);
 		if(NewAvgIntraSim>AvgIntraSim)
 		{
 			// OK remove cur1
@@ -337,12 +390,12 @@ template<class cGroup,class cObj,class cGroups>
 	for(size1=NbSubObjects,cur1=thObjs2;--size1;cur1++)
 	{
 		// Remove cur1?
-		double tmpBase(NewBase-Owner->Instance->GetSim(*cur1,GetCentroid()));
+		double tmpBase(NewBase-Owner->Instance->Sim(*cur1,GetCentroid()));
 		for(size2=NbSubObjects,cur2=thObjs2;--size2;cur2++)
 		{
 			if((*cur1)==(*cur2))
 				continue;
-			NewAvgIntraSim=(tmpBase-Owner->Instance->GetSim(*cur2,GetCentroid()))/static_cast<double>(NewNbObjs-2);
+			NewAvgIntraSim=(tmpBase-Owner->Instance->Sim(*cur2,GetCentroid()))/static_cast<double>(NewNbObjs-2);
 			if(NewAvgIntraSim>AvgIntraSim)
 			{
 				// OK remove cur1
@@ -359,17 +412,17 @@ template<class cGroup,class cObj,class cGroups>
 	for(size1=NbSubObjects,cur1=thObjs2;--size1;cur1++)
 	{
 		// Remove cur1?
-		double tmpBase(NewBase-Owner->Instance->GetSim(*cur1,GetCentroid()));
+		double tmpBase(NewBase-Owner->Instance->Sim(*cur1,GetCentroid()));
 		for(size2=NbSubObjects,cur2=thObjs2;--size2;cur2++)
 		{
 			if((*cur1)==(*cur2))
 				continue;
-			double tmpBase2(tmpBase-Owner->Instance->GetSim(*cur2,GetCentroid()));
+			double tmpBase2(tmpBase-Owner->Instance->Sim(*cur2,GetCentroid()));
 			for(size3=NbSubObjects,cur3=thObjs2;--size3;cur3++)
 			{
 				if(((*cur3)==(*cur1))||((*cur3)==(*cur2)))
 					continue;
-				NewAvgIntraSim=(tmpBase2-Owner->Instance->GetSim(*cur3,GetCentroid()))/static_cast<double>(NewNbObjs-3);
+				NewAvgIntraSim=(tmpBase2-Owner->Instance->Sim(*cur3,GetCentroid()))/static_cast<double>(NewNbObjs-3);
 				if(NewAvgIntraSim>AvgIntraSim)
 				{
 					// OK remove cur1
@@ -99,6 +99,11 @@ public:
 	 */
 	size_t NbSols;
 
+	/**
+	* Temporary array of identifiers of objects.
+	*/
+	size_t* tmpIds;
+
 	/**
 	* Construct the data.
 	* @param owner           Instance of the problem.
@@ -157,6 +162,38 @@ protected:
 	*/
 	RContainer<cObj,false,true> NoSocialObjs;
 
+	/**
+	* Memory allocated for the blocks of similarities and ratios.
+	*/
+	float* Blocks;
+
+	/**
+	* Maximal size (in bytes) of the memory allocated for the blocks.
+	*/
+	size_t MaxBlocksSize;
+
+	/**
+	* Number of values in a row of a block. It is a multiple of the number of
+	* values in a cache line.
+	*/
+	size_t BlockStride;
+
+	/**
+	* Similarities between the objects (the row and the column of a value are
+	* the identifiers of the objects). Null if the blocks are not used.
+	*/
+	float* SimBlock;
+
+	/**
+	* Agreement ratios between the objects.
+	*/
+	float* AgreementBlock;
+
+	/**
+	* Disagreement ratios between the objects.
+	*/
+	float* DisagreementBlock;
+
 #if BESTSOLSVERIFICATION
 	/**
 	* Container holding the best chromosomes.
@@ -181,8 +218,10 @@ public:
 
 	/**
 	* Create a specific heuristic for the algorithm.
+	* @param random         Random number generator of the "thread-dependent"
+	*                       data that will hold the heuristic.
 	*/
-	virtual R::RGroupingHeuristic<cGroup,cObj,cChromo>* CreateHeuristic(void);
+	virtual R::RGroupingHeuristic<cGroup,cObj,cChromo>* CreateHeuristic(RRandom& random);
 
 	/**
 	* @returns The object corresponding to an element.
@@ -229,6 +268,129 @@ public:
 	*/
 	virtual double GetSim(const cObj* obj1,const cObj* obj2) const=0;
 
+	/**
+	* Use or not dense blocks storing the similarities and the ratios between
+	* all the objects. When they are used, the evaluation of the groups
+	* accesses the rows of the blocks directly rather than calling GetSim,
+	* GetAgreementRatio and GetDisagreementRatio for each pair of objects. The
+	* blocks need three times (n*n) single precision values, where n is the
+	* greatest identifier of the objects (12*n*n bytes). If they need more
+	* memory than allowed (see SetMaxBlocksSize), they are not used and the
+	* values are computed for each pair of objects: the result of the method
+	* must then be checked. For example, 20000 objects need about 4.5 GB.
+	*
+	* This method must be called once the instance is initialized, and again
+	* if the similarities or the ratios change.
+	* @param use            Use the blocks?
+	* @return true if the blocks are used.
+	*/
+	bool SetBlocks(bool use);
+
+	/**
+	* Set the maximal size of the memory allocated for the blocks. By default,
+	* it is cMaxBlocksSize. The size is only checked by the next call to
+	* SetBlocks.
+	* @param size           Size (in bytes).
+	*/
+	void SetMaxBlocksSize(size_t size) {MaxBlocksSize=size;}
+
+	/**
+	* Default maximal size (in bytes) of the memory allocated for the blocks
+	* (256 MB, i.e. about 4700 objects). Larger sets of objects need a greater
+	* size.
+	*/
+	static const size_t cMaxBlocksSize=256*1024*1024;
+
+	/**
+	* Look if the dense blocks of similarities and ratios are used.
+	*/
+	inline bool UseBlocks(void) const {return(SimBlock);}
+
+	/**
+	* Get the similarity between two elements, from the block if it is used.
+	* @param obj1            First element.
+	* @param obj2            Second element.
+	*/
+	inline double Sim(const cObj* obj1,const cObj* obj2) const
+	{
+		if(SimBlock)
+			return(SimBlock[obj1->GetId()*BlockStride+obj2->GetId()]);
+		return(GetSim(obj1,obj2));
+	}
+
+	/**
+	* Get the agreement ratio between two elements, from the block if it is
+	* used.
+	* @param obj1            First element.
+	* @param obj2            Second element.
+	*/
+	inline double Agreement(const cObj* obj1,const cObj* obj2) const
+	{
+		if(AgreementBlock)
+			return(AgreementBlock[obj1->GetId()*BlockStride+obj2->GetId()]);
+		return(GetAgreementRatio(obj1,obj2));
+	}
+
+	/**
+	* Get the disagreement ratio between two elements, from the block if it is
+	* used.
+	* @param obj1            First element.
+	* @param obj2            Second element.
+	*/
+	inline double Disagreement(const cObj* obj1,const cObj* obj2) const
+	{
+		if(DisagreementBlock)
+			return(DisagreementBlock[obj1->GetId()*BlockStride+obj2->GetId()]);
+		return(GetDisagreementRatio(obj1,obj2));
+	}
+
+	/**
+	* Get the row of the similarity block of a given element. The blocks must
+	* be used.
+	* @param obj             Element.
+	*/
+	inline const float* GetSimRow(const cObj* obj) const {return(&SimBlock[obj->GetId()*BlockStride]);}
+
+	/**
+	* Get the row of the agreement block of a given element. The blocks must
+	* be used.
+	* @param obj             Element.
+	*/
+	inline const float* GetAgreementRow(const cObj* obj) const {return(&AgreementBlock[obj->GetId()*BlockStride]);}
+
+	/**
+	* Get the row of the disagreement block of a given element. The blocks
+	* must be used.
+	* @param obj             Element.
+	*/
+	inline const float* GetDisagreementRow(const cObj* obj) const {return(&DisagreementBlock[obj->GetId()*BlockStride]);}
+
+	/**
+	* Sum the values of a row of a block for a given set of elements. Several
+	* partial sums are computed independently so that the compiler can
+	* vectorize the loop. The sums are computed in double precision.
+	* @param row             Row of a block.
+	* @param ids             Identifiers of the elements.
+	* @param nb              Number of elements.
+	*/
+	static double SumRow(const float* row,const size_t* ids,size_t nb);
+
+protected:
+
+	/**
+	* Fill the blocks of similarities and ratios. By default, GetSim,
+	* GetAgreementRatio and GetDisagreementRatio are called for each pair of
+	* objects. An inheriting class that stores these values can overload the
+	* method to copy them directly.
+	* @param sims            Block of similarities.
+	* @param agree           Block of agreement ratios.
+	* @param disagree        Block of disagreement ratios.
+	* @param stride          Number of values in a row of a block.
+	*/
+	virtual void FillBlocks(float* sims,float* agree,float* disagree,size_t stride);
+
+public:
+
 	/**
 	* This function can be used to do a treatment after the GA stops.
 	*/
@@ -39,7 +39,7 @@ template<class cInst,class cChromo,class cThreadData,class cGroup,class cObj>
 	RThreadDataSG<cInst,cChromo,cThreadData,cGroup,cObj>::RThreadDataSG(cInst* owner)
 		: RThreadDataG<cInst,cChromo,RFitnessSG,cThreadData,cGroup,cObj>(owner),
 	  ToDel(owner->Objs.GetNb()<4?4:owner->Objs.GetNb()/4), tmpObjs1(0),tmpObjs2(0), Tests(0),
-	  Prom(owner->Params), Sols(0), NbSols((owner->Params->NbDivChromo*2)+1)
+	  Prom(owner->Params), Sols(0), NbSols((owner->Params->NbDivChromo*2)+1), tmpIds(0)
 {
 	RPromSol** s;
 	size_t i;
@@ -61,6 +61,7 @@ template<class cInst,class cChromo,class cThreadData,class cGroup,class cObj>
 
 	tmpObjs1=new cObj*[Owner->Objs.GetNb()];
 	tmpObjs2=new cObj*[Owner->Objs.GetNb()];
+	tmpIds=new size_t[Owner->Objs.GetNb()];
 	for(i=0;i<NbSols;i++)
 	{
 		Tests[i]=new cChromo(Owner,Owner->GetPopSize()+1+i);
@@ -86,6 +87,7 @@ template<class cInst,class cChromo,class cThreadData,class cGroup,class cObj>
 	delete[] Sols;
 	delete[] tmpObjs1;
 	delete[] tmpObjs2;
+	delete[] tmpIds;
 }
 
 
@@ -100,7 +102,8 @@ template<class cInst,class cChromo,class cThreadData,class cGroup,class cObj>
 template<class cInst,class cChromo,class cThreadData,class cGroup,class cObj>
 	RInstSG<cInst,cChromo,cThreadData,cGroup,cObj>::RInstSG(RCursor<cObj> objs,RParamsSG* p,RDebug *debug)
 		: RInstG<cInst,cChromo,RFitnessSG,cThreadData,cGroup,cObj>(p->PopSize,objs,"SCFirstFit","SCGA",debug),
-		RPromKernelSC<cChromo>(p), Params(p), Sols(0), NoSocialObjs(objs.GetNb())
+		RPromKernelSC<cChromo>(p), Params(p), Sols(0), NoSocialObjs(objs.GetNb()),
+		Blocks(0), MaxBlocksSize(cMaxBlocksSize), BlockStride(0), SimBlock(0), AgreementBlock(0), DisagreementBlock(0)
 #if BESTSOLSVERIFICATION
 	  , BestSols(p->MaxGen,p->MaxGen/2)
 #endif
@@ -108,6 +111,9 @@ template<class cInst,class cChromo,class cThreadData,class cGroup,class cObj>
 	RPromSol** ptr;
 	size_t i;
 
+	// PROMETHEE recomputes the fitness of all the chromosomes
+	this->PostEvaluateFitness=true;
+
 	// Change Freq
 	SetMutationParams(5,8,1);
 
@@ -149,14 +155,15 @@ template<class cInst,class cChromo,class cThreadData,class cGroup,class cObj>
 			}
 		}
 	}
+	Params->OrderCloseObjects();
 }
 
 
 //-----------------------------------------------------------------------------
 template<class cInst,class cChromo,class cThreadData,class cGroup,class cObj>
-	RGroupingHeuristic<cGroup,cObj,cChromo>* RInstSG<cInst,cChromo,cThreadData,cGroup,cObj>::CreateHeuristic(void)
+	RGroupingHeuristic<cGroup,cObj,cChromo>* RInstSG<cInst,cChromo,cThreadData,cGroup,cObj>::CreateHeuristic(RRandom& random)
 {
-	return(new RHeuristicSG<cGroup,cObj,cChromo>(Random,Objs,Params,Debug));
+	return(new RHeuristicSG<cGroup,cObj,cChromo>(random,Objs,Params,Debug));
 }
 
 
@@ -234,9 +241,7 @@ template<class cInst,class cChromo,class cThreadData,class cGroup,class cObj>
 		// -> If not, exchange the first two solutions
 		if(!BestChromosome->Used.GetNb())
 		{
-			RPromSol* old=Res[0];
-			Res.InsertPtrAt(Res[1],0,false);
-			Res.InsertPtrAt(old,1,false);
+			Res.Exchange(0,1);
 			s=Chromosomes[ptr()->GetId()-1];
 		}
 
@@ -287,6 +292,82 @@ template<class cInst,class cChromo,class cThreadData,class cGroup,class cObj>
 }
 
 
+//-----------------------------------------------------------------------------
+template<class cInst,class cChromo,class cThreadData,class cGroup,class cObj>
+	bool RInstSG<cInst,cChromo,cThreadData,cGroup,cObj>::SetBlocks(bool use)
+{
+	delete[] Blocks;
+	Blocks=SimBlock=AgreementBlock=DisagreementBlock=0;
+	BlockStride=0;
+	if((!use)||(!Objs.GetNb()))
+		return(false);
+
+	// A row of each block starts on a cache line (64 bytes)
+	size_t NbIds(0);
+	RCursor<cObj> Cur(Objs);
+	for(Cur.Start();!Cur.End();Cur.Next())
+		if(Cur()->GetId()>=NbIds)
+			NbIds=Cur()->GetId()+1;
+	const size_t Line(64/sizeof(float));
+	size_t Stride(((NbIds+Line-1)/Line)*Line);
+
+	// Too large blocks: the values are computed for each pair of objects
+	size_t Max(MaxBlocksSize/sizeof(float));
+	if((Max<Line)||(NbIds>(Max-Line)/(3*Stride)))
+		return(false);
+
+	BlockStride=Stride;
+	size_t Size(NbIds*BlockStride);
+	Blocks=new float[3*Size+Line];
+	SimBlock=Blocks+(Line-(reinterpret_cast<size_t>(Blocks)/sizeof(float))%Line)%Line;
+	AgreementBlock=SimBlock+Size;
+	DisagreementBlock=AgreementBlock+Size;
+	memset(SimBlock,0,3*Size*sizeof(float));
+	FillBlocks(SimBlock,AgreementBlock,DisagreementBlock,BlockStride);
+	return(true);
+}
+
+
+//-----------------------------------------------------------------------------
+template<class cInst,class cChromo,class cThreadData,class cGroup,class cObj>
+	void RInstSG<cInst,cChromo,cThreadData,cGroup,cObj>::FillBlocks(float* sims,float* agree,float* disagree,size_t stride)
+{
+	RCursor<cObj> Cur1(Objs);
+	RCursor<cObj> Cur2(Objs);
+	for(Cur1.Start();!Cur1.End();Cur1.Next())
+	{
+		size_t Row(Cur1()->GetId()*stride);
+		for(Cur2.Start();!Cur2.End();Cur2.Next())
+		{
+			size_t Pos(Row+Cur2()->GetId());
+			sims[Pos]=GetSim(Cur1(),Cur2());
+			agree[Pos]=GetAgreementRatio(Cur1(),Cur2());
+			disagree[Pos]=GetDisagreementRatio(Cur1(),Cur2());
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------
+template<class cInst,class cChromo,class cThreadData,class cGroup,class cObj>
+	double RInstSG<cInst,cChromo,cThreadData,cGroup,cObj>::SumRow(const float* row,const size_t* ids,size_t nb)
+{
+	double Sum0(0.0),Sum1(0.0),Sum2(0.0),Sum3(0.0);
+	size_t i;
+
+	for(i=0;i+4<=nb;i+=4,ids+=4)
+	{
+		Sum0+=row[ids[0]];
+		Sum1+=row[ids[1]];
+		Sum2+=row[ids[2]];
+		Sum3+=row[ids[3]];
+	}
+	for(;i<nb;i++,ids++)
+		Sum0+=row[*ids];
+	return((Sum0+Sum1)+(Sum2+Sum3));
+}
+
+
 //-----------------------------------------------------------------------------
 template<class cInst,class cChromo,class cThreadData,class cGroup,class cObj>
 	void RInstSG<cInst,cChromo,cThreadData,cGroup,cObj>::PostRun(void)
@@ -322,4 +403,5 @@ template<class cInst,class cChromo,class cThreadData,class cGroup,class cObj>
 {
 	if(Sols)
 		delete[] Sols;
+	delete[] Blocks;
 }
@@ -123,3 +123,17 @@ void RParamsSG::AddCloseObject(size_t id,size_t closeid,double ratio)
 	Obj->CloseObjs.InsertPtr(new RCloseObjSG(closeid,ratio));
 	Obj->MustReOrder=true;
 }
+
+
+//------------------------------------------------------------------------------
+void RParamsSG::OrderCloseObjects(void)
+{
+	RCursor<RObjRefSG> Obj(Objs);
+	for(Obj.Start();!Obj.End();Obj.Next())
+	{
+		if(!Obj()->MustReOrder)
+			continue;
+		Obj()->MustReOrder=false;
+		Obj()->CloseObjs.ReOrder(RCloseObjSG::sortOrder);
+	}
+}
@@ -337,6 +337,13 @@ public:
 	 */
 	void AddCloseObject(size_t id,size_t closeid,double ratio);
 
+	/**
+	 * Order the close objects of all the objects. Once it is done,
+	 * FindBestGroup does not modify the parameters anymore and can be called by
+	 * several threads.
+	 */
+	void OrderCloseObjects(void);
+
 	/**
 	 * Find the best group for the object based on the current clustering and
 	 * the ratio.
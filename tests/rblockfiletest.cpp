@@ -0,0 +1,224 @@
+/*
+
+	R Project Library
+
+	RBlockFileTest.cpp
+
+	Check the accesses of several threads to a RBlockFile - Program.
+
+	Copyright 2015 by Pascal Francq (pascal@francq.info).
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Library General Public
+	License as published by the Free Software Foundation; either
+	version 2.0 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Library General Public License for more details.
+
+	You should have received a copy of the GNU Library General Public
+	License along with this library, as a file COPYING.LIB; if not, write
+	to the Free Software Foundation, Inc., 59 Temple Place, Suite 330,
+	Boston, MA  02111-1307  USA
+
+*/
+
+
+
+//------------------------------------------------------------------------------
+// include files for ANSI C/C++
+#include <iostream>
+#include <string.h>
+
+
+//------------------------------------------------------------------------------
+// include files for R Project
+#include <rblockfile.h>
+#include <rblockfileaccess.h>
+#include <rthreadpool.h>
+using namespace R;
+using namespace std;
+
+
+//------------------------------------------------------------------------------
+// The cache is smaller than the number of blocks so that the threads replace
+// the blocks used by the other ones.
+const size_t cNbBlocks=64;
+const size_t cBlockSize=1024;
+const size_t cNbCaches=6;
+const size_t cNbReads=4000;
+const size_t cReadSize=64;
+const size_t cNbThreads=4;
+size_t NbErrors(0);
+
+
+
+//------------------------------------------------------------------------------
+class File : public RBlockFile
+{
+public:
+	File(const RURI& uri) : RBlockFile(uri,cBlockSize/1024,cNbCaches) {}
+	using RBlockFile::Open;
+};
+
+
+//------------------------------------------------------------------------------
+inline char Byte(size_t blockid,size_t pos,size_t version)
+{
+	return(static_cast<char>(blockid*131+pos*7+version));
+}
+
+
+//------------------------------------------------------------------------------
+// Check a buffer read at a given position of a block.
+void CheckRead(const char* buffer,size_t blockid,size_t pos,size_t version)
+{
+	for(size_t i=0;i<cReadSize;i++)
+		if(buffer[i]!=Byte(blockid,pos+i,version))
+		{
+			__atomic_add_fetch(&NbErrors,1,__ATOMIC_RELAXED);
+			return;
+		}
+}
+
+
+//------------------------------------------------------------------------------
+// Each index reads some bytes of a block with an access or a positioned read.
+class Reader
+{
+public:
+	File* F;
+	size_t Version;
+
+	Reader(File* file,size_t version) : F(file), Version(version) {}
+	void operator()(size_t i,size_t)
+	{
+		char Buffer[cReadSize];
+		size_t BlockId((i*37)%cNbBlocks+1);
+		size_t Pos((i*13)%(cBlockSize-cReadSize));
+		if(i%2)
+			F->Read(BlockId,Pos,Buffer,cReadSize);
+		else
+		{
+			RBlockFileAccess Access(F,BlockId,Pos);
+			Access.Read(Buffer,cReadSize);
+		}
+		CheckRead(Buffer,BlockId,Pos,Version);
+	}
+};
+
+
+//------------------------------------------------------------------------------
+// Each index rewrites a whole block with an access and reads it again.
+class Writer
+{
+public:
+	File* F;
+	size_t Version;
+
+	Writer(File* file,size_t version) : F(file), Version(version) {}
+	void operator()(size_t i,size_t)
+	{
+		char Buffer[cBlockSize];
+		size_t BlockId(i+1);
+		for(size_t Pos=0;Pos<cBlockSize;Pos++)
+			Buffer[Pos]=Byte(BlockId,Pos,Version);
+		RBlockFileAccess Access(F,BlockId,0);
+		Access.Write(Buffer,cBlockSize);
+		Access.Seek(BlockId,cReadSize);
+		Access.Read(Buffer,cReadSize);
+		CheckRead(Buffer,BlockId,cReadSize,Version);
+	}
+};
+
+
+
+//------------------------------------------------------------------------------
+// Check the blocks sequentially through the current position of the file.
+void CheckFile(File& file,size_t version)
+{
+	char Buffer[cBlockSize];
+	for(size_t BlockId=1;BlockId<=cNbBlocks;BlockId++)
+	{
+		file.Seek(BlockId,0);
+		file.Read(Buffer,cBlockSize);
+		for(size_t Pos=0;Pos<cBlockSize;Pos++)
+			if(Buffer[Pos]!=Byte(BlockId,Pos,version))
+			{
+				cerr<<"Block "<<BlockId<<" differs from the data written"<<endl;
+				NbErrors++;
+				break;
+			}
+	}
+}
+
+
+//------------------------------------------------------------------------------
+void CheckAccesses(const RURI& uri,bool async)
+{
+	char Buffer[cBlockSize];
+	RThreadPool Pool(cNbThreads);
+
+	// Write the initial version sequentially
+	File Init(uri);
+	Init.Open(RIO::Create);
+	for(size_t BlockId=1;BlockId<=cNbBlocks;BlockId++)
+	{
+		for(size_t Pos=0;Pos<cBlockSize;Pos++)
+			Buffer[Pos]=Byte(BlockId,Pos,0);
+		Init.Seek(BlockId,0);
+		Init.Write(Buffer,cBlockSize);
+	}
+	Init.Close();
+
+	// Read it and rewrite it in parallel
+	File Test(uri);
+	Test.Open(RIO::ReadWrite);
+	Test.SetCacheType(RBlockFile::WriteBack);
+	if(async)
+		Test.SetAsyncIO(true);
+	Reader Read0(&Test,0);
+	Pool.ParallelFor(0,cNbReads,Read0,16);
+	Writer Write1(&Test,1);
+	Pool.ParallelFor(0,cNbBlocks,Write1);
+	Reader Read1(&Test,1);
+	Pool.ParallelFor(0,cNbReads,Read1,16);
+	if(NbErrors)
+		cerr<<"Wrong data read by the threads"<<(async?" (asynchronous I/O)":"")<<endl;
+	CheckFile(Test,1);
+	Test.Close();
+
+	// Check what was saved
+	File Saved(uri);
+	Saved.Open(RIO::Read);
+	CheckFile(Saved,1);
+	Saved.Close();
+}
+
+
+
+//------------------------------------------------------------------------------
+int main(void)
+{
+	RURI URI(RFile::GetTempFile());
+
+	try
+	{
+		CheckAccesses(URI,false);
+		CheckAccesses(URI,true);
+	}
+	catch(RException& e)
+	{
+		cerr<<e.GetMsg()<<endl;
+		NbErrors++;
+	}
+	if(RFile::Exists(URI))
+		RFile::RemoveFile(URI);
+
+	if(NbErrors)
+		return(1);
+	cout<<"Data read by the threads identical to the data written"<<endl;
+	return(0);
+}
@@ -0,0 +1,297 @@
+/*
+
+	R Project Library
+
+	RFitnessCacheTest.cpp
+
+	Check the fitness cache of RInst - Program.
+
+	Copyright 2015 by Pascal Francq (pascal@francq.info).
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Library General Public
+	License as published by the Free Software Foundation; either
+	version 2.0 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Library General Public License for more details.
+
+	You should have received a copy of the GNU Library General Public
+	License along with this library, as a file COPYING.LIB; if not, write
+	to the Free Software Foundation, Inc., 59 Temple Place, Suite 330,
+	Boston, MA  02111-1307  USA
+
+*/
+
+
+
+//------------------------------------------------------------------------------
+// include files for ANSI C/C++
+#include <iostream>
+#include <string.h>
+
+
+//------------------------------------------------------------------------------
+// include files for R Project
+#include <rinst.h>
+#include <rchromo.h>
+#include <rfitness.h>
+#include <rfitnesscache.h>
+using namespace R;
+using namespace std;
+
+
+//------------------------------------------------------------------------------
+// The genotypes are short so that the same ones appear often, and their hash
+// code is the number of genes set so that different genotypes collide.
+const size_t cNbGenes=24;
+const size_t cPopSize=40;
+const size_t cMaxGen=50;
+size_t NbEvaluations(0);
+size_t NbErrors(0);
+
+
+
+//------------------------------------------------------------------------------
+class Inst;
+class Chromo;
+typedef RFitness<double,true> Fit;
+
+
+//------------------------------------------------------------------------------
+class ThData : public RThreadData<Inst,Chromo>
+{
+public:
+	ThData(Inst* owner) : RThreadData<Inst,Chromo>(owner) {}
+};
+
+
+//------------------------------------------------------------------------------
+class Chromo : public RChromo<Inst,Chromo,Fit,ThData>
+{
+public:
+	char Genes[cNbGenes];
+	size_t NbSet;
+
+	Chromo(Inst* inst,size_t id) : RChromo<Inst,Chromo,Fit,ThData>(inst,id), NbSet(0) {}
+	virtual void RandomConstruct(void);
+	virtual void Evaluate(void);
+	virtual void Crossover(Chromo* parent1,Chromo* parent2);
+	virtual void Mutation(void);
+	virtual void Copy(const Chromo& chromo);
+	virtual size_t HashGenotype(void);
+	virtual void SaveGenotype(RNumContainer<size_t,false>& genotype);
+	virtual void SaveEvaluation(RNumContainer<double,false>& values) const;
+	virtual void RestoreEvaluation(const RNumContainer<double,false>& values);
+	size_t CountSet(void) const;
+	double Value(void) const;
+};
+
+
+//------------------------------------------------------------------------------
+class Inst : public RInst<Inst,Chromo,Fit,ThData>
+{
+public:
+	Inst(void) : RInst<Inst,Chromo,Fit,ThData>(cPopSize,"Test") {}
+	virtual bool StopCondition(void) {return(GetGen()>=cMaxGen);}
+	virtual void HandlerNotFound(const RNotification&) {}
+};
+
+
+//------------------------------------------------------------------------------
+void Chromo::RandomConstruct(void)
+{
+	for(size_t i=0;i<cNbGenes;i++)
+		Genes[i]=static_cast<char>(Instance->RRand(2));
+}
+
+
+//------------------------------------------------------------------------------
+void Chromo::Evaluate(void)
+{
+	__atomic_add_fetch(&NbEvaluations,1,__ATOMIC_RELAXED);
+	NbSet=CountSet();
+	(*Fitness)=Value();
+}
+
+
+//------------------------------------------------------------------------------
+void Chromo::Crossover(Chromo* parent1,Chromo* parent2)
+{
+	size_t Cut(0);
+	for(size_t i=0;i<cNbGenes;i++)
+		Cut=Cut*31+parent1->Genes[i]+2*parent2->Genes[i];
+	Cut%=cNbGenes;
+	memcpy(Genes,parent1->Genes,Cut);
+	memcpy(&Genes[Cut],&parent2->Genes[Cut],cNbGenes-Cut);
+}
+
+
+//------------------------------------------------------------------------------
+void Chromo::Mutation(void)
+{
+	size_t i(Instance->RRand(cNbGenes));
+	Genes[i]=!Genes[i];
+}
+
+
+//------------------------------------------------------------------------------
+void Chromo::Copy(const Chromo& chromo)
+{
+	RChromo<Inst,Chromo,Fit,ThData>::Copy(chromo);
+	memcpy(Genes,chromo.Genes,cNbGenes);
+	NbSet=chromo.NbSet;
+}
+
+
+//------------------------------------------------------------------------------
+size_t Chromo::HashGenotype(void)
+{
+	return(CountSet()+1);
+}
+
+
+//------------------------------------------------------------------------------
+void Chromo::SaveGenotype(RNumContainer<size_t,false>& genotype)
+{
+	size_t Bits(0);
+	for(size_t i=0;i<cNbGenes;i++)
+		Bits=(Bits<<1)|Genes[i];
+	genotype.Clear();
+	genotype.Insert(Bits);
+}
+
+
+//------------------------------------------------------------------------------
+void Chromo::SaveEvaluation(RNumContainer<double,false>& values) const
+{
+	values.Clear();
+	values.Insert(static_cast<double>(NbSet));
+}
+
+
+//------------------------------------------------------------------------------
+void Chromo::RestoreEvaluation(const RNumContainer<double,false>& values)
+{
+	NbSet=static_cast<size_t>(values[0]);
+}
+
+
+//------------------------------------------------------------------------------
+size_t Chromo::CountSet(void) const
+{
+	size_t Nb(0);
+	for(size_t i=0;i<cNbGenes;i++)
+		Nb+=Genes[i];
+	return(Nb);
+}
+
+
+//------------------------------------------------------------------------------
+double Chromo::Value(void) const
+{
+	double Sum(0.0);
+	for(size_t i=0;i<cNbGenes;i++)
+		if(Genes[i]!=Genes[(i+1)%cNbGenes])
+			Sum+=static_cast<double>((i*7)%cNbGenes+1);
+	return(Sum);
+}
+
+
+
+//------------------------------------------------------------------------------
+void Check(bool cond,const char* msg)
+{
+	if(cond)
+		return;
+	cerr<<msg<<endl;
+	NbErrors++;
+}
+
+
+//------------------------------------------------------------------------------
+void CheckCache(void)
+{
+	RFitnessCache<Fit> Cache(2);
+	RNumContainer<size_t,false> Genotype(1),Other(1);
+	RNumContainer<double,false> Values(1),Found(1);
+	Fit Fitness;
+
+	// Two genotypes with the same hash code
+	Genotype.Insert(1);
+	Values.Insert(10.0);
+	Fitness=1.0;
+	Cache.Insert(5,Genotype,Fitness,Values);
+	Other.Insert(2);
+	Check(!Cache.Find(5,Other,Fitness,Found),"A genotype was found with the hash code of another one");
+	Check(Cache.Find(5,Genotype,Fitness,Found),"A genotype stored was not found");
+	Check((Fitness.Value==1.0)&&(Found.GetNb()==1)&&(Found[0]==10.0),"The evaluation found is not the one stored");
+	Fitness=2.0;
+	Cache.Insert(5,Other,Fitness,Found);
+
+	// The least recently used genotype is replaced
+	Check(Cache.Find(5,Genotype,Fitness,Found),"A genotype stored was not found");
+	Other.Clear();
+	Other.Insert(3);
+	Cache.Insert(7,Other,Fitness,Found);
+	Check(Cache.GetNb()==2,"The cache stores more evaluations than allowed");
+	Check(Cache.Find(5,Genotype,Fitness,Found),"The most recently used genotype was replaced");
+	Other.Clear();
+	Other.Insert(2);
+	Check(!Cache.Find(5,Other,Fitness,Found),"The least recently used genotype was not replaced");
+}
+
+
+//------------------------------------------------------------------------------
+void CheckRun(size_t nbthreads)
+{
+	Inst Ref;
+	Ref.SetNbThreads(nbthreads);
+	Ref.Init();
+	NbEvaluations=0;
+	Ref.Run();
+	size_t RefEvaluations(NbEvaluations);
+
+	Inst Test;
+	Test.SetNbThreads(nbthreads);
+	Test.SetFitnessCache(100);
+	Test.Init();
+	NbEvaluations=0;
+	Test.Run();
+
+	Check(Test.BestChromosome->Fitness->Value==Ref.BestChromosome->Fitness->Value,"The best fitness differs with the cache");
+	for(size_t i=0;i<cPopSize;i++)
+	{
+		const Chromo* C(Test.Chromosomes[i]);
+		Check(!memcmp(C->Genes,Ref.Chromosomes[i]->Genes,cNbGenes),"A chromosome differs with the cache");
+		Check(C->Fitness->Value==C->Value(),"A fitness found in the cache is wrong");
+		Check(C->NbSet==C->CountSet(),"A value found in the cache is wrong");
+	}
+	Check(Test.GetFitnessCache()->GetNbHits()>0,"No evaluation was found in the cache");
+	Check(NbEvaluations<RefEvaluations,"The cache does not avoid evaluations");
+}
+
+
+
+//------------------------------------------------------------------------------
+int main(void)
+{
+	try
+	{
+		CheckCache();
+		CheckRun(1);
+		CheckRun(3);
+	}
+	catch(RException& e)
+	{
+		cerr<<e.GetMsg()<<endl;
+		return(1);
+	}
+
+	if(NbErrors)
+		return(1);
+	cout<<"Runs with the fitness cache identical to the ones without"<<endl;
+	return(0);
+}
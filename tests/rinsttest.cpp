@@ -0,0 +1,191 @@
+/*
+
+	R Project Library
+
+	RInstTest.cpp
+
+	Check the parallel evaluations and crossovers of RInst - Program.
+
+	Copyright 2015 by Pascal Francq (pascal@francq.info).
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Library General Public
+	License as published by the Free Software Foundation; either
+	version 2.0 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Library General Public License for more details.
+
+	You should have received a copy of the GNU Library General Public
+	License along with this library, as a file COPYING.LIB; if not, write
+	to the Free Software Foundation, Inc., 59 Temple Place, Suite 330,
+	Boston, MA  02111-1307  USA
+
+*/
+
+
+
+//------------------------------------------------------------------------------
+// include files for ANSI C/C++
+#include <iostream>
+#include <string.h>
+
+
+//------------------------------------------------------------------------------
+// include files for R Project
+#include <rinst.h>
+#include <rchromo.h>
+#include <rfitness.h>
+using namespace R;
+using namespace std;
+
+
+//------------------------------------------------------------------------------
+// The crossover only depends on the parents and the other operators use the
+// random number generator of the instance in the main thread: a run must
+// therefore give the same population whatever the number of threads used.
+const size_t cNbGenes=200;
+const size_t cPopSize=60;
+const size_t cMaxGen=150;
+
+
+
+//------------------------------------------------------------------------------
+class Inst;
+class Chromo;
+typedef RFitness<double,true> Fit;
+
+
+//------------------------------------------------------------------------------
+class ThData : public RThreadData<Inst,Chromo>
+{
+public:
+	ThData(Inst* owner) : RThreadData<Inst,Chromo>(owner) {}
+};
+
+
+//------------------------------------------------------------------------------
+class Chromo : public RChromo<Inst,Chromo,Fit,ThData>
+{
+public:
+	char Genes[cNbGenes];
+
+	Chromo(Inst* inst,size_t id) : RChromo<Inst,Chromo,Fit,ThData>(inst,id) {}
+	virtual void RandomConstruct(void);
+	virtual void Evaluate(void) {(*Fitness)=Value();}
+	virtual void Crossover(Chromo* parent1,Chromo* parent2);
+	virtual void Mutation(void);
+	virtual void Copy(const Chromo& chromo);
+	double Value(void) const;
+};
+
+
+//------------------------------------------------------------------------------
+class Inst : public RInst<Inst,Chromo,Fit,ThData>
+{
+public:
+	Inst(void) : RInst<Inst,Chromo,Fit,ThData>(cPopSize,"Test") {}
+	virtual bool StopCondition(void) {return(GetGen()>=cMaxGen);}
+	virtual void HandlerNotFound(const RNotification&) {}
+};
+
+
+//------------------------------------------------------------------------------
+void Chromo::RandomConstruct(void)
+{
+	for(size_t i=0;i<cNbGenes;i++)
+		Genes[i]=static_cast<char>(Instance->RRand(2));
+}
+
+
+//------------------------------------------------------------------------------
+void Chromo::Crossover(Chromo* parent1,Chromo* parent2)
+{
+	size_t Cut(0);
+	for(size_t i=0;i<cNbGenes;i++)
+		Cut=Cut*31+parent1->Genes[i]+2*parent2->Genes[i];
+	Cut%=cNbGenes;
+	memcpy(Genes,parent1->Genes,Cut);
+	memcpy(&Genes[Cut],&parent2->Genes[Cut],cNbGenes-Cut);
+}
+
+
+//------------------------------------------------------------------------------
+void Chromo::Mutation(void)
+{
+	size_t i(Instance->RRand(cNbGenes));
+	Genes[i]=!Genes[i];
+}
+
+
+//------------------------------------------------------------------------------
+void Chromo::Copy(const Chromo& chromo)
+{
+	RChromo<Inst,Chromo,Fit,ThData>::Copy(chromo);
+	memcpy(Genes,chromo.Genes,cNbGenes);
+}
+
+
+//------------------------------------------------------------------------------
+double Chromo::Value(void) const
+{
+	double Sum(0.0);
+	for(size_t i=0;i<cNbGenes;i++)
+		Sum+=Genes[i]*static_cast<double>(i%7+1);
+	return(Sum);
+}
+
+
+
+//------------------------------------------------------------------------------
+int main(void)
+{
+	size_t NbErrors(0);
+
+	try
+	{
+		Inst Ref;
+		Ref.Init();
+		Ref.Run();
+
+		for(size_t NbThreads=2;NbThreads<=4;NbThreads++)
+		{
+			Inst Test;
+			Test.SetNbThreads(NbThreads);
+			Test.Init();
+			Test.Run();
+
+			if(Test.BestChromosome->Fitness->Value!=Ref.BestChromosome->Fitness->Value)
+			{
+				cerr<<NbThreads<<" threads: best fitness "<<Test.BestChromosome->Fitness->Value<<" instead of "<<Ref.BestChromosome->Fitness->Value<<endl;
+				NbErrors++;
+			}
+			for(size_t i=0;i<cPopSize;i++)
+			{
+				const Chromo* C(Test.Chromosomes[i]);
+				if(memcmp(C->Genes,Ref.Chromosomes[i]->Genes,cNbGenes))
+				{
+					cerr<<NbThreads<<" threads: chromosome "<<i<<" differs from the sequential run"<<endl;
+					NbErrors++;
+				}
+				if(C->Fitness->Value!=C->Value())
+				{
+					cerr<<NbThreads<<" threads: chromosome "<<i<<" has a wrong fitness"<<endl;
+					NbErrors++;
+				}
+			}
+		}
+	}
+	catch(RException& e)
+	{
+		cerr<<e.GetMsg()<<endl;
+		return(1);
+	}
+
+	if(NbErrors)
+		return(1);
+	cout<<"Parallel runs identical to the sequential one"<<endl;
+	return(0);
+}
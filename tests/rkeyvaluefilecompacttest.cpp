@@ -0,0 +1,200 @@
+/*
+
+	R Project Library
+
+	RKeyValueFileCompactTest.cpp
+
+	Check the compaction of RKeyValueFile - Program.
+
+	Copyright 2015 by Pascal Francq (pascal@francq.info).
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Library General Public
+	License as published by the Free Software Foundation; either
+	version 2.0 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Library General Public License for more details.
+
+	You should have received a copy of the GNU Library General Public
+	License along with this library, as a file COPYING.LIB; if not, write
+	to the Free Software Foundation, Inc., 59 Temple Place, Suite 330,
+	Boston, MA  02111-1307  USA
+
+*/
+
+
+
+//------------------------------------------------------------------------------
+// include files for ANSI C/C++
+#include <iostream>
+#include <string.h>
+
+
+//------------------------------------------------------------------------------
+// include files for R Project
+#include <rkeyvaluefile.h>
+#include <rkeys.h>
+#include <rnumcontainer.h>
+using namespace R;
+using namespace std;
+
+
+//------------------------------------------------------------------------------
+// The keys are written in a mixed order, then one key out of three is erased
+// and the values of another one are shortened to fragment the file.
+const size_t cNbKeys=3000;
+const size_t cFilterSize=64;
+size_t Blocks[cNbKeys];
+size_t Sizes[cNbKeys];
+size_t NbErrors(0);
+
+
+
+//------------------------------------------------------------------------------
+typedef RKeyValueFile<RIntKey> File;
+
+
+//------------------------------------------------------------------------------
+void Write(File& file,size_t k,size_t size)
+{
+	RNumContainer<size_t,false> Values(40);
+	for(size_t i=0;i<size;i++)
+		Values.Insert(k*100+i);
+	RIntKey Key(k);
+	file.Write(Blocks[k],Key,Values);
+	Sizes[k]=size;
+}
+
+
+//------------------------------------------------------------------------------
+// Check that the stored keys are found with their values and that the erased
+// ones are not.
+void CheckRecords(File& file,const char* step)
+{
+	size_t Nb(0);
+	for(size_t k=0;k<cNbKeys;k++)
+	{
+		RNumContainer<size_t,false> Values(40);
+		RIntKey Key(k);
+		if(!Blocks[k])
+			continue;
+		bool Found(file.Find(Blocks[k],Key,Values));
+		if(!Sizes[k])
+		{
+			if(Found)
+				Nb++;
+			continue;
+		}
+		if((!Found)||(Values.GetNb()!=Sizes[k]))
+		{
+			Nb++;
+			continue;
+		}
+		for(size_t i=0;i<Values.GetNb();i++)
+			if(Values[i]!=k*100+i)
+			{
+				Nb++;
+				break;
+			}
+	}
+	if(Nb)
+		cerr<<Nb<<" wrong records "<<step<<endl;
+	NbErrors+=Nb;
+}
+
+
+//------------------------------------------------------------------------------
+void CheckCompact(const RURI& uri)
+{
+	File Test(uri,4,8,1);
+	Test.SetFilterSize(cFilterSize);
+	Test.Open();
+	for(size_t i=0;i<cNbKeys;i++)
+	{
+		size_t k((i*1237)%cNbKeys);
+		Blocks[k]=0;
+		Write(Test,k,(k*7)%30+1);
+	}
+	for(size_t k=0;k<cNbKeys;k+=3)
+	{
+		RIntKey Key(k);
+		Test.EraseRecord(Blocks[k],Key);
+		Sizes[k]=0;
+	}
+	for(size_t k=1;k<cNbKeys;k+=3)
+		Write(Test,k,1);
+	CheckRecords(Test,"before the compaction");
+
+	// Compact and apply the relocations (the erased keys have no block anymore)
+	for(size_t k=0;k<cNbKeys;k+=3)
+		Blocks[k]=0;
+	size_t NbBlocks(Test.GetNbBlocks());
+	double Fragmentation(Test.GetFragmentation());
+	RContainer<File::Relocation,true,false> Moves(100);
+	Test.Compact(Moves);
+	RCursor<File::Relocation> Move(Moves);
+	for(Move.Start();!Move.End();Move.Next())
+	{
+		size_t k;
+		Move()->Key.GetRaw(reinterpret_cast<char*>(&k));
+		if((k>=cNbKeys)||(!Blocks[k])||(Blocks[k]!=Move()->OldBlockId))
+		{
+			cerr<<"Wrong relocation of key "<<k<<endl;
+			NbErrors++;
+			continue;
+		}
+		Blocks[k]=Move()->NewBlockId;
+	}
+	if((Test.GetNbBlocks()>=NbBlocks)||(Test.GetFragmentation()>=Fragmentation))
+	{
+		cerr<<"The file was not compacted"<<endl;
+		NbErrors++;
+	}
+	if(RFile::Exists(RURI(uri()+".tmp")))
+	{
+		cerr<<"The temporary file was not removed"<<endl;
+		NbErrors++;
+	}
+	CheckRecords(Test,"after the compaction");
+
+	// The file is still opened for writing
+	for(size_t k=0;k<cNbKeys;k+=3)
+	{
+		Blocks[k]=0;
+		Write(Test,k,2);
+	}
+	CheckRecords(Test,"written after the compaction");
+	Test.Close();
+
+	File Saved(uri,4,8,1);
+	Saved.Open();
+	CheckRecords(Saved,"saved after the compaction");
+}
+
+
+
+//------------------------------------------------------------------------------
+int main(void)
+{
+	RURI URI(RFile::GetTempFile());
+
+	try
+	{
+		CheckCompact(URI);
+	}
+	catch(RException& e)
+	{
+		cerr<<e.GetMsg()<<endl;
+		NbErrors++;
+	}
+	if(RFile::Exists(URI))
+		RFile::RemoveFile(URI);
+
+	if(NbErrors)
+		return(1);
+	cout<<"Records after the compaction identical to the ones before"<<endl;
+	return(0);
+}
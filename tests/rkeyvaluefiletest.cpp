@@ -0,0 +1,218 @@
+/*
+
+	R Project Library
+
+	RKeyValueFileTest.cpp
+
+	Check the lookups of RKeyValueFile with Bloom filters - Program.
+
+	Copyright 2015 by Pascal Francq (pascal@francq.info).
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Library General Public
+	License as published by the Free Software Foundation; either
+	version 2.0 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Library General Public License for more details.
+
+	You should have received a copy of the GNU Library General Public
+	License along with this library, as a file COPYING.LIB; if not, write
+	to the Free Software Foundation, Inc., 59 Temple Place, Suite 330,
+	Boston, MA  02111-1307  USA
+
+*/
+
+
+
+//------------------------------------------------------------------------------
+// include files for ANSI C/C++
+#include <iostream>
+
+
+//------------------------------------------------------------------------------
+// include files for R Project
+#include <rkeyvaluefile.h>
+#include <rkeys.h>
+#include <rnumcontainer.h>
+#include <rthreadpool.h>
+using namespace R;
+using namespace std;
+
+
+//------------------------------------------------------------------------------
+// The keys stored are odd and one key out of five is erased. The lookups ask
+// for a stored, an erased or an absent key in the block of a stored key.
+const size_t cNbKeys=2000;
+const size_t cNbLookups=8000;
+const size_t cFilterSize=64;
+const size_t cNbThreads=4;
+size_t Blocks[cNbKeys];
+size_t NbErrors(0);
+
+
+
+//------------------------------------------------------------------------------
+// A lookup and its result: the number of values found (0 if the key was not
+// found) or cNbKeys if the values were wrong.
+class Lookup
+{
+public:
+	size_t BlockId;
+	size_t Key;
+	size_t Result;
+
+	Lookup(void) : BlockId(0), Key(0), Result(0) {}
+};
+Lookup Lookups[cNbLookups];
+
+
+//------------------------------------------------------------------------------
+// Do a lookup and store its result.
+void Find(RKeyValueFile<RIntKey>& file,Lookup& lookup)
+{
+	RNumContainer<size_t,false> Values(40);
+	RIntKey Key(lookup.Key);
+	if(!file.Find(lookup.BlockId,Key,Values))
+	{
+		lookup.Result=0;
+		return;
+	}
+	lookup.Result=Values.GetNb();
+	for(size_t i=0;i<Values.GetNb();i++)
+		if(Values[i]!=(lookup.Key/2)*100+i)
+			lookup.Result=cNbKeys;
+}
+
+
+//------------------------------------------------------------------------------
+class Finder
+{
+public:
+	RKeyValueFile<RIntKey>* File;
+
+	Finder(RKeyValueFile<RIntKey>* file) : File(file) {}
+	void operator()(size_t i,size_t) {Find(*File,Lookups[i]);}
+};
+
+
+//------------------------------------------------------------------------------
+void Create(const RURI& uri)
+{
+	RKeyValueFile<RIntKey> File(uri,4,16,1);
+	File.Open();
+	for(size_t k=0;k<cNbKeys;k++)
+	{
+		RNumContainer<size_t,false> Values(40);
+		for(size_t i=0;i<(k*7)%30+1;i++)
+			Values.Insert(k*100+i);
+		RIntKey Key(2*k+1);
+		Blocks[k]=0;
+		File.Write(Blocks[k],Key,Values);
+	}
+	for(size_t k=0;k<cNbKeys;k+=5)
+	{
+		RIntKey Key(2*k+1);
+		File.EraseRecord(Blocks[k],Key);
+	}
+
+	for(size_t i=0;i<cNbLookups;i++)
+	{
+		size_t k((i*7919)%cNbKeys);
+		Lookups[i].BlockId=Blocks[k];
+		Lookups[i].Key=(i%3)?2*k+1:2*k+2;
+	}
+}
+
+
+//------------------------------------------------------------------------------
+// Do the lookups sequentially without filter and check them.
+void CheckBaseline(const RURI& uri,size_t* results,size_t& nbloads)
+{
+	RKeyValueFile<RIntKey> File(uri,4,16,1);
+	File.Open();
+	File.ResetCounters();
+	for(size_t i=0;i<cNbLookups;i++)
+	{
+		Find(File,Lookups[i]);
+		results[i]=Lookups[i].Result;
+		bool Stored((Lookups[i].Key%2)&&((Lookups[i].Key/2)%5));
+		if((Stored&&(results[i]==0))||((!Stored)&&results[i])||(results[i]==cNbKeys))
+			NbErrors++;
+	}
+	nbloads=File.GetNbHits()+File.GetNbMisses();
+	if(NbErrors)
+		cerr<<"Wrong results without filter"<<endl;
+}
+
+
+//------------------------------------------------------------------------------
+// Do the lookups with a filter set before or after the file is opened.
+void CheckFilter(const RURI& uri,bool before,size_t nbthreads,const size_t* results,size_t nbloads)
+{
+	RKeyValueFile<RIntKey> File(uri,4,16,1);
+	if(before)
+		File.SetFilterSize(cFilterSize);
+	File.Open();
+	if(!before)
+		File.SetFilterSize(cFilterSize);
+	File.ResetCounters();
+	for(size_t i=0;i<cNbLookups;i++)
+		Lookups[i].Result=cNbKeys+1;
+	if(nbthreads>1)
+	{
+		RThreadPool Pool(nbthreads);
+		Finder Func(&File);
+		Pool.ParallelFor(0,cNbLookups,Func,64);
+	}
+	else
+	{
+		for(size_t i=0;i<cNbLookups;i++)
+			Find(File,Lookups[i]);
+		if(File.GetNbHits()+File.GetNbMisses()>=nbloads)
+		{
+			cerr<<"The filter does not avoid to load blocks"<<endl;
+			NbErrors++;
+		}
+	}
+	for(size_t i=0;i<cNbLookups;i++)
+		if(Lookups[i].Result!=results[i])
+		{
+			cerr<<"Lookup of key "<<Lookups[i].Key<<" with a filter differs from the one without"<<endl;
+			NbErrors++;
+		}
+}
+
+
+
+//------------------------------------------------------------------------------
+int main(void)
+{
+	RURI URI(RFile::GetTempFile());
+	size_t* Results(new size_t[cNbLookups]);
+	size_t NbLoads;
+
+	try
+	{
+		Create(URI);
+		CheckBaseline(URI,Results,NbLoads);
+		CheckFilter(URI,true,1,Results,NbLoads);
+		CheckFilter(URI,false,1,Results,NbLoads);
+		CheckFilter(URI,true,cNbThreads,Results,NbLoads);
+	}
+	catch(RException& e)
+	{
+		cerr<<e.GetMsg()<<endl;
+		NbErrors++;
+	}
+	delete[] Results;
+	if(RFile::Exists(URI))
+		RFile::RemoveFile(URI);
+
+	if(NbErrors)
+		return(1);
+	cout<<"Lookups with filters identical to the ones without"<<endl;
+	return(0);
+}
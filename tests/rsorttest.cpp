@@ -0,0 +1,176 @@
+/*
+
+	R Project Library
+
+	RSortTest.cpp
+
+	Check the sorts done by RSort - Program.
+
+	Copyright 2015 by Pascal Francq (pascal@francq.info).
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Library General Public
+	License as published by the Free Software Foundation; either
+	version 2.0 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Library General Public License for more details.
+
+	You should have received a copy of the GNU Library General Public
+	License along with this library, as a file COPYING.LIB; if not, write
+	to the Free Software Foundation, Inc., 59 Temple Place, Suite 330,
+	Boston, MA  02111-1307  USA
+
+*/
+
+
+
+//------------------------------------------------------------------------------
+// include files for ANSI C/C++
+#include <iostream>
+#include <stdlib.h>
+#include <string.h>
+
+
+//------------------------------------------------------------------------------
+// include files for R Project
+#include <rsort.h>
+#include <rcontainer.h>
+#include <rrandom.h>
+using namespace R;
+using namespace std;
+
+
+//------------------------------------------------------------------------------
+// The sizes cover the insertion sort, the ninther and the parallel sort.
+const size_t cSizes[]={0,1,2,3,5,23,24,25,100,128,129,1000,5000,70000,200000};
+const size_t cNbSizes=sizeof(cSizes)/sizeof(size_t);
+const size_t cNbKinds=8;
+const size_t cThreads[]={1,2,4,0};
+const size_t cNbThreads=sizeof(cThreads)/sizeof(size_t);
+size_t NbErrors(0);
+
+
+
+//------------------------------------------------------------------------------
+class Element
+{
+public:
+	int Value;
+	size_t Id;
+
+	Element(int value,size_t id) : Value(value), Id(id) {}
+	int Compare(const Element& element) const {return((Value<element.Value)?-1:((Value>element.Value)?1:0));}
+};
+
+
+//------------------------------------------------------------------------------
+int CompareInts(const void* a,const void* b)
+{
+	int x(*static_cast<const int*>(a)),y(*static_cast<const int*>(b));
+	return((x<y)?-1:((x>y)?1:0));
+}
+
+
+//------------------------------------------------------------------------------
+// Fill an array with random, sorted, reversed, few distinct, organ pipe,
+// constant or almost sorted values.
+void Fill(int* tab,size_t nb,size_t kind,RRandom& random)
+{
+	for(size_t i=0;i<nb;i++)
+		switch(kind)
+		{
+			case 0: tab[i]=static_cast<int>(random.GetValue(1000000)); break;
+			case 1: tab[i]=static_cast<int>(i); break;
+			case 2: tab[i]=static_cast<int>(nb-i); break;
+			case 3: tab[i]=static_cast<int>(random.GetValue(4)); break;
+			case 4: tab[i]=static_cast<int>((i%2)?i:nb-i); break;
+			case 5: tab[i]=static_cast<int>((i<nb/2)?i:nb-i); break;
+			case 6: tab[i]=0; break;
+			default: tab[i]=static_cast<int>((i%100)?i:random.GetValue(1000000)); break;
+		}
+}
+
+
+//------------------------------------------------------------------------------
+// Sort arrays of numbers and compare them with qsort.
+void CheckNumbers(void)
+{
+	RRandom Random(RRandom::Good,7);
+	int* Tab(new int[cSizes[cNbSizes-1]]);
+	int* Ref(new int[cSizes[cNbSizes-1]]);
+	for(size_t th=0;th<cNbThreads;th++)
+		for(size_t s=0;s<cNbSizes;s++)
+			for(size_t kind=0;kind<cNbKinds;kind++)
+			{
+				size_t Nb(cSizes[s]);
+				Fill(Tab,Nb,kind,Random);
+				memcpy(Ref,Tab,Nb*sizeof(int));
+				RSort<int,RSortNumber<int> > Sort(RSortNumber<int>(),cThreads[th]);
+				Sort.Sort(Tab,Nb);
+				qsort(Ref,Nb,sizeof(int),CompareInts);
+				if(memcmp(Tab,Ref,Nb*sizeof(int)))
+				{
+					cerr<<"Wrong sort of "<<Nb<<" numbers of kind "<<kind<<" with "<<cThreads[th]<<" threads"<<endl;
+					NbErrors++;
+				}
+			}
+	delete[] Tab;
+	delete[] Ref;
+}
+
+
+//------------------------------------------------------------------------------
+// Order containers with many equal elements and compare them with qsort.
+void CheckContainer(size_t nbthreads)
+{
+	const size_t Nb(100000);
+	RRandom Random(RRandom::Good,5);
+	RContainer<Element,true,false> Cont(Nb);
+	int* Ref(new int[Nb]);
+	bool* Seen(new bool[Nb]);
+	for(size_t i=0;i<Nb;i++)
+	{
+		Ref[i]=static_cast<int>(Random.GetValue(1000));
+		Cont.InsertPtr(new Element(Ref[i],i));
+		Seen[i]=false;
+	}
+	Cont.ReOrder(RSortPtr<Element>(),0,0,nbthreads);
+	qsort(Ref,Nb,sizeof(int),CompareInts);
+	for(size_t i=0;i<Nb;i++)
+	{
+		Seen[Cont[i]->Id]=true;
+		if(Cont[i]->Value!=Ref[i])
+		{
+			cerr<<"Wrong order of a container with "<<nbthreads<<" threads"<<endl;
+			NbErrors++;
+			break;
+		}
+	}
+	for(size_t i=0;i<Nb;i++)
+		if(!Seen[i])
+		{
+			cerr<<"Element lost when ordering a container with "<<nbthreads<<" threads"<<endl;
+			NbErrors++;
+			break;
+		}
+	delete[] Ref;
+	delete[] Seen;
+}
+
+
+
+//------------------------------------------------------------------------------
+int main(void)
+{
+	CheckNumbers();
+	CheckContainer(1);
+	CheckContainer(4);
+
+	if(NbErrors)
+		return(1);
+	cout<<"Sorts identical to the ones of qsort"<<endl;
+	return(0);
+}
@@ -0,0 +1,305 @@
+/*
+
+	R Project Library
+
+	RThreadPoolTest.cpp
+
+	Check the tasks executed by RThreadPool - Program.
+
+	Copyright 2015 by Pascal Francq (pascal@francq.info).
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Library General Public
+	License as published by the Free Software Foundation; either
+	version 2.0 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Library General Public License for more details.
+
+	You should have received a copy of the GNU Library General Public
+	License along with this library, as a file COPYING.LIB; if not, write
+	to the Free Software Foundation, Inc., 59 Temple Place, Suite 330,
+	Boston, MA  02111-1307  USA
+
+*/
+
+
+
+//------------------------------------------------------------------------------
+// include files for ANSI C/C++
+#include <iostream>
+#include <stdexcept>
+#include <unistd.h>
+
+
+//------------------------------------------------------------------------------
+// include files for R Project
+#include <rthreadpool.h>
+#include <rcontainer.h>
+#include <rnumcontainer.h>
+using namespace R;
+using namespace std;
+
+
+//------------------------------------------------------------------------------
+const size_t cNbRounds=10;
+const size_t cNbValues=100000;
+const size_t cNbElements=1000;
+const size_t cMaxSteps=100000;
+size_t NbErrors(0);
+
+
+
+//------------------------------------------------------------------------------
+void Check(bool cond,const char* msg)
+{
+	if(cond)
+		return;
+	cerr<<msg<<endl;
+	NbErrors++;
+}
+
+
+//------------------------------------------------------------------------------
+inline double Square(size_t i)
+{
+	return(static_cast<double>(i)*static_cast<double>(i));
+}
+
+
+//------------------------------------------------------------------------------
+class SquareFunc
+{
+public:
+	double* Values;
+
+	SquareFunc(double* values) : Values(values) {}
+	void operator()(size_t i,size_t) {Values[i]=Square(i);}
+};
+
+
+//------------------------------------------------------------------------------
+class Element
+{
+public:
+	size_t Id;
+	double Value;
+
+	Element(size_t id) : Id(id), Value(0.0) {}
+	int Compare(const Element& element) const {return(CompareIds(Id,element.Id));}
+};
+
+
+//------------------------------------------------------------------------------
+class ElementFunc
+{
+public:
+	void operator()(Element* element,size_t) {element->Value=Square(element->Id);}
+};
+
+
+//------------------------------------------------------------------------------
+class NumberFunc
+{
+public:
+	void operator()(size_t& value,size_t) {value*=3;}
+};
+
+
+//------------------------------------------------------------------------------
+class ThrowFunc
+{
+public:
+	void operator()(size_t i,size_t) {if(i==777) throw std::range_error("Index 777");}
+};
+
+
+//------------------------------------------------------------------------------
+class Counter
+{
+public:
+	size_t Nb;
+
+	Counter(void) : Nb(0) {}
+};
+
+
+//------------------------------------------------------------------------------
+class CountFunc
+{
+public:
+	RThreadLocalStorage<Counter>* Storage;
+
+	CountFunc(RThreadLocalStorage<Counter>* storage) : Storage(storage) {}
+	void operator()(size_t,size_t worker) {Storage->Get(worker)->Nb++;}
+};
+
+
+//------------------------------------------------------------------------------
+// Compute a Fibonacci number by submitting two sub-tasks and waiting for them.
+class FibonacciTask : public RThreadPoolTask
+{
+public:
+	RThreadPool* Pool;
+	size_t N;
+	size_t Result;
+
+	FibonacciTask(RThreadPool* pool,size_t n) : Pool(pool), N(n), Result(0) {}
+	virtual void Run(size_t)
+	{
+		if(N<12)
+		{
+			size_t a(0),b(1);
+			for(size_t i=0;i<N;i++)
+			{
+				size_t Tmp(a+b);
+				a=b;
+				b=Tmp;
+			}
+			Result=a;
+			return;
+		}
+		FibonacciTask A(Pool,N-1),B(Pool,N-2);
+		Pool->Submit(&A);
+		Pool->Submit(&B);
+		Pool->Wait(&A);
+		Pool->Wait(&B);
+		Result=A.Result+B.Result;
+	}
+};
+
+
+//------------------------------------------------------------------------------
+// Run until it is cancelled or a maximum number of steps is reached.
+class LongTask : public RThreadPoolTask
+{
+public:
+	size_t Steps;
+
+	LongTask(size_t steps=0) : Steps(steps) {}
+	virtual void Run(size_t)
+	{
+		while((!IsCancelled())&&(Steps<cMaxSteps))
+		{
+			usleep(100);
+			Steps++;
+		}
+	}
+};
+
+
+//------------------------------------------------------------------------------
+void CheckPool(size_t nbworkers)
+{
+	RThreadPool Pool(nbworkers);
+
+	// Ranges of indexes, elements and numbers
+	double* Values(new double[cNbValues]);
+	SquareFunc Func1(Values);
+	Check(Pool.ParallelFor(0,cNbValues,Func1,100),"A range of indexes was not treated");
+	for(size_t i=0;i<cNbValues;i++)
+		if(Values[i]!=Square(i))
+		{
+			Check(false,"Wrong value computed for a range of indexes");
+			break;
+		}
+	delete[] Values;
+
+	RContainer<Element,true,false> Elements(cNbElements);
+	for(size_t i=0;i<cNbElements;i++)
+		Elements.InsertPtr(new Element(i));
+	ElementFunc Func2;
+	Check(Pool.ParallelFor(RCursor<Element>(Elements),Func2),"A cursor was not treated");
+	for(size_t i=0;i<cNbElements;i++)
+		if(Elements[i]->Value!=Square(i))
+		{
+			Check(false,"Wrong value computed for a cursor");
+			break;
+		}
+
+	RNumContainer<size_t,false> Numbers(cNbElements);
+	for(size_t i=0;i<cNbElements;i++)
+		Numbers.Insert(i);
+	NumberFunc Func3;
+	Check(Pool.ParallelFor(RNumCursor<size_t>(Numbers),Func3),"A cursor of numbers was not treated");
+	for(size_t i=0;i<cNbElements;i++)
+		if(Numbers[i]!=3*i)
+		{
+			Check(false,"Wrong value computed for a cursor of numbers");
+			break;
+		}
+
+	// An exception must be propagated
+	ThrowFunc Func4;
+	bool Thrown(false);
+	try
+	{
+		Pool.ParallelFor(0,10000,Func4);
+	}
+	catch(RException&)
+	{
+		Thrown=true;
+	}
+	Check(Thrown,"An exception of a task was not propagated");
+
+	// Each index is counted once by the thread local storages
+	RThreadLocalStorage<Counter> Storage;
+	Pool.Reserve(Storage);
+	CountFunc Func5(&Storage);
+	Pool.ParallelFor(0,cNbValues,Func5);
+	size_t Nb(0);
+	for(size_t i=0;i<Pool.GetNbWorkers();i++)
+		Nb+=Storage.Get(i)->Nb;
+	Check(Nb==cNbValues,"Wrong number of indexes counted by the workers");
+
+	// Nested tasks
+	FibonacciTask Fibonacci(&Pool,25);
+	Pool.Submit(&Fibonacci);
+	Pool.Wait(&Fibonacci);
+	Check(Fibonacci.Result==75025,"Wrong result of nested tasks");
+
+	// Cancelled tasks stop, and the pool still works after
+	LongTask Long1,Long2;
+	Pool.Submit(&Long1);
+	Pool.Submit(&Long2);
+	usleep(2000);
+	Pool.CancelAll();
+	Pool.Wait(&Long1);
+	Pool.Wait(&Long2);
+	Check((Long1.Steps<cMaxSteps)&&(Long2.Steps<cMaxSteps),"A task was not cancelled");
+	LongTask Long3(cMaxSteps-10);
+	Pool.Submit(&Long3);
+	Pool.Wait(&Long3);
+	Check(Long3.Steps==cMaxSteps,"A task submitted after a cancellation was not executed");
+
+	// Tasks deleted by the pool
+	for(size_t i=0;i<100;i++)
+		Pool.Submit(new LongTask(cMaxSteps),true);
+}
+
+
+
+//------------------------------------------------------------------------------
+int main(void)
+{
+	try
+	{
+		for(size_t Round=0;Round<cNbRounds;Round++)
+		{
+			CheckPool(1);
+			CheckPool(4);
+		}
+	}
+	catch(RException& e)
+	{
+		cerr<<e.GetMsg()<<endl;
+		NbErrors++;
+	}
+
+	if(NbErrors)
+		return(1);
+	cout<<"Results of the pool identical to the sequential ones"<<endl;
+	return(0);
+}